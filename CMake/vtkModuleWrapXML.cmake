@@ -27,6 +27,10 @@ Windows and `${CMAKE_INSTALL_LIBDIR}/xml<VERSION>/site-packages` otherwise.
 cmake_policy(PUSH)
 cmake_policy(SET CMP0053 NEW)
 
+# The directory with vtkWrapXMLReflection.h, for the reflection libraries.
+set(_vtk_module_wrap_xml_reflection_include_dir
+  "${CMAKE_CURRENT_LIST_DIR}/../Source")
+
 function (vtk_module_xml_default_destination var)
   cmake_parse_arguments(_vtk_module_xml "" "" var)
 
@@ -41,6 +45,42 @@ function (vtk_module_xml_default_destination var)
   set("${var}" "${destination}" PARENT_SCOPE)
 endfunction ()
 
+#[==[
+@ingroup module-impl
+@brief Create a snapshot of the cross-compilation macros
+
+The macros file from `VTKCompileTools` is converted once into a compact
+snapshot that `vtkWrapXML --macros` can map into memory, which is much
+cheaper than preprocessing it with `-imacros` for every header. The
+snapshot is built by the `vtkWrapXML-macros` target.
+
+~~~
+_vtk_module_wrap_xml_macros_snapshot(<var>)
+~~~
+#]==]
+function (_vtk_module_wrap_xml_macros_snapshot var)
+  set(_vtk_xml_macros_snapshot
+    "${CMAKE_BINARY_DIR}/CMakeFiles/vtkWrapXML-macros/macros.snapshot")
+
+  if (NOT TARGET vtkWrapXML-macros)
+    add_custom_command(
+      OUTPUT  "${_vtk_xml_macros_snapshot}"
+      COMMAND ${CMAKE_CROSSCOMPILING_EMULATOR}
+              "$<TARGET_FILE:VTKCompileTools::WrapXML>"
+              --write-macros "${_vtk_xml_macros_snapshot}"
+              "${_VTKCompileTools_macros_file}"
+      COMMENT "Generating macros snapshot for XML wrapping"
+      DEPENDS
+        "${_VTKCompileTools_macros_file}"
+        "$<TARGET_FILE:VTKCompileTools::WrapXML>"
+        VTKCompileTools_macros)
+    add_custom_target(vtkWrapXML-macros
+      DEPENDS "${_vtk_xml_macros_snapshot}")
+  endif ()
+
+  set("${var}" "${_vtk_xml_macros_snapshot}" PARENT_SCOPE)
+endfunction ()
+
 #[==[
 @ingroup module-impl
 @brief Generate XML for a module's classes
@@ -121,11 +161,55 @@ $<$<BOOL:${_vtk_xml_hierarchy_files}>:\n--types \'$<JOIN:${_vtk_xml_hierarchy_fi
 
   set(_vtk_xml_files)
 
+  # Compress the output as it is written.
+  set(_vtk_xml_suffix ".xml")
+  set(_vtk_xml_compress_args)
+  if (_vtk_xml_COMPRESS STREQUAL "gzip")
+    set(_vtk_xml_suffix ".xml.gz")
+  elseif (_vtk_xml_COMPRESS STREQUAL "zstd")
+    set(_vtk_xml_suffix ".xml.zst")
+  endif ()
+  if (_vtk_xml_COMPRESS AND NOT _vtk_xml_COMPRESS STREQUAL "none")
+    list(APPEND _vtk_xml_compress_args
+      --compress "${_vtk_xml_COMPRESS}")
+  endif ()
+
+  set(_vtk_xml_wrap_target "vtkWrapXML")
+  set(_vtk_xml_index_target "vtkWrapXMLIndex")
+  set(_vtk_xml_reflect_target "vtkWrapXMLReflect")
+  set(_vtk_xml_properties_target "vtkWrapXMLProperties")
+  set(_vtk_xml_macros_args)
+  if (TARGET VTKCompileTools::WrapXMLIndex)
+    set(_vtk_xml_index_target "VTKCompileTools::WrapXMLIndex")
+  endif ()
+  if (TARGET VTKCompileTools::WrapXMLProperties)
+    set(_vtk_xml_properties_target "VTKCompileTools::WrapXMLProperties")
+  endif ()
+  if (TARGET VTKCompileTools::WrapXMLReflect)
+    set(_vtk_xml_reflect_target "VTKCompileTools::WrapXMLReflect")
+  endif ()
+  if (TARGET VTKCompileTools::WrapXML)
+    set(_vtk_xml_wrap_target "VTKCompileTools::WrapXML")
+    if (TARGET VTKCompileTools_macros)
+      # Use a snapshot of the macros, rather than preprocessing the
+      # macros file with -imacros for every header.
+      _vtk_module_wrap_xml_macros_snapshot(_vtk_xml_macros_snapshot)
+      list(APPEND _vtk_xml_command_depends
+        "vtkWrapXML-macros")
+      list(APPEND _vtk_xml_macros_args
+        -undef
+        --macros "${_vtk_xml_macros_snapshot}")
+    endif ()
+  endif ()
+
   # Get the list of public headers from the module.
   _vtk_module_get_module_property("${module}"
     PROPERTY  "headers"
     VARIABLE  _vtk_xml_headers)
   set(_vtk_xml_classes)
+  set(_vtk_xml_manifests)
+  set(_vtk_xml_property_tables)
+  set(_vtk_xml_reflections)
   foreach (_vtk_xml_header IN LISTS _vtk_xml_headers)
     # Assume the class name matches the basename of the header. This is VTK
     # convention.
@@ -134,20 +218,66 @@ $<$<BOOL:${_vtk_xml_hierarchy_files}>:\n--types \'$<JOIN:${_vtk_xml_hierarchy_fi
       "${_vtk_xml_basename}")
 
     set(_vtk_xml_source_output
-      "${CMAKE_CURRENT_BINARY_DIR}/xml/${_vtk_xml_library_name}/${_vtk_xml_basename}.xml")
+      "${CMAKE_CURRENT_BINARY_DIR}/xml/${_vtk_xml_library_name}/${_vtk_xml_basename}${_vtk_xml_suffix}")
     list(APPEND _vtk_xml_files
       "${_vtk_xml_source_output}")
 
-    set(_vtk_xml_wrap_target "vtkWrapXML")
-    set(_vtk_xml_macros_args)
-    if (TARGET VTKCompileTools::WrapXML)
-      set(_vtk_xml_wrap_target "VTKCompileTools::WrapXML")
-      if (TARGET VTKCompileTools_macros)
-        list(APPEND _vtk_xml_command_depends
-          "VTKCompileTools_macros")
-        list(APPEND _vtk_xml_macros_args
-          -undef
-          -imacros "${_VTKCompileTools_macros_file}")
+    # Save the parse results, so that a change to the output options
+    # does not require the header to be parsed again.
+    set(_vtk_xml_cache_args)
+    set(_vtk_xml_cache_byproducts)
+    if (_vtk_xml_PARSE_CACHE)
+      set(_vtk_xml_cache_file
+        "${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/${_vtk_xml_library_name}XML/${_vtk_xml_basename}.cache")
+      set(_vtk_xml_cache_byproducts
+        "${_vtk_xml_cache_file}"
+        "${_vtk_xml_cache_file}.d")
+      list(APPEND _vtk_xml_cache_args
+        --parse-cache "${_vtk_xml_cache_file}"
+        -MF "${_vtk_xml_cache_file}.d")
+    endif ()
+
+    # List the classes in the header, with their location in the XML.
+    # The manifest is only rewritten if its contents change, so it is a
+    # byproduct rather than an output.
+    set(_vtk_xml_manifest_args)
+    set(_vtk_xml_manifest_output)
+    if (_vtk_xml_MANIFEST)
+      set(_vtk_xml_manifest_output
+        "${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/${_vtk_xml_library_name}XML/${_vtk_xml_basename}.manifest")
+      list(APPEND _vtk_xml_manifests
+        "${_vtk_xml_manifest_output}")
+      list(APPEND _vtk_xml_manifest_args
+        --manifest "${_vtk_xml_manifest_output}")
+    endif ()
+
+    # Write the properties of the classes in the header as a table. Like
+    # the manifest, the table is only rewritten if its contents change.
+    set(_vtk_xml_property_table_args)
+    set(_vtk_xml_property_table_output)
+    if (_vtk_xml_PROPERTY_TABLE)
+      set(_vtk_xml_property_table_output
+        "${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/${_vtk_xml_library_name}XML/${_vtk_xml_basename}.properties")
+      list(APPEND _vtk_xml_property_tables
+        "${_vtk_xml_property_table_output}")
+      list(APPEND _vtk_xml_property_table_args
+        --property-table "${_vtk_xml_property_table_output}")
+    endif ()
+
+    # Write the C++ reflection tables for the classes in the header. Like
+    # the manifest, the file is only rewritten if its contents change.
+    set(_vtk_xml_reflection_args)
+    set(_vtk_xml_reflection_output)
+    if (_vtk_xml_REFLECTION)
+      set(_vtk_xml_reflection_output
+        "${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/${_vtk_xml_library_name}XML/${_vtk_xml_basename}.reflect.h")
+      list(APPEND _vtk_xml_reflections
+        "${_vtk_xml_reflection_output}")
+      list(APPEND _vtk_xml_reflection_args
+        --reflection "${_vtk_xml_reflection_output}")
+      if (_vtk_xml_REFLECTION_THUNKS)
+        list(APPEND _vtk_xml_reflection_args
+          --thunks)
       endif ()
     endif ()
 
@@ -159,6 +289,16 @@ $<$<BOOL:${_vtk_xml_hierarchy_files}>:\n--types \'$<JOIN:${_vtk_xml_hierarchy_fi
               -o "${_vtk_xml_source_output}"
               "${_vtk_xml_header}"
               ${_vtk_xml_macros_args}
+              ${_vtk_xml_cache_args}
+              ${_vtk_xml_compress_args}
+              ${_vtk_xml_manifest_args}
+              ${_vtk_xml_property_table_args}
+              ${_vtk_xml_reflection_args}
+      BYPRODUCTS
+              ${_vtk_xml_cache_byproducts}
+              ${_vtk_xml_manifest_output}
+              ${_vtk_xml_property_table_output}
+              ${_vtk_xml_reflection_output}
       IMPLICIT_DEPENDS
               CXX "${_vtk_xml_header}"
       COMMENT "Generating wrapper xml file for ${_vtk_xml_basename}"
@@ -169,6 +309,106 @@ $<$<BOOL:${_vtk_xml_hierarchy_files}>:\n--types \'$<JOIN:${_vtk_xml_hierarchy_fi
         ${_vtk_xml_command_depends})
   endforeach ()
 
+  # Merge the manifests of the headers into a manifest for the module,
+  # where the file names are relative to the "xml" directory. The merge
+  # is incremental: only the manifests that have changed are read, and
+  # their classes are appended to the module manifest.
+  if (_vtk_xml_MANIFEST)
+    set(_vtk_xml_manifest_list
+      "${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/${_vtk_xml_library_name}XML/${_vtk_xml_library_name}-manifests.txt")
+    string(REPLACE ";" "\n" _vtk_xml_manifest_content "${_vtk_xml_manifests}")
+    file(GENERATE
+      OUTPUT  "${_vtk_xml_manifest_list}"
+      CONTENT "${_vtk_xml_manifest_content}\n")
+    set(_vtk_xml_module_manifest
+      "${CMAKE_CURRENT_BINARY_DIR}/xml/${_vtk_xml_library_name}.manifest")
+    set(_vtk_xml_module_stamp
+      "${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/${_vtk_xml_library_name}XML/${_vtk_xml_library_name}.manifest.stamp")
+    add_custom_command(
+      OUTPUT  "${_vtk_xml_module_stamp}"
+      BYPRODUCTS
+              "${_vtk_xml_module_manifest}"
+      COMMAND ${CMAKE_CROSSCOMPILING_EMULATOR}
+              "$<TARGET_FILE:${_vtk_xml_index_target}>"
+              --update
+              -o "${_vtk_xml_module_manifest}"
+              --module "${module}"
+              --prefix "${_vtk_xml_library_name}"
+              "@${_vtk_xml_manifest_list}"
+      COMMAND "${CMAKE_COMMAND}" -E touch "${_vtk_xml_module_stamp}"
+      COMMENT "Generating XML manifest for ${_vtk_xml_library_name}"
+      DEPENDS
+        ${_vtk_xml_manifests}
+        "${_vtk_xml_manifest_list}"
+        "$<TARGET_FILE:${_vtk_xml_index_target}>")
+    list(APPEND _vtk_xml_files
+      "${_vtk_xml_module_stamp}")
+  endif ()
+
+  # Merge the property tables of the headers into a table for the module.
+  if (_vtk_xml_PROPERTY_TABLE)
+    set(_vtk_xml_property_table_list
+      "${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/${_vtk_xml_library_name}XML/${_vtk_xml_library_name}-properties.txt")
+    string(REPLACE ";" "\n" _vtk_xml_property_table_content "${_vtk_xml_property_tables}")
+    file(GENERATE
+      OUTPUT  "${_vtk_xml_property_table_list}"
+      CONTENT "${_vtk_xml_property_table_content}\n")
+    set(_vtk_xml_module_property_table
+      "${CMAKE_CURRENT_BINARY_DIR}/xml/${_vtk_xml_library_name}.properties")
+    add_custom_command(
+      OUTPUT  "${_vtk_xml_module_property_table}"
+      COMMAND ${CMAKE_CROSSCOMPILING_EMULATOR}
+              "$<TARGET_FILE:${_vtk_xml_properties_target}>"
+              -o "${_vtk_xml_module_property_table}"
+              "@${_vtk_xml_property_table_list}"
+      COMMENT "Generating property table for ${_vtk_xml_library_name}"
+      DEPENDS
+        ${_vtk_xml_property_tables}
+        "${_vtk_xml_property_table_list}"
+        "$<TARGET_FILE:${_vtk_xml_properties_target}>")
+    list(APPEND _vtk_xml_files
+      "${_vtk_xml_module_property_table}")
+  endif ()
+
+  # Collect the reflection tables of the headers into a source file for
+  # the module, and compile it into a static library.
+  if (_vtk_xml_REFLECTION)
+    set(_vtk_xml_reflection_list
+      "${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/${_vtk_xml_library_name}XML/${_vtk_xml_library_name}-reflections.txt")
+    string(REPLACE ";" "\n" _vtk_xml_reflection_content "${_vtk_xml_reflections}")
+    file(GENERATE
+      OUTPUT  "${_vtk_xml_reflection_list}"
+      CONTENT "${_vtk_xml_reflection_content}\n")
+    set(_vtk_xml_reflection_source
+      "${CMAKE_CURRENT_BINARY_DIR}/reflection/${_vtk_xml_library_name}Reflection.cxx")
+    add_custom_command(
+      OUTPUT  "${_vtk_xml_reflection_source}"
+      COMMAND ${CMAKE_CROSSCOMPILING_EMULATOR}
+              "$<TARGET_FILE:${_vtk_xml_reflect_target}>"
+              -o "${_vtk_xml_reflection_source}"
+              --module "${module}"
+              "@${_vtk_xml_reflection_list}"
+      COMMENT "Generating reflection tables for ${_vtk_xml_library_name}"
+      DEPENDS
+        ${_vtk_xml_files}
+        "${_vtk_xml_reflection_list}"
+        "$<TARGET_FILE:${_vtk_xml_reflect_target}>")
+    add_library("${_vtk_xml_library_name}Reflection" STATIC
+      "${_vtk_xml_reflection_source}")
+    target_include_directories("${_vtk_xml_library_name}Reflection"
+      PUBLIC
+        "${_vtk_module_wrap_xml_reflection_include_dir}")
+    target_compile_features("${_vtk_xml_library_name}Reflection"
+      PUBLIC
+        cxx_std_11)
+    # The thunks call the methods of the classes in the module.
+    if (_vtk_xml_REFLECTION_THUNKS)
+      target_link_libraries("${_vtk_xml_library_name}Reflection"
+        PRIVATE
+          "${module}")
+    endif ()
+  endif ()
+
   set("${files}"
     "${_vtk_xml_files}"
     PARENT_SCOPE)
@@ -189,6 +429,12 @@ vtk_module_wrap_xml(
   [WRAPPED_MODULES <varname>]
 
   [INSTALL_HEADERS <ON|OFF>]
+  [PARSE_CACHE <ON|OFF>]
+  [COMPRESS <none|gzip|zstd>]
+  [MANIFEST <ON|OFF>]
+  [PROPERTY_TABLE <ON|OFF>]
+  [REFLECTION <ON|OFF>]
+  [REFLECTION_THUNKS <ON|OFF>]
 
   [DEPENDS <target>...]
 
@@ -211,6 +457,37 @@ vtk_module_wrap_xml(
     in XML code.
   * `INSTALL_HEADERS` (Defaults to `ON`): If unset, CMake properties will not
     be installed.
+  * `PARSE_CACHE` (Defaults to `OFF`): If set, the parse results for each
+    header are saved in a cache file, and are reused when the XML has to be
+    regenerated but the header and its includes have not changed.
+  * `COMPRESS` (Defaults to `none`): If set to `gzip` or `zstd`, the XML
+    files are compressed as they are written, and are given the suffix
+    `.xml.gz` or `.xml.zst`. The compression method must have been
+    available when vtkWrapXML was built.
+  * `MANIFEST` (Defaults to `ON`): If set, a manifest that lists the classes
+    in each module, with their base class, abstract flag, number of
+    properties, and the location of the class in the XML, is written to
+    `xml/<library>.manifest`. A manifest for all of the modules is written
+    to `xml/modules.manifest`.
+  * `PROPERTY_TABLE` (Defaults to `OFF`): If set, the properties of the
+    classes in each module are written as a binary table, with the type,
+    count, and the public, protected, and legacy methods of each, to
+    `xml/<library>.properties`.  A table for all of the modules is
+    written to `xml/modules.properties`.  The tables are queried with
+    `vtkWrapXMLProperties`.
+  * `REFLECTION` (Defaults to `OFF`): If set, the public properties and
+    methods of the classes in each module are written as constexpr C++
+    tables to `reflection/<library>Reflection.cxx`, which is compiled
+    into a static library named `<library>Reflection`. The tables are
+    declared in `vtkWrapXMLReflection.h`, and classes and properties can
+    be looked up by name through perfect hash tables. A registry with a
+    lookup table for the classes of all the modules is written to
+    `reflection/vtkWrapXMLRegistry.cxx` and compiled into a static library
+    named `vtkWrapXMLRegistry`, which links all the module libraries.
+  * `REFLECTION_THUNKS` (Defaults to `OFF`): If set along with `REFLECTION`,
+    each property in the tables also has a getter and a setter function
+    that call its methods on a `vtkObjectBase*`, and each reflection
+    library is linked to its module.
   * `TARGET_SPECIFIC_COMPONENTS` (Defaults to `OFF`): If set, prepend the
     output target name to the install component (`<TARGET>-<COMPONENT>`).
   * `DEPENDS`: This is list of other XML modules targets i.e. targets
@@ -231,7 +508,7 @@ vtk_module_wrap_xml(
 function (vtk_module_wrap_xml)
   cmake_parse_arguments(PARSE_ARGV 0 _vtk_xml
     ""
-    "MODULE_DESTINATION;INSTALL_HEADERS;INSTALL_EXPORT;TARGET_SPECIFIC_COMPONENTS;TARGET;COMPONENT;WRAPPED_MODULES;CMAKE_DESTINATION;DEPENDS"
+    "MODULE_DESTINATION;INSTALL_HEADERS;INSTALL_EXPORT;PARSE_CACHE;COMPRESS;MANIFEST;PROPERTY_TABLE;REFLECTION;REFLECTION_THUNKS;TARGET_SPECIFIC_COMPONENTS;TARGET;COMPONENT;WRAPPED_MODULES;CMAKE_DESTINATION;DEPENDS"
     "MODULES")
 
   if (_vtk_xml_UNPARSED_ARGUMENTS)
@@ -263,6 +540,35 @@ function (vtk_module_wrap_xml)
     set(_vtk_xml_INSTALL_HEADERS ON)
   endif ()
 
+  if (NOT DEFINED _vtk_xml_PARSE_CACHE)
+    set(_vtk_xml_PARSE_CACHE OFF)
+  endif ()
+
+  if (NOT DEFINED _vtk_xml_MANIFEST)
+    set(_vtk_xml_MANIFEST ON)
+  endif ()
+
+  if (NOT DEFINED _vtk_xml_PROPERTY_TABLE)
+    set(_vtk_xml_PROPERTY_TABLE OFF)
+  endif ()
+
+  if (NOT DEFINED _vtk_xml_REFLECTION)
+    set(_vtk_xml_REFLECTION OFF)
+  endif ()
+
+  if (NOT DEFINED _vtk_xml_REFLECTION_THUNKS)
+    set(_vtk_xml_REFLECTION_THUNKS OFF)
+  endif ()
+
+  if (NOT DEFINED _vtk_xml_COMPRESS)
+    set(_vtk_xml_COMPRESS "none")
+  endif ()
+
+  if (NOT _vtk_xml_COMPRESS MATCHES "^(none|gzip|zstd)$")
+    message(FATAL_ERROR
+      "Unknown COMPRESS method for vtk_module_wrap_xml: ${_vtk_xml_COMPRESS}")
+  endif ()
+
   if (NOT DEFINED _vtk_xml_TARGET_SPECIFIC_COMPONENTS)
     set(_vtk_xml_TARGET_SPECIFIC_COMPONENTS OFF)
   endif ()
@@ -298,6 +604,15 @@ function (vtk_module_wrap_xml)
     file(WRITE "${_vtk_xml_properties_install_file}")
   endif ()
 
+  set(_vtk_xml_module_manifests)
+  set(_vtk_xml_module_stamps)
+  set(_vtk_xml_module_property_tables)
+  set(_vtk_xml_property_table_targets)
+  set(_vtk_xml_module_targets)
+  set(_vtk_xml_registry_args)
+  set(_vtk_xml_registry_depends)
+  set(_vtk_xml_registry_libraries)
+
   set(_vtk_xml_sorted_modules ${_vtk_xml_MODULES})
   foreach (_vtk_xml_module IN LISTS _vtk_xml_MODULES)
     _vtk_module_get_module_property("${_vtk_xml_module}"
@@ -342,6 +657,29 @@ function (vtk_module_wrap_xml)
     _vtk_module_write_wrap_xml("${_vtk_xml_module}" _vtk_xml_files _vtk_xml_classes)
     add_custom_target("${_vtk_xml_TARGET_NAME}" ALL
       DEPENDS ${_vtk_xml_files})
+    if (_vtk_xml_MANIFEST AND _vtk_xml_files)
+      list(APPEND _vtk_xml_module_manifests
+        "${CMAKE_CURRENT_BINARY_DIR}/xml/${_vtk_xml_library_name}.manifest")
+      list(APPEND _vtk_xml_module_stamps
+        "${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/${_vtk_xml_library_name}XML/${_vtk_xml_library_name}.manifest.stamp")
+      list(APPEND _vtk_xml_module_targets
+        "${_vtk_xml_TARGET_NAME}")
+    endif ()
+    if (_vtk_xml_PROPERTY_TABLE AND _vtk_xml_files)
+      list(APPEND _vtk_xml_module_property_tables
+        "${CMAKE_CURRENT_BINARY_DIR}/xml/${_vtk_xml_library_name}.properties")
+      list(APPEND _vtk_xml_property_table_targets
+        "${_vtk_xml_TARGET_NAME}")
+    endif ()
+    if (_vtk_xml_REFLECTION AND TARGET "${_vtk_xml_library_name}Reflection")
+      list(APPEND _vtk_xml_registry_args
+        --module "${_vtk_xml_module}"
+        "@${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/${_vtk_xml_library_name}XML/${_vtk_xml_library_name}-reflections.txt")
+      list(APPEND _vtk_xml_registry_depends
+        "${CMAKE_CURRENT_BINARY_DIR}/reflection/${_vtk_xml_library_name}Reflection.cxx")
+      list(APPEND _vtk_xml_registry_libraries
+        "${_vtk_xml_library_name}Reflection")
+    endif ()
 
     # Make sure the module doesn't already have an associated XML package.
     vtk_module_get_property("${_vtk_xml_module}"
@@ -368,6 +706,87 @@ function (vtk_module_wrap_xml)
     endif ()
   endforeach ()
 
+  # Merge the module manifests into a manifest for all the modules.
+  if (_vtk_xml_module_manifests)
+    set(_vtk_xml_all_manifest
+      "${CMAKE_CURRENT_BINARY_DIR}/xml/modules.manifest")
+    set(_vtk_xml_all_stamp
+      "${CMAKE_CURRENT_BINARY_DIR}/CMakeFiles/modules.manifest.stamp")
+    set(_vtk_xml_index_target "vtkWrapXMLIndex")
+    if (TARGET VTKCompileTools::WrapXMLIndex)
+      set(_vtk_xml_index_target "VTKCompileTools::WrapXMLIndex")
+    endif ()
+    add_custom_command(
+      OUTPUT  "${_vtk_xml_all_stamp}"
+      BYPRODUCTS
+              "${_vtk_xml_all_manifest}"
+      COMMAND ${CMAKE_CROSSCOMPILING_EMULATOR}
+              "$<TARGET_FILE:${_vtk_xml_index_target}>"
+              --update
+              -o "${_vtk_xml_all_manifest}"
+              ${_vtk_xml_module_manifests}
+      COMMAND "${CMAKE_COMMAND}" -E touch "${_vtk_xml_all_stamp}"
+      COMMENT "Generating XML manifest for all modules"
+      DEPENDS
+        ${_vtk_xml_module_stamps}
+        "$<TARGET_FILE:${_vtk_xml_index_target}>")
+    add_custom_target(vtkWrapXML-manifest ALL
+      DEPENDS "${_vtk_xml_all_stamp}")
+    add_dependencies(vtkWrapXML-manifest
+      ${_vtk_xml_module_targets})
+  endif ()
+
+  # Merge the module property tables into a table for all the modules.
+  if (_vtk_xml_module_property_tables)
+    set(_vtk_xml_all_property_table
+      "${CMAKE_CURRENT_BINARY_DIR}/xml/modules.properties")
+    set(_vtk_xml_properties_target "vtkWrapXMLProperties")
+    if (TARGET VTKCompileTools::WrapXMLProperties)
+      set(_vtk_xml_properties_target "VTKCompileTools::WrapXMLProperties")
+    endif ()
+    add_custom_command(
+      OUTPUT  "${_vtk_xml_all_property_table}"
+      COMMAND ${CMAKE_CROSSCOMPILING_EMULATOR}
+              "$<TARGET_FILE:${_vtk_xml_properties_target}>"
+              -o "${_vtk_xml_all_property_table}"
+              ${_vtk_xml_module_property_tables}
+      COMMENT "Generating property table for all modules"
+      DEPENDS
+        ${_vtk_xml_module_property_tables}
+        "$<TARGET_FILE:${_vtk_xml_properties_target}>")
+    add_custom_target(vtkWrapXML-properties ALL
+      DEPENDS "${_vtk_xml_all_property_table}")
+    add_dependencies(vtkWrapXML-properties
+      ${_vtk_xml_property_table_targets})
+  endif ()
+
+  # Write a registry with a lookup table for the classes of all the
+  # modules, and compile it into a static library with the module tables.
+  if (_vtk_xml_registry_args)
+    set(_vtk_xml_registry_source
+      "${CMAKE_CURRENT_BINARY_DIR}/reflection/vtkWrapXMLRegistry.cxx")
+    set(_vtk_xml_reflect_target "vtkWrapXMLReflect")
+    if (TARGET VTKCompileTools::WrapXMLReflect)
+      set(_vtk_xml_reflect_target "VTKCompileTools::WrapXMLReflect")
+    endif ()
+    add_custom_command(
+      OUTPUT  "${_vtk_xml_registry_source}"
+      COMMAND ${CMAKE_CROSSCOMPILING_EMULATOR}
+              "$<TARGET_FILE:${_vtk_xml_reflect_target}>"
+              -o "${_vtk_xml_registry_source}"
+              --registry vtkWrapXML
+              ${_vtk_xml_registry_args}
+      COMMENT "Generating reflection registry for all modules"
+      DEPENDS
+        ${_vtk_xml_registry_depends}
+        "$<TARGET_FILE:${_vtk_xml_reflect_target}>")
+    add_library(vtkWrapXMLRegistry STATIC
+      "${_vtk_xml_registry_source}")
+    target_link_libraries(vtkWrapXMLRegistry
+      PUBLIC
+        ${_vtk_xml_registry_libraries})
+  endif ()
+
   if (_vtk_xml_INSTALL_HEADERS)
     install(
       FILES       "${_vtk_xml_properties_install_file}"
@@ -14,11 +14,14 @@
 
 #include "vtkParseData.h"
 #include "vtkParseProperties.h"
+#include "vtkWrapXMLArena.h"
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <ctype.h>
 
+#include "vtkWrapXMLAlloc.h"
+
 /*-------------------------------------------------------------------
  * A struct that lays out the function information in a way
  * that makes it easy to find methods that act on the same ivars.
@@ -48,8 +51,29 @@ typedef struct _ClassPropertyMethods
 {
   int NumberOfMethods;
   MethodAttributes **Methods;
+  WrapXMLArena *Arena;    /* arena for all allocations, or NULL */
 } ClassPropertyMethods;
 
+/*-------------------------------------------------------------------
+ * Allocate memory from the arena if there is one, else use malloc */
+
+static void *allocateMemory(ClassPropertyMethods *methods, size_t n)
+{
+  if (methods->Arena)
+  {
+    return vtkWrapXMLArena_Alloc(methods->Arena, n);
+  }
+  return malloc(n);
+}
+
+static void freeMemory(ClassPropertyMethods *methods, void *ptr)
+{
+  if (methods->Arena == NULL)
+  {
+    free(ptr);
+  }
+}
+
 /*-------------------------------------------------------------------
  * Checks for various common method names for property access */
 
@@ -1054,7 +1078,7 @@ static void findAllMatches(
             if (property->EnumConstantNames == 0)
             {
               property->EnumConstantNames =
-                (const char **)malloc(sizeof(char *)*8);
+                (const char **)allocateMemory(methods, sizeof(char *)*8);
               property->EnumConstantNames[0] = 0;
             }
 
@@ -1065,12 +1089,12 @@ static void findAllMatches(
             {
               const char **savenames = property->EnumConstantNames;
               property->EnumConstantNames =
-                (const char **)malloc(sizeof(char *)*(j+8));
+                (const char **)allocateMemory(methods, sizeof(char *)*(j+8));
               for (k = 0; k < j; k++)
               {
                 property->EnumConstantNames[k] = savenames[k];
               }
-              free((void *)savenames);
+              freeMemory(methods, (void *)savenames);
             }
             property->EnumConstantNames[j] = 0;
           }
@@ -1080,12 +1104,41 @@ static void findAllMatches(
   }
 }
 
+/*-------------------------------------------------------------------
+ * compare two variants of a method:
+ * prefer "double" over "float",
+ * prefer higher-counted arrays,
+ * prefer non-legacy methods */
+int vtkParseProperties_ComparePreference(
+  unsigned int type1, int count1, int isLegacy1,
+  unsigned int type2, int count2, int isLegacy2)
+{
+  unsigned int baseType1 = (type1 & VTK_PARSE_BASE_TYPE);
+  unsigned int baseType2 = (type2 & VTK_PARSE_BASE_TYPE);
+
+  if ((baseType1 == VTK_PARSE_FLOAT && baseType2 == VTK_PARSE_DOUBLE) ||
+      (baseType1 == baseType2 && count1 < count2) ||
+      (isLegacy1 && !isLegacy2))
+  {
+    return 1;
+  }
+
+  if ((baseType1 == VTK_PARSE_DOUBLE && baseType2 == VTK_PARSE_FLOAT) ||
+      (baseType1 == baseType2 && count1 > count2) ||
+      (!isLegacy1 && isLegacy2))
+  {
+    return -1;
+  }
+
+  return 0;
+}
+
 /*-------------------------------------------------------------------
  * search for methods that are repeated with minor variations */
 static int searchForRepeatedMethods(
   ClassProperties *properties, ClassPropertyMethods *methods, int j)
 {
-  int i, n;
+  int i, n, preference;
   MethodAttributes *attrs;
   MethodAttributes *meth;
   n = methods->NumberOfMethods;
@@ -1107,17 +1160,12 @@ static int searchForRepeatedMethods(
         attrs->IsEnumerated == meth->IsEnumerated &&
         attrs->IsBoolean == meth->IsBoolean)
     {
-      /* check to see if the types are compatible:
-       * prefer "double" over "float",
-       * prefer higher-counted arrays,
-       * prefer non-legacy methods */
-
-      if (((attrs->Type & VTK_PARSE_BASE_TYPE) == VTK_PARSE_FLOAT &&
-           (meth->Type & VTK_PARSE_BASE_TYPE) == VTK_PARSE_DOUBLE) ||
-          ((attrs->Type & VTK_PARSE_BASE_TYPE) ==
-             (meth->Type & VTK_PARSE_BASE_TYPE) &&
-           attrs->Count < meth->Count) ||
-          (attrs->IsLegacy && !meth->IsLegacy))
+      /* check to see if the types are compatible */
+      preference = vtkParseProperties_ComparePreference(
+        attrs->Type, attrs->Count, attrs->IsLegacy,
+        meth->Type, meth->Count, meth->IsLegacy);
+
+      if (preference > 0)
       {
         /* keep existing method */
         attrs->IsRepeat = 1;
@@ -1130,12 +1178,7 @@ static int searchForRepeatedMethods(
         return 0;
       }
 
-      if (((attrs->Type & VTK_PARSE_BASE_TYPE) == VTK_PARSE_DOUBLE &&
-           (meth->Type & VTK_PARSE_BASE_TYPE) == VTK_PARSE_FLOAT) ||
-          ((attrs->Type & VTK_PARSE_BASE_TYPE) ==
-             (meth->Type & VTK_PARSE_BASE_TYPE) &&
-           attrs->Count > meth->Count) ||
-          (!attrs->IsLegacy && meth->IsLegacy))
+      if (preference < 0)
       {
         /* keep this method */
         meth->IsRepeat = 1;
@@ -1175,7 +1218,7 @@ static void addProperty(
   searchForRepeatedMethods(properties, methods, i);
 
   /* create the property */
-  property = (PropertyInfo *)malloc(sizeof(PropertyInfo));
+  property = (PropertyInfo *)allocateMemory(methods, sizeof(PropertyInfo));
   initializePropertyInfo(property, meth, category);
   findAllMatches(property, properties->NumberOfProperties, methods,
                  matchedMethods, properties->MethodTypes,
@@ -1198,7 +1241,7 @@ static void categorizeProperties(
   properties->NumberOfProperties = 0;
 
   n = methods->NumberOfMethods;
-  matchedMethods = (int *)malloc(sizeof(int)*n);
+  matchedMethods = (int *)allocateMemory(methods, sizeof(int)*n);
   for (i = 0; i < n; i++)
   {
     /* "matchedMethods" are methods removed from consideration */
@@ -1265,7 +1308,7 @@ static void categorizeProperties(
     }
   }
 
-  free(matchedMethods);
+  freeMemory(methods, matchedMethods);
 }
 
 /*-------------------------------------------------------------------
@@ -1285,7 +1328,8 @@ static void categorizePropertyMethods(
   for (i = 0; i < n; i++)
   {
     func = data->Functions[i];
-    attrs = (MethodAttributes *)malloc(sizeof(MethodAttributes));
+    attrs = (MethodAttributes *)allocateMemory(
+      methods, sizeof(MethodAttributes));
     methods->Methods[methods->NumberOfMethods++] = attrs;
 
     /* copy the func into a MethodAttributes struct if possible */
@@ -1301,32 +1345,42 @@ static void categorizePropertyMethods(
  * build a ClassProperties struct from the info in a FileInfo struct */
 
 ClassProperties *vtkParseProperties_Create(ClassInfo *data)
+{
+  return vtkParseProperties_CreateInArena(data, NULL);
+}
+
+/*-------------------------------------------------------------------
+ * build a ClassProperties struct, with all memory from an arena */
+
+ClassProperties *vtkParseProperties_CreateInArena(
+  ClassInfo *data, WrapXMLArena *arena)
 {
   int i;
   ClassProperties *properties;
-  ClassPropertyMethods *methods;
+  ClassPropertyMethods methods;
 
-  methods = (ClassPropertyMethods *)malloc(sizeof(ClassPropertyMethods));
-  methods->Methods = (MethodAttributes **)malloc(sizeof(MethodAttributes *)*
-                                                 data->NumberOfFunctions);
+  methods.Arena = arena;
+  methods.Methods = (MethodAttributes **)allocateMemory(
+    &methods, sizeof(MethodAttributes *)*data->NumberOfFunctions);
 
   /* categorize the methods according to what properties they reference
    * and what they do to that property */
-  categorizePropertyMethods(data, methods);
+  categorizePropertyMethods(data, &methods);
 
-  properties = (ClassProperties *)malloc(sizeof(ClassProperties));
+  properties = (ClassProperties *)allocateMemory(
+    &methods, sizeof(ClassProperties));
   properties->NumberOfProperties = 0;
-  properties->NumberOfMethods = methods->NumberOfMethods;
-  properties->Properties =
-    (PropertyInfo **)malloc(sizeof(PropertyInfo *)*methods->NumberOfMethods);
-  properties->MethodTypes =
-    (unsigned int *)malloc(sizeof(unsigned int)*methods->NumberOfMethods);
-  properties->MethodHasProperty =
-    (int *)malloc(sizeof(int)*methods->NumberOfMethods);
-  properties->MethodProperties =
-    (int *)malloc(sizeof(int)*methods->NumberOfMethods);
-
-  for (i = 0; i < methods->NumberOfMethods; i++)
+  properties->NumberOfMethods = methods.NumberOfMethods;
+  properties->Properties = (PropertyInfo **)allocateMemory(
+    &methods, sizeof(PropertyInfo *)*methods.NumberOfMethods);
+  properties->MethodTypes = (unsigned int *)allocateMemory(
+    &methods, sizeof(unsigned int)*methods.NumberOfMethods);
+  properties->MethodHasProperty = (int *)allocateMemory(
+    &methods, sizeof(int)*methods.NumberOfMethods);
+  properties->MethodProperties = (int *)allocateMemory(
+    &methods, sizeof(int)*methods.NumberOfMethods);
+
+  for (i = 0; i < methods.NumberOfMethods; i++)
   {
     properties->MethodTypes[i] = 0;
     properties->MethodHasProperty[i] = 0;
@@ -1334,15 +1388,14 @@ ClassProperties *vtkParseProperties_Create(ClassInfo *data)
   }
 
   /* synthesize a list of properties from the list of methods */
-  categorizeProperties(methods, properties);
+  categorizeProperties(&methods, properties);
 
-  for (i = 0; i < methods->NumberOfMethods; i++)
+  for (i = 0; i < methods.NumberOfMethods; i++)
   {
-    free(methods->Methods[i]);
+    freeMemory(&methods, methods.Methods[i]);
   }
 
-  free(methods->Methods);
-  free(methods);
+  freeMemory(&methods, methods.Methods);
 
   return properties;
 }
@@ -23,6 +23,7 @@
 
 #include "vtkParseData.h"
 #include "vtkParseType.h"
+#include "vtkWrapXMLArena.h"
 
 /**
  * bitfield values to say what methods are available for a property
@@ -132,11 +133,30 @@ extern "C" {
  */
 ClassProperties *vtkParseProperties_Create(ClassInfo *data);
 
+/**
+ * Build the ClassProperties struct, allocating all of its memory from
+ * the arena.  The result must not be freed with vtkParseProperties_Free,
+ * since it is released when the arena is reset.
+ */
+ClassProperties *vtkParseProperties_CreateInArena(
+  ClassInfo *data, WrapXMLArena *arena);
+
 /**
  * Free a ClassProperties struct
  */
 void vtkParseProperties_Free(ClassProperties *properties);
 
+/**
+ * Compare two variants of a method by the rules that are used to pick
+ * one of a set of repeated methods: prefer "double" over "float",
+ * prefer higher-counted arrays, and prefer non-legacy methods.  The
+ * types are VTK_PARSE constants.  Returns -1 if the first is preferred,
+ * 1 if the second is preferred, or 0 if neither is.
+ */
+int vtkParseProperties_ComparePreference(
+  unsigned int type1, int count1, int isLegacy1,
+  unsigned int type2, int count2, int isLegacy2);
+
 /**
  * Convert a method bitfield to a string,
  * e.g. VTK_METHOD_GET -> "METHOD_GET"
@@ -33,15 +33,105 @@
 #include "vtkParseHierarchy.h"
 #include "vtkParseMerge.h"
 #include "vtkParseMain.h"
+#include "vtkWrapXMLAlloc.h"
+#include "vtkWrapXMLArena.h"
+#include "vtkWrapXMLCache.h"
+#include "vtkWrapXMLCxx.h"
+#include "vtkWrapXMLDoc.h"
+#include "vtkWrapXMLFingerprints.h"
+#include "vtkWrapXMLHierarchy.h"
+#include "vtkWrapXMLHash.h"
+#include "vtkWrapXMLJSON.h"
+#include "vtkWrapXMLMacros.h"
+#include "vtkWrapXMLManifest.h"
+#include "vtkWrapXMLOutput.h"
+#include "vtkWrapXMLOverloads.h"
+#include "vtkWrapXMLPerfectHash.h"
+#include "vtkWrapXMLPropertyTable.h"
+#include "vtkWrapXMLSignatures.h"
+#include "vtkWrapXMLSystem.h"
+#include "vtkWrapXMLThreads.h"
+#include "vtkWrapXMLTrace.h"
+
+/* ----- Options that are handled by vtkWrapXML itself ----- */
+
+typedef struct _wrapxml_options
+{
+  const char *MacrosFile; /* snapshot to load instead of -imacros */
+  const char *WriteMacrosFile; /* snapshot to create from a macros file */
+  const char *ParseCacheFile; /* saved parse results */
+  const char *OutputFileName; /* the "-o" option, for use with a cache */
+  int Batch; /* wrap many headers, "-o" gives the output directory */
+  int Stats; /* print the memory use */
+  int CommentTable; /* write each distinct comment once, in a table */
+  int CommentWidth; /* wrap comment lines at this width, or zero */
+  int SplitComments; /* write the parts of each comment as elements */
+  int NoRawComments; /* with SplitComments, omit the comment text */
+  int TypeCodes; /* write the numeric type along with the type string */
+  int Overloads; /* write the dispatch order of overloaded methods */
+  int Inheritance; /* write the base classes from the hierarchy files */
+  int JSONLines; /* write JSON Lines instead of XML */
+  int Compression; /* compress the output as it is written */
+  const char *ManifestFile; /* list the classes that were written */
+  const char *ReflectionFile; /* write C++ reflection tables */
+  const char *PropertyTableFile; /* write the properties as a table */
+  WrapXMLPropertyTable *PropertyTable; /* the table, or NULL if not used */
+  int Thunks; /* add property accessor thunks to the reflection tables */
+  int ClassThreads; /* threads for the top-level classes of a header */
+  WrapXMLHierarchy *Hierarchy; /* the "--types" files, or NULL if unused */
+  const char *TraceFile; /* write a timeline of the run */
+  WrapXMLTrace *Trace; /* the timeline, or NULL if not used */
+} wrapxml_options_t;
+
+/* the threads in the timeline, the class workers are numbered from 10 */
+#define WRAPXML_TRACE_PARSER 1
+#define WRAPXML_TRACE_EMITTER 2
+#define WRAPXML_TRACE_WRITER 3
+#define WRAPXML_TRACE_CLASSES 10
+
+/* vtkParse_Main() does not allow "-o -", so this is given instead */
+#ifdef _WIN32
+#define WRAPXML_NULL_DEVICE "NUL"
+#else
+#define WRAPXML_NULL_DEVICE "/dev/null"
+#endif
+
+/* ----- Table of the distinct comments in a file ----- */
+
+typedef struct _wrapxml_comments
+{
+  unsigned int size; /* number of hash table slots, a power of two */
+  int *slots; /* one plus the comment id for each slot, or zero */
+  int count; /* the number of distinct comments */
+  const char **text; /* the comments, in order of id */
+} wrapxml_comments_t;
 
 /* ----- XML state information ----- */
 
 typedef struct _wrapxml_state
 {
   FileInfo *data; /* the data that was parsed */
-  FILE *file; /* the file being written to */
+  WrapXMLOutput *file; /* the file being written to */
   int indentation; /* current indentation level */
   int unclosed; /* true if current tag is not closed */
+  int commentWidth; /* wrap comment lines at this width, or zero */
+  int splitComments; /* write the parts of each comment as elements */
+  int rawComments; /* write the text of each comment */
+  int typeCodes; /* write the numeric type along with the type string */
+  int overloads; /* write the dispatch order of overloaded methods */
+  int inheritance; /* write the base classes from the hierarchy files */
+  WrapXMLCache *cache; /* the parse results, or NULL if not cached */
+  WrapXMLArena *arena; /* memory that is released after each file */
+  wrapxml_comments_t *comments; /* comment table, or NULL if not used */
+  WrapXMLSignatures *signatures; /* signatures that have been rendered */
+  WrapXMLFingerprints *fingerprints; /* the API of each class */
+  WrapXMLManifest *manifest; /* list of classes, or NULL if not used */
+  const char *fileName; /* the output file, as given in the manifest */
+  NamespaceInfo *classScope; /* the namespace of the classes below */
+  WrapXMLOutput **classOutputs; /* classes that were already written */
+  WrapXMLHierarchy *hierarchy; /* for base classes in other headers */
+  WrapXMLTrace *trace; /* the timeline, or NULL if not used */
+  int traceThread; /* the thread in the timeline */
 } wrapxml_state_t;
 
 /* ----- XML utility functions ----- */
@@ -82,125 +172,170 @@ static int vtkWrapXML_IsPrint(int c)
 }
 
 /**
- * Convert special characters in a string into their escape codes,
- * so that the string can be quoted in an xml file (the specified
- * maxlen must be at least 32 chars)
+ * Write text to the file, with special characters converted into
+ * their escape codes so that the text can be quoted in an xml file.
+ * Non-printing characters, other than whitespace, are removed.
  */
-static const char *vtkWrapXML_Quote(const char *comment, size_t maxlen)
+static void vtkWrapXML_WriteQuoted(
+  wrapxml_state_t *w, const char *text, size_t n)
 {
-  static char *result = 0;
-  static size_t oldmaxlen = 0;
-  size_t i, j, n;
+  const char *entity;
+  size_t i, j;
+
+  if (text == NULL)
+  {
+    return;
+  }
 
-  if (maxlen > oldmaxlen)
+  /* write unchanged characters in runs, between the escapes */
+  j = 0;
+  for (i = 0; i < n; i++)
   {
-    if (result)
+    switch (text[i])
     {
-      free(result);
+      case '<':
+        entity = "&lt;";
+        break;
+      case '>':
+        entity = "&gt;";
+        break;
+      case '&':
+        entity = "&amp;";
+        break;
+      case '\"':
+        entity = "&quot;";
+        break;
+      case '\'':
+        entity = "&apos;";
+        break;
+      default:
+        if (vtkWrapXML_IsPrint(text[i]) || vtkWrapXML_IsSpace(text[i]))
+        {
+          continue;
+        }
+        /* remove non-printing characters */
+        entity = "";
+        break;
     }
-    result = (char *)malloc((size_t)(maxlen+1));
-    oldmaxlen = maxlen;
+
+    vtkWrapXMLOutput_Write(w->file, &text[j], i - j);
+    vtkWrapXMLOutput_Puts(w->file, entity);
+    j = i + 1;
   }
 
-  if (comment == NULL)
+  vtkWrapXMLOutput_Write(w->file, &text[j], n - j);
+}
+
+/**
+ * Print one line of text at the current indentation level.  If a
+ * comment width was set, then long lines are wrapped at a space.
+ */
+static void vtkWrapXML_TextLine(
+  wrapxml_state_t *w, const char *prefix, const char *text, size_t n)
+{
+  size_t width = (size_t)w->commentWidth;
+  size_t m;
+
+  if (n == 0 && prefix == NULL)
   {
-    return "";
+    vtkWrapXMLOutput_Putc(w->file, '\n');
+    return;
   }
 
-  j = 0;
-
-  n = (int)strlen(comment);
-  for (i = 0; i < n; i++)
+  if (n == 0)
   {
-    if (comment[i] == '<')
-    {
-      strcpy(&result[j],"&lt;");
-      j += 4;
-    }
-    else if (comment[i] == '>')
-    {
-      strcpy(&result[j],"&gt;");
-      j += 4;
-    }
-    else if (comment[i] == '&')
+    /* print the prefix without trailing whitespace */
+    m = strlen(prefix);
+    while (m > 0 && vtkWrapXML_IsSpace(prefix[m-1]))
     {
-      strcpy(&result[j],"&amp;");
-      j += 5;
+      m--;
     }
-    else if (comment[i] == '\"')
-    {
-      strcpy(&result[j],"&quot;");
-      j += 6;
-    }
-    else if (comment[i] == '\'')
-    {
-      strcpy(&result[j],"&apos;");
-      j += 6;
-    }
-    else if (vtkWrapXML_IsPrint(comment[i]))
+    vtkWrapXMLOutput_Printf(w->file, "%s", indent(w->indentation));
+    vtkWrapXMLOutput_Write(w->file, prefix, m);
+    vtkWrapXMLOutput_Putc(w->file, '\n');
+    return;
+  }
+
+  while (n > 0)
+  {
+    m = n;
+    if (width > 0 && n > width)
     {
-      result[j] = comment[i];
-      j++;
-    }
-    else if (vtkWrapXML_IsSpace(comment[i]))
-    { /* also copy non-printing characters */
-      result[j] = comment[i];
-      j++;
+      /* break at the last space that fits, else break the word */
+      m = width;
+      while (m > 0 && text[m] != ' ')
+      {
+        m--;
+      }
+      if (m == 0)
+      {
+        m = width;
+      }
     }
 
-    /* add trailing ellipsis if too long */
-    if (j >= maxlen - 5)
+    vtkWrapXMLOutput_Printf(w->file, "%s%s", indent(w->indentation),
+                            (prefix ? prefix : ""));
+    vtkWrapXML_WriteQuoted(w, text, m);
+    vtkWrapXMLOutput_Putc(w->file, '\n');
+    prefix = NULL;
+
+    text += m;
+    n -= m;
+    while (n > 0 && *text == ' ')
     {
-      sprintf(&result[j]," ...");
-      j += (int)strlen(" ...");
-      break;
+      text++;
+      n--;
     }
   }
-  result[j] = '\0';
-
-  return result;
 }
 
 /**
- * Print multi-line text at the specified indentation level.
+ * Print multi-line text at the specified indentation level, with an
+ * optional prefix for the first line.  The text is written directly
+ * from the string, without any length limits.
  */
-static void vtkWrapXML_MultiLineText(wrapxml_state_t *w, const char *cp)
+static void vtkWrapXML_PrefixedText(
+  wrapxml_state_t *w, const char *prefix, const char *cp)
 {
   size_t i = 0;
-  size_t j;
-  char temp[512];
+  size_t j, k;
 
   while (cp && cp[i] != '\0')
   {
-    for (j = 0; j < 200 && cp[i] != '\0' && cp[i] != '\n'; j++)
+    /* find the end of the line */
+    j = i;
+    while (cp[j] != '\0' && cp[j] != '\n')
     {
-      temp[j] = cp[i++];
+      j++;
     }
+    k = (cp[j] == '\n' ? j + 1 : j);
 
-    while (j > 0 &&
-           (temp[j-1] == ' ' || temp[j-1] == '\t' || temp[j-1] == '\r'))
+    /* remove trailing whitespace */
+    while (j > i && (cp[j-1] == ' ' || cp[j-1] == '\t' || cp[j-1] == '\r'))
     {
       j--;
     }
 
-    temp[j] = '\0';
+    vtkWrapXML_TextLine(w, prefix, &cp[i], j - i);
+    prefix = NULL;
+    i = k;
+  }
 
-    if (j > 0)
-    {
-      fprintf(w->file, "%s%s\n", indent(w->indentation),
-              vtkWrapXML_Quote(temp, 500));
-    }
-    else
-    {
-      fprintf(w->file, "\n");
-    }
-    if (cp[i] == '\n')
-    {
-      i++;
-    }
+  /* if there was no text, print the prefix by itself */
+  if (prefix)
+  {
+    vtkWrapXML_TextLine(w, prefix, "", 0);
   }
 }
 
+/**
+ * Print multi-line text at the specified indentation level.
+ */
+static void vtkWrapXML_MultiLineText(wrapxml_state_t *w, const char *cp)
+{
+  vtkWrapXML_PrefixedText(w, NULL, cp);
+}
+
 /**
  * Mark the beginning of the element body
  */
@@ -208,7 +343,7 @@ void vtkWrapXML_ElementBody(wrapxml_state_t *w)
 {
   if (w->unclosed)
   {
-    fprintf(w->file, ">\n");
+    vtkWrapXMLOutput_Printf(w->file, ">\n");
   }
   w->unclosed = 0;
 }
@@ -219,7 +354,7 @@ void vtkWrapXML_ElementBody(wrapxml_state_t *w)
 void vtkWrapXML_ElementStart(wrapxml_state_t *w, const char *name)
 {
   vtkWrapXML_ElementBody(w);
-  fprintf(w->file, "%s<%s", indent(w->indentation), name);
+  vtkWrapXMLOutput_Printf(w->file, "%s<%s", indent(w->indentation), name);
   w->unclosed = 1;
   w->indentation++;
 }
@@ -232,11 +367,11 @@ void vtkWrapXML_ElementEnd(wrapxml_state_t *w, const char *name)
   w->indentation--;
   if (w->unclosed)
   {
-    fprintf(w->file, " />\n");
+    vtkWrapXMLOutput_Printf(w->file, " />\n");
   }
   else
   {
-    fprintf(w->file, "%s</%s>\n", indent(w->indentation), name);
+    vtkWrapXMLOutput_Printf(w->file, "%s</%s>\n", indent(w->indentation), name);
   }
   w->unclosed = 0;
 }
@@ -247,7 +382,9 @@ void vtkWrapXML_ElementEnd(wrapxml_state_t *w, const char *name)
 void vtkWrapXML_Attribute(
   wrapxml_state_t *w, const char *name, const char *value)
 {
-  fprintf(w->file, " %s=\"%s\"", name, vtkWrapXML_Quote(value, 500));
+  vtkWrapXMLOutput_Printf(w->file, " %s=\"", name);
+  vtkWrapXML_WriteQuoted(w, value, (value ? strlen(value) : 0));
+  vtkWrapXMLOutput_Printf(w->file, "\"");
 }
 
 /**
@@ -256,7 +393,9 @@ void vtkWrapXML_Attribute(
 void vtkWrapXML_AttributeWithPrefix(
   wrapxml_state_t *w, const char *name, const char *prefix, const char *value)
 {
-  fprintf(w->file, " %s=\"%s%s\"", name, prefix, vtkWrapXML_Quote(value, 500));
+  vtkWrapXMLOutput_Printf(w->file, " %s=\"%s", name, prefix);
+  vtkWrapXML_WriteQuoted(w, value, (value ? strlen(value) : 0));
+  vtkWrapXMLOutput_Printf(w->file, "\"");
 }
 
 /**
@@ -269,14 +408,14 @@ void vtkWrapXML_Size(wrapxml_state_t *w, ValueInfo *val)
 
   if (ndims > 0)
   {
-    fprintf(w->file, " size=\"%s", ((ndims > 1) ? "{" : ""));
+    vtkWrapXMLOutput_Printf(w->file, " size=\"%s", ((ndims > 1) ? "{" : ""));
     for (j = 0; j < ndims; j++)
     {
-      fprintf(w->file, "%s%s",
+      vtkWrapXMLOutput_Printf(w->file, "%s%s",
         ((j > 0) ? "," : ""),
         ((val->Dimensions[j][0] == '\0') ? ":" : val->Dimensions[j]));
     }
-    fprintf(w->file, "%s\"", ((ndims > 1) ? "}" : ""));
+    vtkWrapXMLOutput_Printf(w->file, "%s\"", ((ndims > 1) ? "}" : ""));
   }
 }
 
@@ -330,19 +469,193 @@ void vtkWrapXML_Pointer(wrapxml_state_t *w, ValueInfo *val)
 }
 
 /**
- * Print the comment as multi-line text
+ * Get the id of a comment in the comment table, and add the comment
+ * to the table if it is not there yet.
+ */
+static int vtkWrapXML_CommentId(wrapxml_state_t *w, const char *comment)
+{
+  wrapxml_comments_t *table = w->comments;
+  const char **text;
+  int *slots;
+  unsigned int size, i;
+  int j;
+
+  /* grow the hash table when it is half full */
+  if ((unsigned int)(2*table->count) >= table->size)
+  {
+    size = (table->size == 0 ? 256 : 2*table->size);
+    slots = (int *)vtkWrapXMLArena_Alloc(w->arena, sizeof(int)*size);
+    text = (const char **)vtkWrapXMLArena_Alloc(
+      w->arena, sizeof(char *)*size/2);
+    for (j = 0; j < table->count; j++)
+    {
+      text[j] = table->text[j];
+      i = (unsigned int)vtkWrapXMLHash_String(
+        VTK_WRAP_XML_HASH_INIT, text[j]) & (size - 1);
+      while (slots[i] != 0)
+      {
+        i = (i + 1) & (size - 1);
+      }
+      slots[i] = j + 1;
+    }
+    table->size = size;
+    table->slots = slots;
+    table->text = text;
+  }
+
+  i = (unsigned int)vtkWrapXMLHash_String(
+    VTK_WRAP_XML_HASH_INIT, comment) & (table->size - 1);
+  while (table->slots[i] != 0)
+  {
+    j = table->slots[i] - 1;
+    if (strcmp(table->text[j], comment) == 0)
+    {
+      return j;
+    }
+    i = (i + 1) & (table->size - 1);
+  }
+
+  j = table->count++;
+  table->text[j] = comment;
+  table->slots[i] = j + 1;
+
+  return j;
+}
+
+/**
+ * Print one part of a split comment as an element with text
+ */
+static void vtkWrapXML_DocPart(
+  wrapxml_state_t *w, const char *elementName,
+  const char *attrib, const char *value, const char *text)
+{
+  vtkWrapXML_ElementStart(w, elementName);
+  if (attrib)
+  {
+    vtkWrapXML_Attribute(w, attrib, value);
+  }
+  if (text)
+  {
+    vtkWrapXML_ElementBody(w);
+    vtkWrapXML_MultiLineText(w, text);
+  }
+  vtkWrapXML_ElementEnd(w, elementName);
+}
+
+/**
+ * Print the parts of a split comment
+ */
+static void vtkWrapXML_Doc(wrapxml_state_t *w, const WrapXMLDoc *doc)
+{
+  const char *elementName = "doc";
+  int i;
+
+  if (doc->Brief == NULL && doc->Details == NULL && doc->Return == NULL &&
+      doc->NumberOfParams == 0 && doc->NumberOfSections == 0 &&
+      doc->NumberOfSeeAlso == 0)
+  {
+    return;
+  }
+
+  vtkWrapXML_ElementStart(w, elementName);
+  vtkWrapXML_ElementBody(w);
+
+  if (doc->Brief)
+  {
+    vtkWrapXML_DocPart(w, "brief", NULL, NULL, doc->Brief);
+  }
+  if (doc->Details)
+  {
+    vtkWrapXML_DocPart(w, "details", NULL, NULL, doc->Details);
+  }
+  for (i = 0; i < doc->NumberOfParams; i++)
+  {
+    vtkWrapXML_DocPart(
+      w, "param", "name", doc->ParamNames[i], doc->ParamText[i]);
+  }
+  if (doc->Return)
+  {
+    vtkWrapXML_DocPart(w, "return", NULL, NULL, doc->Return);
+  }
+  for (i = 0; i < doc->NumberOfSections; i++)
+  {
+    vtkWrapXML_DocPart(
+      w, "section", "title", doc->SectionTitles[i], doc->SectionText[i]);
+  }
+  for (i = 0; i < doc->NumberOfSeeAlso; i++)
+  {
+    vtkWrapXML_DocPart(w, "seealso", "name", doc->SeeAlso[i], NULL);
+  }
+
+  vtkWrapXML_ElementEnd(w, elementName);
+}
+
+/**
+ * Print the comment as multi-line text, and as its parts if requested
  */
 void vtkWrapXML_Comment(wrapxml_state_t *w, const char *comment)
 {
   const char *elementName = "comment";
+  char text[32];
+  WrapXMLDoc doc;
+
+  if (comment == NULL)
+  {
+    return;
+  }
 
-  if (comment)
+  if (w->rawComments && w->comments)
+  {
+    /* refer to the comment in the comment table */
+    sprintf(text, "%d", vtkWrapXML_CommentId(w, comment));
+    vtkWrapXML_ElementStart(w, elementName);
+    vtkWrapXML_Attribute(w, "ref", text);
+    vtkWrapXML_ElementEnd(w, elementName);
+  }
+  else if (w->rawComments)
   {
     vtkWrapXML_ElementStart(w, elementName);
     vtkWrapXML_ElementBody(w);
     vtkWrapXML_MultiLineText(w, comment);
     vtkWrapXML_ElementEnd(w, elementName);
   }
+
+  if (w->splitComments)
+  {
+    vtkWrapXMLDoc_Parse(&doc, comment, w->arena);
+    vtkWrapXML_Doc(w, &doc);
+  }
+}
+
+/**
+ * Print the table of comments that were referred to by id
+ */
+void vtkWrapXML_CommentTable(wrapxml_state_t *w)
+{
+  const char *elementName = "comments";
+  char text[32];
+  int i;
+
+  if (w->comments == NULL || w->comments->count == 0)
+  {
+    return;
+  }
+
+  vtkWrapXMLOutput_Putc(w->file, '\n');
+  vtkWrapXML_ElementStart(w, elementName);
+  vtkWrapXML_ElementBody(w);
+
+  for (i = 0; i < w->comments->count; i++)
+  {
+    sprintf(text, "%d", i);
+    vtkWrapXML_ElementStart(w, "comment");
+    vtkWrapXML_Attribute(w, "id", text);
+    vtkWrapXML_ElementBody(w);
+    vtkWrapXML_MultiLineText(w, w->comments->text[i]);
+    vtkWrapXML_ElementEnd(w, "comment");
+  }
+
+  vtkWrapXML_ElementEnd(w, elementName);
 }
 
 /**
@@ -375,7 +688,7 @@ void vtkWrapXML_Flag(wrapxml_state_t *w, const char *name, int value)
 {
   if (value)
   {
-    fprintf(w->file, " %s=\"1\"", name);
+    vtkWrapXMLOutput_Printf(w->file, " %s=\"1\"", name);
   }
 }
 
@@ -398,10 +711,11 @@ void vtkWrapXML_Value(wrapxml_state_t *w, const char *value)
 /**
  * Write the file header
  */
-void vtkWrapXML_FileHeader(wrapxml_state_t *w, const FileInfo *data)
+void vtkWrapXML_FileHeader(wrapxml_state_t *w, FileInfo *data)
 {
   const char *elementName = "file";
   const char *cp = data->FileName;
+  char fingerprint[20];
   size_t i;
 
   vtkWrapXML_ElementStart(w, elementName);
@@ -414,6 +728,9 @@ void vtkWrapXML_FileHeader(wrapxml_state_t *w, const FileInfo *data)
     }
     vtkWrapXML_Name(w, &cp[i]);
   }
+  vtkWrapXMLFingerprints_ToString(
+    vtkWrapXMLFingerprints_File(w->fingerprints, data), fingerprint);
+  vtkWrapXML_Attribute(w, "fingerprint", fingerprint);
   vtkWrapXML_ElementBody(w);
   w->indentation--;
 }
@@ -427,6 +744,9 @@ void vtkWrapXML_FileFooter(wrapxml_state_t *w, const FileInfo *data)
   /* avoid warning */
   (void)data;
 
+  /* the comments go at the end, after all references to them */
+  vtkWrapXML_CommentTable(w);
+
   w->indentation++;
   vtkWrapXML_ElementEnd(w, elementName);
 }
@@ -451,21 +771,14 @@ int vtkWrapXML_EmptyString(const char *cp)
 }
 
 /**
- * Write out the VTK-style documentation for the file
+ * Write out the VTK-style documentation for the file as a comment
  */
-void vtkWrapXML_FileDoc(wrapxml_state_t *w, FileInfo *data)
+static void vtkWrapXML_FileComment(wrapxml_state_t *w, FileInfo *data)
 {
   size_t n;
-  char temp[500];
   const char *cp;
-
-  if (vtkWrapXML_EmptyString(data->NameComment) &&
-      vtkWrapXML_EmptyString(data->Description) &&
-      vtkWrapXML_EmptyString(data->Caveats) &&
-      vtkWrapXML_EmptyString(data->SeeAlso))
-  {
-    return;
-  }
+  const char *name;
+  const char *rest;
 
   vtkWrapXML_ElementStart(w, "comment");
   vtkWrapXML_ElementBody(w);
@@ -477,67 +790,40 @@ void vtkWrapXML_FileDoc(wrapxml_state_t *w, FileInfo *data)
     {
       cp++;
     }
-    strncpy(temp, " .NAME ", 7);
-    n = strlen(cp) + 7;
-    n = (n >= 500 ? 500-1 : n);
-    strncpy(&temp[7], cp, n-7);
-    temp[n] = '\0';
-    vtkWrapXML_MultiLineText(w, temp);
+    vtkWrapXML_PrefixedText(w, " .NAME ", cp);
   }
 
   if (data->Description)
   {
-    fprintf(w->file, "\n%s .SECTION Description\n", indent(w->indentation));
+    vtkWrapXMLOutput_Printf(w->file, "\n%s .SECTION Description\n",
+                            indent(w->indentation));
     vtkWrapXML_MultiLineText(w, data->Description);
   }
 
   if (data->Caveats && data->Caveats[0] != '\0')
   {
-    fprintf(w->file, "\n%s .SECTION Caveats\n", indent(w->indentation));
+    vtkWrapXMLOutput_Printf(w->file, "\n%s .SECTION Caveats\n",
+                            indent(w->indentation));
     vtkWrapXML_MultiLineText(w, data->Caveats);
   }
 
   if (data->SeeAlso && data->SeeAlso[0] != '\0')
   {
-    fprintf(w->file, "\n%s .SECTION See also\n", indent(w->indentation));
+    vtkWrapXMLOutput_Printf(w->file, "\n%s .SECTION See also\n",
+                            indent(w->indentation));
 
     cp = data->SeeAlso;
-    while(vtkWrapXML_IsSpace(*cp))
+    while ((name = vtkWrapXMLDoc_NextSeeAlso(data->SeeAlso, &cp, &n, &rest)))
     {
-      cp++;
+      vtkWrapXMLOutput_Printf(w->file, "%s ", indent(w->indentation));
+      vtkWrapXML_WriteQuoted(w, name, n);
+      vtkWrapXMLOutput_Putc(w->file, '\n');
     }
-    while(*cp)
+    /* There might be another section in the See also */
+    if (rest)
     {
-      n = 0;
-      while(cp[n] && !vtkWrapXML_IsSpace(cp[n]))
-      {
-        n++;
-      }
-      /* There might be another section in the See also */
-      if (strncmp(cp, ".SECTION", 8) == 0)
-      {
-        fprintf(w->file, "\n");
-
-        while(cp > data->SeeAlso && vtkWrapXML_IsSpace(*(cp - 1)) && *(cp - 1) != '\n')
-        {
-          cp--;
-        }
-        vtkWrapXML_MultiLineText(w, cp);
-        break;
-      }
-
-      if (n > 0 && n < 400)
-      {
-        strncpy(temp, cp, n);
-        temp[n] = '\0';
-        fprintf(w->file,"%s %s\n", indent(w->indentation),
-                vtkWrapXML_Quote(temp,500));
-      }
-      cp += n;
-      while(vtkWrapXML_IsSpace(*cp))
-      {
-        cp++;
-      }
+      vtkWrapXMLOutput_Putc(w->file, '\n');
+      vtkWrapXML_MultiLineText(w, rest);
     }
   }
 
@@ -545,34 +831,104 @@ void vtkWrapXML_FileDoc(wrapxml_state_t *w, FileInfo *data)
 }
 
 /**
- * Write the inheritance section
+ * Write out the VTK-style documentation for the file
+ */
+void vtkWrapXML_FileDoc(wrapxml_state_t *w, FileInfo *data)
+{
+  WrapXMLDoc doc;
+
+  if (vtkWrapXML_EmptyString(data->NameComment) &&
+      vtkWrapXML_EmptyString(data->Description) &&
+      vtkWrapXML_EmptyString(data->Caveats) &&
+      vtkWrapXML_EmptyString(data->SeeAlso))
+  {
+    return;
+  }
+
+  if (w->rawComments)
+  {
+    vtkWrapXML_FileComment(w, data);
+  }
+
+  if (w->splitComments)
+  {
+    vtkWrapXMLDoc_ParseFile(&doc, data, w->arena);
+    vtkWrapXML_Doc(w, &doc);
+  }
+}
+
+/**
+ * Write the inheritance section, given the class and its base classes
  */
 void vtkWrapXML_ClassInheritance(
-  wrapxml_state_t *w, MergeInfo *merge)
+  wrapxml_state_t *w, int n, const char **classNames)
 {
   const char *elementName = "inheritance";
   const char *subElementName = "context";
-  int i, n;
+  int i;
 
   /* show the geneology */
-  n = merge->NumberOfClasses;
-
   vtkWrapXML_ElementStart(w, elementName);
   vtkWrapXML_ElementBody(w);
-  for (i = 1; i < n; i++)
+  for (i = 0; i < n; i++)
   {
     vtkWrapXML_ElementStart(w, subElementName);
-    vtkWrapXML_Name(w, merge->ClassNames[i]);
+    vtkWrapXML_Name(w, classNames[i]);
     vtkWrapXML_Attribute(w, "access", "public");
     vtkWrapXML_ElementEnd(w, subElementName);
   }
   vtkWrapXML_ElementEnd(w, elementName);
 }
 
+/**
+ * Write the inheritance section by looking up each base class, first
+ * in the namespace of the class and then in the hierarchy files
+ */
+void vtkWrapXML_HierarchyInheritance(
+  wrapxml_state_t *w, NamespaceInfo *data, ClassInfo *classInfo)
+{
+  const char *classNames[VTK_WRAP_XML_MAX_BASES];
+  int n;
+
+  n = vtkWrapXMLHierarchy_BaseClasses(
+    w->hierarchy, data, classInfo, NULL, classNames);
+
+  if (n > 1)
+  {
+    vtkWrapXMLOutput_Putc(w->file, '\n');
+    vtkWrapXML_ClassInheritance(w, n, classNames);
+  }
+}
+
 /* needed for type */
 void vtkWrapXML_FunctionCommon(
   wrapxml_state_t *w, FunctionInfo *func, int doReturn);
 
+/**
+ * Print the type as numbers: the VTK_PARSE bitfield, the number of
+ * values, and the id of the class if the type is a VTK object
+ */
+void vtkWrapXML_TypeCodes(wrapxml_state_t *w, ValueInfo *val)
+{
+  char text[32];
+
+  vtkWrapXMLOutput_Printf(w->file, " typecode=\"0x%x\"", val->Type);
+
+  if (val->Count > 0)
+  {
+    vtkWrapXMLOutput_Printf(w->file, " count=\"%d\"", val->Count);
+  }
+
+  if ((val->Type & VTK_PARSE_BASE_TYPE) == VTK_PARSE_OBJECT &&
+      val->Class && vtkWrapXMLHierarchy_IsVTKObject(
+        w->hierarchy, w->data->Contents, val->Class))
+  {
+    vtkWrapXMLFingerprints_ToString(
+      vtkWrapXMLPerfectHash_Key(val->Class), text);
+    vtkWrapXML_Attribute(w, "classid", text);
+  }
+}
+
 /**
  * Print out a type in XML format
  */
@@ -626,6 +982,11 @@ void vtkWrapXML_TypeAttributes(wrapxml_state_t *w, ValueInfo *val)
 
   vtkWrapXML_Pointer(w, val);
   vtkWrapXML_Size(w, val);
+
+  if (w->typeCodes)
+  {
+    vtkWrapXML_TypeCodes(w, val);
+  }
 }
 
 /**
@@ -681,6 +1042,7 @@ void vtkWrapXML_TypeSimple(
     sizes[0] = temp;
     val.Dimensions = sizes;
     val.NumberOfDimensions = 1;
+    val.Count = size;
   }
 
   vtkWrapXML_TypeAttributes(w, &val);
@@ -779,7 +1141,7 @@ void vtkWrapXML_Enum(
   int i;
   const char *elementName = "enum";
 
-  fprintf(w->file, "\n");
+  vtkWrapXMLOutput_Putc(w->file, '\n');
   vtkWrapXML_ElementStart(w, elementName);
 
   if (inClass)
@@ -811,7 +1173,7 @@ void vtkWrapXML_Constant(
   /* inClass will be 2 for enum class */
   if (inClass < 2)
   {
-    fprintf(w->file, "\n");
+    vtkWrapXMLOutput_Putc(w->file, '\n');
   }
 
   vtkWrapXML_ElementStart(w, elementName);
@@ -855,7 +1217,7 @@ void vtkWrapXML_Variable(
     elementName = "member";
   }
 
-  fprintf(w->file, "\n");
+  vtkWrapXMLOutput_Putc(w->file, '\n');
   vtkWrapXML_ElementStart(w, elementName);
 
   vtkWrapXML_Name(w, var->Name);
@@ -892,7 +1254,7 @@ void vtkWrapXML_Typedef(
 {
   const char *elementName = "typedef";
 
-  fprintf(w->file, "\n");
+  vtkWrapXMLOutput_Putc(w->file, '\n');
   vtkWrapXML_ElementStart(w, elementName);
 
   vtkWrapXML_Name(w, type->Name);
@@ -938,7 +1300,7 @@ void vtkWrapXML_Using(
       name = data->Name;
     }
 
-    fprintf(w->file, "\n");
+    vtkWrapXMLOutput_Putc(w->file, '\n');
     vtkWrapXML_ElementStart(w, elementName);
     vtkWrapXML_Name(w, name);
     vtkWrapXML_Attribute(w, "context", data->Scope);
@@ -955,8 +1317,7 @@ void vtkWrapXML_FunctionCommon(
 {
   ValueInfo *arg;
   int i, n;
-  char temp[500];
-  char *cp = 0;
+  const char *cp;
   size_t l;
 
   if (func->IsStatic)
@@ -979,18 +1340,10 @@ void vtkWrapXML_FunctionCommon(
     vtkWrapXML_ElementStart(w, "signature");
     vtkWrapXML_ElementBody(w);
 
-    l = vtkParse_FunctionInfoToString(func, NULL, VTK_PARSE_EVERYTHING);
-    cp = temp;
-    if (l+1 > sizeof(temp))
-    {
-      cp = (char *)malloc(l+1);
-    }
-    vtkParse_FunctionInfoToString(func, cp, VTK_PARSE_EVERYTHING);
-    fprintf(w->file, "%s %s\n", indent(w->indentation), vtkWrapXML_Quote(cp, 500));
-    if (cp != temp)
-    {
-      free(cp);
-    }
+    cp = vtkWrapXMLSignatures_Get(w->signatures, func, &l);
+    vtkWrapXMLOutput_Printf(w->file, "%s ", indent(w->indentation));
+    vtkWrapXML_WriteQuoted(w, cp, l);
+    vtkWrapXMLOutput_Putc(w->file, '\n');
     vtkWrapXML_ElementEnd(w, "signature");
   }
 
@@ -999,9 +1352,9 @@ void vtkWrapXML_FunctionCommon(
   {
     vtkWrapXML_ElementStart(w, "expects");
     vtkWrapXML_ElementBody(w);
-    vtkParse_FunctionInfoToString(func, cp, VTK_PARSE_EVERYTHING);
-    fprintf(w->file, "%s %s\n", indent(w->indentation),
-            vtkWrapXML_Quote(func->Preconds[i], 500));
+    vtkWrapXMLOutput_Printf(w->file, "%s ", indent(w->indentation));
+    vtkWrapXML_WriteQuoted(w, func->Preconds[i], strlen(func->Preconds[i]));
+    vtkWrapXMLOutput_Putc(w->file, '\n');
     vtkWrapXML_ElementEnd(w, "expects");
   }
 
@@ -1065,7 +1418,7 @@ void vtkWrapXML_Function(
     }
   }
 
-  fprintf(w->file, "\n");
+  vtkWrapXMLOutput_Putc(w->file, '\n');
   vtkWrapXML_ElementStart(w, elementName);
   vtkWrapXML_Name(w, name);
 
@@ -1073,7 +1426,7 @@ void vtkWrapXML_Function(
   {
     vtkWrapXML_Flag(w, "template", 1);
     vtkWrapXML_Template(w, func->Template);
-    fprintf(w->file, "\n");
+    vtkWrapXMLOutput_Putc(w->file, '\n');
   }
 
   vtkWrapXML_FunctionCommon(w, func, 1);
@@ -1090,7 +1443,7 @@ void vtkWrapXML_ClassPropertyMethods(
   unsigned int methodType;
   int first = 1;
 
-  fprintf(w->file, " bitfield=\"");
+  vtkWrapXMLOutput_Printf(w->file, " bitfield=\"");
 
   for (i = 0; i < 32; i++)
   {
@@ -1110,12 +1463,12 @@ void vtkWrapXML_ClassPropertyMethods(
         methodBitfield &= ~VTK_METHOD_SET_BOOL;
       }
 
-      fprintf(w->file, "%s%s", ((first == 0) ? "|" : ""),
+      vtkWrapXMLOutput_Printf(w->file, "%s%s", ((first == 0) ? "|" : ""),
         vtkParseProperties_MethodTypeAsString(methodType));
       first = 0;
     }
   }
-  fprintf(w->file, "\"");
+  vtkWrapXMLOutput_Printf(w->file, "\"");
 }
 
 /**
@@ -1164,7 +1517,7 @@ void vtkWrapXML_ClassMethod(
     return;
   }
 
-  fprintf(w->file, "\n");
+  vtkWrapXMLOutput_Putc(w->file, '\n');
   vtkWrapXML_ElementStart(w, elementName);
   if (!isCtrOrDtr)
   {
@@ -1228,7 +1581,7 @@ void vtkWrapXML_ClassProperty(
   const char *access = 0;
   int i;
 
-  fprintf(w->file, "\n");
+  vtkWrapXMLOutput_Putc(w->file, '\n');
   vtkWrapXML_ElementStart(w, elementName);
   vtkWrapXML_Name(w, property->Name);
 
@@ -1376,28 +1729,110 @@ void vtkWrapXML_MethodHelper(
 }
 
 /**
- * Print a class as xml
+ * Print the overload sets of a class, with the dispatch order of the
+ * methods for each number of arguments
  */
-void vtkWrapXML_Class(
-  wrapxml_state_t *w, NamespaceInfo *data, ClassInfo *classInfo, int inClass)
+void vtkWrapXML_Overloads(wrapxml_state_t *w, ClassInfo *classInfo)
 {
-  const char *elementName = "class";
-  ClassProperties *properties;
-  MergeInfo *merge = NULL;
-  int i, j, n;
+  const char *elementName = "overloads";
+  WrapXMLOverloads overloads;
+  WrapXMLOverloadSet *set;
+  WrapXMLOverload *entry;
+  int i, j, arity;
 
-  /* start new XML section for class */
-  fprintf(w->file, "\n");
-  if (classInfo->ItemType == VTK_STRUCT_INFO)
-  {
-    elementName = "struct";
-  }
-  else if (classInfo->ItemType == VTK_UNION_INFO)
+  vtkWrapXMLOverloads_Find(&overloads, classInfo, w->arena);
+
+  for (i = 0; i < overloads.NumberOfSets; i++)
   {
-    elementName = "union";
-  }
+    set = &overloads.Sets[i];
 
-  vtkWrapXML_ElementStart(w, elementName);
+    vtkWrapXMLOutput_Putc(w->file, '\n');
+    vtkWrapXML_ElementStart(w, elementName);
+    vtkWrapXML_Name(w, set->Name);
+    vtkWrapXMLOutput_Printf(w->file, " methods=\"%d\"", set->NumberOfMethods);
+    vtkWrapXML_ElementBody(w);
+
+    arity = -1;
+    for (j = 0; j < set->NumberOfEntries; j++)
+    {
+      entry = &set->Entries[j];
+      if (entry->Arity != arity)
+      {
+        if (arity >= 0)
+        {
+          vtkWrapXML_ElementEnd(w, "dispatch");
+        }
+        arity = entry->Arity;
+        vtkWrapXML_ElementStart(w, "dispatch");
+        vtkWrapXMLOutput_Printf(w->file, " arity=\"%d\"", arity);
+        vtkWrapXML_ElementBody(w);
+      }
+      vtkWrapXML_ElementStart(w, "candidate");
+      vtkWrapXMLOutput_Printf(w->file, " index=\"%d\"", entry->Index);
+      vtkWrapXML_Attribute(w, "key", entry->Key);
+      vtkWrapXML_ElementEnd(w, "candidate");
+    }
+    if (arity >= 0)
+    {
+      vtkWrapXML_ElementEnd(w, "dispatch");
+    }
+
+    vtkWrapXML_ElementEnd(w, elementName);
+  }
+}
+
+/**
+ * Add a class to the manifest, with the byte range of its element
+ */
+static void vtkWrapXML_AddToManifest(
+  wrapxml_state_t *w, ClassInfo *classInfo, size_t start)
+{
+  WrapXMLManifestEntry entry;
+
+  entry.Module = NULL;
+  entry.Name = classInfo->Name;
+  entry.Base = NULL;
+  if (classInfo->NumberOfSuperClasses)
+  {
+    entry.Base = classInfo->SuperClasses[0];
+  }
+  entry.IsAbstract = classInfo->IsAbstract;
+  entry.NumberOfProperties = vtkWrapXMLFingerprints_Properties(
+    w->fingerprints, classInfo)->NumberOfProperties;
+  entry.Fingerprint = vtkWrapXMLFingerprints_Class(w->fingerprints, classInfo);
+  entry.File = w->fileName;
+  entry.Start = start;
+  entry.End = vtkWrapXMLOutput_Tell(w->file);
+  entry.Segment = 0;
+  vtkWrapXMLManifest_AddEntry(w->manifest, &entry);
+}
+
+/**
+ * Print a class as xml
+ */
+void vtkWrapXML_Class(
+  wrapxml_state_t *w, NamespaceInfo *data, ClassInfo *classInfo, int inClass)
+{
+  const char *elementName = "class";
+  ClassProperties *properties;
+  MergeInfo *merge = NULL;
+  char fingerprint[20];
+  size_t start;
+  int i, j, n;
+
+  /* start new XML section for class */
+  vtkWrapXMLOutput_Putc(w->file, '\n');
+  start = vtkWrapXMLOutput_Tell(w->file);
+  if (classInfo->ItemType == VTK_STRUCT_INFO)
+  {
+    elementName = "struct";
+  }
+  else if (classInfo->ItemType == VTK_UNION_INFO)
+  {
+    elementName = "union";
+  }
+
+  vtkWrapXML_ElementStart(w, elementName);
 
   vtkWrapXML_Name(w, classInfo->Name);
 
@@ -1416,6 +1851,10 @@ void vtkWrapXML_Class(
     vtkWrapXML_Flag(w, "final", 1);
   }
 
+  vtkWrapXMLFingerprints_ToString(
+    vtkWrapXMLFingerprints_Class(w->fingerprints, classInfo), fingerprint);
+  vtkWrapXML_Attribute(w, "fingerprint", fingerprint);
+
   if (classInfo->Template)
   {
     vtkWrapXML_Flag(w, "template", 1);
@@ -1447,12 +1886,17 @@ void vtkWrapXML_Class(
 
   if (merge && merge->NumberOfClasses > 1)
   {
-    fprintf(w->file, "\n");
-    vtkWrapXML_ClassInheritance(w, merge);
+    vtkWrapXMLOutput_Putc(w->file, '\n');
+    vtkWrapXML_ClassInheritance(
+      w, merge->NumberOfClasses, (const char **)merge->ClassNames);
+  }
+  else if (w->inheritance && classInfo->NumberOfSuperClasses)
+  {
+    vtkWrapXML_HierarchyInheritance(w, data, classInfo);
   }
 
   /* get information about the properties */
-  properties = vtkParseProperties_Create(classInfo);
+  properties = vtkWrapXMLFingerprints_Properties(w->fingerprints, classInfo);
 
   /* print all members of the class */
   for (i = 0; i < classInfo->NumberOfItems; i++)
@@ -1503,8 +1947,11 @@ void vtkWrapXML_Class(
     }
   }
 
-  /* release the information about the properties */
-  vtkParseProperties_Free(properties);
+  /* the dispatch order for the overloaded methods */
+  if (w->overloads)
+  {
+    vtkWrapXML_Overloads(w, classInfo);
+  }
 
   /* release the info about what was merged from superclasses */
   if (merge)
@@ -1513,6 +1960,29 @@ void vtkWrapXML_Class(
   }
 
   vtkWrapXML_ElementEnd(w, elementName);
+
+  /* add the class and its byte range to the manifest */
+  if (w->manifest && !inClass)
+  {
+    vtkWrapXML_AddToManifest(w, classInfo, start);
+  }
+}
+
+/**
+ * Copy a class that was written concurrently, see vtkWrapXML_Classes
+ */
+static void vtkWrapXML_CopyClass(
+  wrapxml_state_t *w, ClassInfo *classInfo, WrapXMLOutput *memory)
+{
+  /* the text starts with a newline, like in vtkWrapXML_Class */
+  size_t start = vtkWrapXMLOutput_Tell(w->file) + 1;
+
+  vtkWrapXMLOutput_Copy(w->file, memory);
+
+  if (w->manifest)
+  {
+    vtkWrapXML_AddToManifest(w, classInfo, start);
+  }
 }
 
 /* needed for vtkWrapXML_Body */
@@ -1560,7 +2030,14 @@ void vtkWrapXML_Body(wrapxml_state_t *w, NamespaceInfo *data)
       case VTK_STRUCT_INFO:
       case VTK_UNION_INFO:
       {
-        vtkWrapXML_Class(w, data, data->Classes[j], 0);
+        if (w->classOutputs && data == w->classScope)
+        {
+          vtkWrapXML_CopyClass(w, data->Classes[j], w->classOutputs[j]);
+        }
+        else
+        {
+          vtkWrapXML_Class(w, data, data->Classes[j], 0);
+        }
         break;
       }
       case VTK_FUNCTION_INFO:
@@ -1583,61 +2060,1489 @@ void vtkWrapXML_Body(wrapxml_state_t *w, NamespaceInfo *data)
 void vtkWrapXML_Namespace(wrapxml_state_t *w, NamespaceInfo *data)
 {
   const char *elementName = "namespace";
-  fprintf(w->file, "\n");
+  vtkWrapXMLOutput_Putc(w->file, '\n');
   vtkWrapXML_ElementStart(w, elementName);
   vtkWrapXML_Name(w, data->Name);
   vtkWrapXML_ElementBody(w);
   vtkWrapXML_Body(w, data);
-  fprintf(w->file, "\n");
+  vtkWrapXMLOutput_Putc(w->file, '\n');
   vtkWrapXML_ElementEnd(w, elementName);
 }
 
-int main(int argc, char *argv[])
+/* ----- Concurrent analysis and writing of classes ----- */
+
+/* the work that is shared by the threads */
+typedef struct _wrapxml_classes
 {
-  FILE *fp;
-  FileInfo *data;
-  OptionInfo *options;
+  wrapxml_state_t *state; /* the state of the main writer */
+  NamespaceInfo *scope; /* the namespace that holds the classes */
+  WrapXMLOutput **outputs; /* where to write each class, or NULL */
+  WrapXMLMutex *mutex; /* protects "next" */
+  int next; /* the next class to be done */
+  int numberOfWorkers;
+  struct _wrapxml_worker *workers;
+} wrapxml_classes_t;
+
+/* each thread has its own tables and memory */
+typedef struct _wrapxml_worker
+{
+  wrapxml_classes_t *classes;
+  int traceThread;
+  WrapXMLArena *arena;
+  WrapXMLSignatures signatures;
+  WrapXMLFingerprints fingerprints;
+} wrapxml_worker_t;
+
+/**
+ * The thread function, which takes classes until none are left
+ */
+static void vtkWrapXML_ClassWorker(void *arg)
+{
+  wrapxml_worker_t *worker = (wrapxml_worker_t *)arg;
+  wrapxml_classes_t *classes = worker->classes;
   wrapxml_state_t ws;
+  ClassInfo *classInfo;
+  double start;
+  int j;
 
-  /* pre-define a macro to identify the language */
-  vtkParse_DefineMacro("__VTK_WRAP_XML__", 0);
+  for (;;)
+  {
+    vtkWrapXMLThreads_Lock(classes->mutex);
+    j = classes->next++;
+    vtkWrapXMLThreads_Unlock(classes->mutex);
+    if (j >= classes->scope->NumberOfClasses)
+    {
+      break;
+    }
 
-  /* handle args, parse header, get output file handle */
-  data = vtkParse_Main(argc, argv);
+    /* find the properties, render the signatures, and hash the API */
+    WRAPXML_ALLOC_PHASE("classes");
+    start = vtkWrapXMLTrace_Now(classes->state->trace);
+    classInfo = classes->scope->Classes[j];
+    vtkWrapXMLFingerprints_Class(&worker->fingerprints, classInfo);
 
-  /* get the command-line options */
-  options = vtkParse_GetCommandLineOptions();
+    if (classes->outputs)
+    {
+      /* the state at the top level of the body of the file */
+      ws = *classes->state;
+      ws.file = classes->outputs[j];
+      ws.indentation = 0;
+      ws.unclosed = 0;
+      ws.arena = worker->arena;
+      ws.signatures = &worker->signatures;
+      ws.fingerprints = &worker->fingerprints;
+      ws.manifest = NULL;
+      ws.classOutputs = NULL;
+      ws.traceThread = worker->traceThread;
+      vtkWrapXML_Class(&ws, classes->scope, classInfo, 0);
+    }
 
-  /* get the output file */
-  fp = fopen(options->OutputFileName, "w");
+    vtkWrapXMLTrace_Span(classes->state->trace, worker->traceThread,
+      classInfo->Name, classes->state->data->FileName, start);
+  }
+}
 
-  if (!fp)
+/**
+ * Do the top-level classes of a file on several threads.  The threads
+ * always find the properties and fingerprints of the classes, and they
+ * also write the classes into memory if "emit" is set, so that
+ * vtkWrapXML_Body() can copy them to the file in declaration order.
+ * The classes cannot be written if there is a comment table, since
+ * the ids of the comments depend on the order they are written in.
+ */
+static void vtkWrapXML_Classes(
+  wrapxml_classes_t *classes, wrapxml_state_t *w, FileInfo *data,
+  int numberOfThreads, int emit)
+{
+  WrapXMLThread **threads;
+  wrapxml_worker_t *worker;
+  NamespaceInfo *scope = data->Contents;
+  int i, n;
+
+  memset(classes, 0, sizeof(wrapxml_classes_t));
+  if (scope == NULL || scope->NumberOfClasses < 2)
+  {
+    return;
+  }
+
+  n = scope->NumberOfClasses;
+  numberOfThreads = (numberOfThreads < n ? numberOfThreads : n);
+
+  classes->state = w;
+  classes->scope = scope;
+  classes->mutex = vtkWrapXMLThreads_NewMutex();
+  classes->numberOfWorkers = numberOfThreads;
+  classes->workers = (wrapxml_worker_t *)calloc(
+    numberOfThreads, sizeof(wrapxml_worker_t));
+
+  if (emit)
+  {
+    classes->outputs = (WrapXMLOutput **)vtkWrapXMLArena_Alloc(
+      w->arena, sizeof(WrapXMLOutput *)*n);
+    for (i = 0; i < n; i++)
+    {
+      classes->outputs[i] = vtkWrapXMLOutput_OpenMemory();
+    }
+  }
+
+  for (i = 0; i < numberOfThreads; i++)
+  {
+    worker = &classes->workers[i];
+    worker->classes = classes;
+    worker->traceThread =
+      (i == 0 ? w->traceThread : WRAPXML_TRACE_CLASSES + i);
+    worker->arena = vtkWrapXMLArena_New();
+    vtkWrapXMLSignatures_Init(&worker->signatures, worker->arena);
+    vtkWrapXMLFingerprints_Init(
+      &worker->fingerprints, &worker->signatures, w->cache, worker->arena);
+  }
+
+  /* this thread is the first worker */
+  threads = (WrapXMLThread **)calloc(numberOfThreads, sizeof(WrapXMLThread *));
+  for (i = 1; i < numberOfThreads; i++)
+  {
+    threads[i] = vtkWrapXMLThreads_Start(
+      vtkWrapXML_ClassWorker, &classes->workers[i]);
+  }
+  vtkWrapXML_ClassWorker(&classes->workers[0]);
+  for (i = 1; i < numberOfThreads; i++)
+  {
+    if (threads[i])
+    {
+      vtkWrapXMLThreads_Join(threads[i]);
+    }
+  }
+  free(threads);
+
+  /* give the results to the main writer */
+  for (i = 0; i < numberOfThreads; i++)
+  {
+    worker = &classes->workers[i];
+    vtkWrapXMLSignatures_Merge(w->signatures, &worker->signatures);
+    vtkWrapXMLFingerprints_Merge(w->fingerprints, &worker->fingerprints);
+  }
+
+  if (classes->outputs)
+  {
+    w->classScope = scope;
+    w->classOutputs = classes->outputs;
+  }
+}
+
+/**
+ * Free the memory of the threads, after the file has been written
+ */
+static void vtkWrapXML_FreeClasses(
+  wrapxml_classes_t *classes, wrapxml_state_t *w)
+{
+  int i;
+
+  if (classes->outputs)
   {
-    fprintf(stderr, "Error opening output file %s\n", options->OutputFileName);
+    for (i = 0; i < classes->scope->NumberOfClasses; i++)
+    {
+      vtkWrapXMLOutput_Close(classes->outputs[i]);
+    }
+  }
+  for (i = 0; i < classes->numberOfWorkers; i++)
+  {
+    vtkWrapXMLArena_Delete(classes->workers[i].arena);
+  }
+  if (classes->mutex)
+  {
+    vtkWrapXMLThreads_DeleteMutex(classes->mutex);
+  }
+  free(classes->workers);
+
+  w->classScope = NULL;
+  w->classOutputs = NULL;
+}
+
+/**
+ * Get the argument for an option, or exit if it is missing
+ */
+static const char *vtkWrapXML_OptionArg(int argc, char *argv[], int *i)
+{
+  if (*i + 1 >= argc)
+  {
+    fprintf(stderr, "vtkWrapXML: option %s requires an argument\n", argv[*i]);
     exit(1);
   }
 
+  return argv[++(*i)];
+}
+
+/**
+ * Remove the vtkWrapXML options from the argument list, so that the
+ * remaining arguments can be given to vtkParse_Main().  The new number
+ * of arguments is returned.
+ */
+static int vtkWrapXML_ParseOptions(
+  wrapxml_options_t *options, int argc, char *argv[])
+{
+  const char *cp;
+  int i, j;
+
+  memset(options, 0, sizeof(wrapxml_options_t));
+
+  j = 1;
+  for (i = 1; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--macros") == 0)
+    {
+      options->MacrosFile = vtkWrapXML_OptionArg(argc, argv, &i);
+    }
+    else if (strcmp(argv[i], "--write-macros") == 0)
+    {
+      options->WriteMacrosFile = vtkWrapXML_OptionArg(argc, argv, &i);
+    }
+    else if (strcmp(argv[i], "--parse-cache") == 0)
+    {
+      options->ParseCacheFile = vtkWrapXML_OptionArg(argc, argv, &i);
+    }
+    else if (strcmp(argv[i], "--batch") == 0)
+    {
+      options->Batch = 1;
+    }
+    else if (strcmp(argv[i], "--stats") == 0)
+    {
+      options->Stats = 1;
+    }
+    else if (strcmp(argv[i], "--comment-table") == 0)
+    {
+      options->CommentTable = 1;
+    }
+    else if (strcmp(argv[i], "--split-comments") == 0)
+    {
+      options->SplitComments = 1;
+    }
+    else if (strcmp(argv[i], "--no-raw-comments") == 0)
+    {
+      options->NoRawComments = 1;
+    }
+    else if (strcmp(argv[i], "--type-codes") == 0)
+    {
+      options->TypeCodes = 1;
+    }
+    else if (strcmp(argv[i], "--overloads") == 0)
+    {
+      options->Overloads = 1;
+    }
+    else if (strcmp(argv[i], "--inheritance") == 0)
+    {
+      options->Inheritance = 1;
+    }
+    else if (strcmp(argv[i], "--comment-width") == 0)
+    {
+      options->CommentWidth =
+        atoi(vtkWrapXML_OptionArg(argc, argv, &i));
+    }
+    else if (strcmp(argv[i], "--compress") == 0)
+    {
+      cp = vtkWrapXML_OptionArg(argc, argv, &i);
+      options->Compression = vtkWrapXMLOutput_CompressionFromString(cp);
+      if (options->Compression < 0)
+      {
+        fprintf(stderr, "vtkWrapXML: unknown compression %s\n", cp);
+        exit(1);
+      }
+      if (!vtkWrapXMLOutput_IsAvailable(options->Compression))
+      {
+        fprintf(stderr, "vtkWrapXML: %s compression is not available\n", cp);
+        exit(1);
+      }
+    }
+    else if (strcmp(argv[i], "--manifest") == 0)
+    {
+      options->ManifestFile = vtkWrapXML_OptionArg(argc, argv, &i);
+    }
+    else if (strcmp(argv[i], "--reflection") == 0)
+    {
+      options->ReflectionFile = vtkWrapXML_OptionArg(argc, argv, &i);
+    }
+    else if (strcmp(argv[i], "--property-table") == 0)
+    {
+      options->PropertyTableFile = vtkWrapXML_OptionArg(argc, argv, &i);
+    }
+    else if (strcmp(argv[i], "--thunks") == 0)
+    {
+      options->Thunks = 1;
+    }
+    else if (strcmp(argv[i], "--class-threads") == 0)
+    {
+      options->ClassThreads = atoi(vtkWrapXML_OptionArg(argc, argv, &i));
+      if (options->ClassThreads <= 0)
+      {
+        options->ClassThreads = vtkWrapXMLThreads_NumberOfProcessors();
+      }
+    }
+    else if (strcmp(argv[i], "--trace") == 0)
+    {
+      options->TraceFile = vtkWrapXML_OptionArg(argc, argv, &i);
+    }
+    else if (strcmp(argv[i], "--format") == 0)
+    {
+      cp = vtkWrapXML_OptionArg(argc, argv, &i);
+      if (strcmp(cp, "ndjson") == 0)
+      {
+        options->JSONLines = 1;
+      }
+      else if (strcmp(cp, "xml") != 0)
+      {
+        fprintf(stderr, "vtkWrapXML: unknown format %s\n", cp);
+        exit(1);
+      }
+    }
+    else
+    {
+      /* the output is needed if vtkParse_Main() is not called */
+      if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+      {
+        options->OutputFileName = argv[i + 1];
+        if (strcmp(argv[i + 1], "-") == 0)
+        {
+          argv[i + 1] = (char *)WRAPXML_NULL_DEVICE;
+        }
+      }
+      argv[j++] = argv[i];
+    }
+  }
+
+  argv[j] = NULL;
+
+  return j;
+}
+
+/**
+ * Get the name of a file without the directory
+ */
+static const char *vtkWrapXML_BaseName(const char *fileName)
+{
+  const char *cp = fileName + strlen(fileName);
+
+  while (cp != fileName && cp[-1] != '/' && cp[-1] != '\\')
+  {
+    cp--;
+  }
+
+  return cp;
+}
+
+/**
+ * Add the properties of the classes in a namespace to the property
+ * table, including the classes in the nested namespaces
+ */
+static void vtkWrapXML_AddToPropertyTable(
+  WrapXMLPropertyTable *table, WrapXMLFingerprints *fingerprints,
+  NamespaceInfo *contents)
+{
+  ClassInfo *classInfo;
+  ClassProperties *properties;
+  PropertyInfo *property;
+  int i, j, k;
+
+  for (i = 0; contents && i < contents->NumberOfItems; i++)
+  {
+    j = contents->Items[i].Index;
+    if (contents->Items[i].Type == VTK_NAMESPACE_INFO)
+    {
+      vtkWrapXML_AddToPropertyTable(
+        table, fingerprints, contents->Namespaces[j]);
+    }
+    else if (contents->Items[i].Type == VTK_CLASS_INFO ||
+             contents->Items[i].Type == VTK_STRUCT_INFO)
+    {
+      classInfo = contents->Classes[j];
+      if (classInfo->Name == NULL || classInfo->Template)
+      {
+        continue;
+      }
+      properties = vtkWrapXMLFingerprints_Properties(fingerprints, classInfo);
+      for (k = 0; k < properties->NumberOfProperties; k++)
+      {
+        property = properties->Properties[k];
+        vtkWrapXMLPropertyTable_AddRow(table, classInfo->Name,
+          property->Name, property->ClassName, property->Type,
+          property->Count, property->PublicMethods,
+          property->ProtectedMethods, property->LegacyMethods);
+      }
+    }
+  }
+}
+
+/**
+ * Write the XML for a parsed header, or the JSON Lines if that format
+ * was requested, to an output that has already been opened.  The name
+ * of the output file is only used for the manifest.  If a file for the
+ * reflection tables is given, they are written to it as well.  The
+ * phases are added to the timeline as spans on the given thread.
+ */
+static void vtkWrapXML_WriteOutput(
+  wrapxml_options_t *options, FileInfo *data, WrapXMLCache *cache,
+  WrapXMLArena *arena, WrapXMLManifest *manifest, WrapXMLOutput *reflection,
+  WrapXMLOutput *fp, const char *outputFileName, int traceThread)
+{
+  WrapXMLTrace *trace = options->Trace;
+  wrapxml_state_t ws;
+  wrapxml_comments_t comments;
+  wrapxml_classes_t classes;
+  WrapXMLSignatures signatures;
+  WrapXMLFingerprints fingerprints;
+  double start;
+
   /* a struct to keep track of things */
   ws.data = data;
   ws.file = fp;
   ws.indentation = 0;
   ws.unclosed = 0;
+  ws.commentWidth = options->CommentWidth;
+  ws.splitComments = options->SplitComments;
+  ws.rawComments = !(options->SplitComments && options->NoRawComments);
+  ws.typeCodes = options->TypeCodes;
+  ws.inheritance = options->Inheritance;
+  ws.overloads = options->Overloads;
+  ws.cache = cache;
+  ws.arena = arena;
+  ws.comments = NULL;
+  ws.signatures = &signatures;
+  ws.fingerprints = &fingerprints;
+  ws.manifest = manifest;
+  ws.fileName = NULL;
+  ws.classScope = NULL;
+  ws.classOutputs = NULL;
+  ws.hierarchy = options->Hierarchy;
+  ws.trace = trace;
+  ws.traceThread = traceThread;
+
+  /* the manifest gives the file name without the directory */
+  if (strcmp(outputFileName, "-") != 0)
+  {
+    ws.fileName = vtkWrapXML_BaseName(outputFileName);
+  }
 
-  /* print the lead-in */
-  vtkWrapXML_FileHeader(&ws, data);
+  vtkWrapXMLSignatures_Init(&signatures, arena);
+  vtkWrapXMLFingerprints_Init(&fingerprints, &signatures, cache, arena);
 
-  /* print the documentation */
-  vtkWrapXML_FileDoc(&ws, data);
+  /* analyze the classes concurrently, and write them if possible */
+  memset(&classes, 0, sizeof(classes));
+  if (options->ClassThreads > 1)
+  {
+    WRAPXML_ALLOC_PHASE("classes");
+    start = vtkWrapXMLTrace_Now(trace);
+    vtkWrapXML_Classes(&classes, &ws, data, options->ClassThreads,
+      (!options->JSONLines && !options->CommentTable));
+    vtkWrapXMLTrace_Span(
+      trace, traceThread, "classes", data->FileName, start);
+  }
 
-  /* print the main body */
-  vtkWrapXML_Body(&ws, data->Contents);
+  /* find the properties and fingerprints of everything before writing,
+   * the results are kept, so this only moves the work out of the
+   * writers and lets the timeline show the two phases separately */
+  WRAPXML_ALLOC_PHASE("properties");
+  start = vtkWrapXMLTrace_Now(trace);
+  vtkWrapXMLFingerprints_File(&fingerprints, data);
+  vtkWrapXMLTrace_Span(
+    trace, traceThread, "properties", data->FileName, start);
 
-  /* print the closing tag */
-  vtkWrapXML_FileFooter(&ws, data);
+  if (options->PropertyTable)
+  {
+    vtkWrapXML_AddToPropertyTable(
+      options->PropertyTable, &fingerprints, data->Contents);
+  }
 
-  fclose(fp);
+  WRAPXML_ALLOC_PHASE("emit");
+  start = vtkWrapXMLTrace_Now(trace);
+  if (reflection)
+  {
+    vtkWrapXMLCxx_WriteFile(
+      reflection, data, &fingerprints, options->Thunks, options->Hierarchy);
+  }
 
-  vtkParse_Free(data);
+  if (options->JSONLines)
+  {
+    vtkWrapXMLJSON_WriteFile(fp, data, &fingerprints);
+  }
+  else
+  {
+    if (options->CommentTable)
+    {
+      memset(&comments, 0, sizeof(comments));
+      ws.comments = &comments;
+    }
+
+    /* print the lead-in */
+    vtkWrapXML_FileHeader(&ws, data);
+
+    /* print the documentation */
+    vtkWrapXML_FileDoc(&ws, data);
+
+    /* print the main body */
+    vtkWrapXML_Body(&ws, data->Contents);
+
+    /* print the closing tag */
+    vtkWrapXML_FileFooter(&ws, data);
+  }
+  vtkWrapXMLTrace_Span(trace, traceThread, "emit", data->FileName, start);
+
+  vtkWrapXML_FreeClasses(&classes, &ws);
+}
+
+/**
+ * Write the XML file for a parsed header, or the JSON Lines if that
+ * format was requested.  The name "-" writes to stdout.
+ */
+static void vtkWrapXML_WriteFile(
+  wrapxml_options_t *options, FileInfo *data, WrapXMLCache *cache,
+  WrapXMLArena *arena, WrapXMLManifest *manifest, WrapXMLOutput *reflection,
+  const char *outputFileName)
+{
+  WrapXMLOutput *fp;
+  double start;
+
+  /* get the output file */
+  fp = vtkWrapXMLOutput_Open(outputFileName, options->Compression);
+
+  if (!fp)
+  {
+    fprintf(stderr, "Error opening output file %s\n", outputFileName);
+    exit(1);
+  }
+
+  vtkWrapXML_WriteOutput(options, data, cache, arena, manifest, reflection,
+    fp, outputFileName, WRAPXML_TRACE_PARSER);
+
+  /* flush the compressor and the file */
+  WRAPXML_ALLOC_PHASE("commit");
+  start = vtkWrapXMLTrace_Now(options->Trace);
+  vtkWrapXMLTrace_Counter(
+    options->Trace, "bytes written", (double)vtkWrapXMLOutput_Tell(fp));
+  if (!vtkWrapXMLOutput_Close(fp))
+  {
+    fprintf(stderr, "Error writing output file %s\n", outputFileName);
+    exit(1);
+  }
+  vtkWrapXMLTrace_Span(
+    options->Trace, WRAPXML_TRACE_PARSER, "commit", data->FileName, start);
+}
+
+/* ----- The pipeline for batch mode ----- */
+
+/* the number of headers that can wait between the stages */
+#define WRAPXML_BATCH_QUEUE_SIZE 4
+
+/* a header that is passing through the pipeline */
+typedef struct _wrapxml_job
+{
+  FileInfo *data; /* the parsed header, returned once its text is written */
+  const char *fileName; /* the header */
+  char *outputFileName;
+  WrapXMLOutput *memory; /* the text for the output file */
+} wrapxml_job_t;
+
+/* the shared state of the stages, and the queues between them */
+typedef struct _wrapxml_batch
+{
+  wrapxml_options_t *options;
+  WrapXMLArena *arena; /* only used by the second stage */
+  WrapXMLManifest *manifest;
+  WrapXMLOutput *reflection;
+  WrapXMLQueue *parsed; /* headers that are ready to be written */
+  WrapXMLQueue *written; /* text that is ready for the file */
+  WrapXMLMutex *returnedMutex; /* protects the returned headers */
+  FileInfo **returned; /* parsed headers for the parser thread to free */
+  int numberOfReturned;
+  int maxReturned;
+  int errors; /* files that could not be written */
+  size_t bytesWritten; /* the text that went into the files */
+} wrapxml_batch_t;
+
+/**
+ * Add the number of headers that are waiting in each queue to the
+ * timeline
+ */
+static void vtkWrapXML_TraceQueues(wrapxml_batch_t *batch)
+{
+  WrapXMLTrace *trace = batch->options->Trace;
+
+  if (trace)
+  {
+    vtkWrapXMLTrace_Counter(trace, "parsed queue",
+      vtkWrapXMLThreads_QueueLength(batch->parsed));
+    vtkWrapXMLTrace_Counter(trace, "written queue",
+      vtkWrapXMLThreads_QueueLength(batch->written));
+  }
+}
+
+/**
+ * Give a parsed header back to the parser thread, which frees it,
+ * since only the parser thread can call into vtkParse
+ */
+static void vtkWrapXML_ReturnData(wrapxml_batch_t *batch, FileInfo *data)
+{
+  vtkWrapXMLThreads_Lock(batch->returnedMutex);
+  if (batch->numberOfReturned == batch->maxReturned)
+  {
+    batch->maxReturned = 2*batch->maxReturned + WRAPXML_BATCH_QUEUE_SIZE;
+    batch->returned = (FileInfo **)realloc(
+      batch->returned, sizeof(FileInfo *)*batch->maxReturned);
+  }
+  batch->returned[batch->numberOfReturned++] = data;
+  vtkWrapXMLThreads_Unlock(batch->returnedMutex);
+}
+
+/**
+ * Free the parsed headers that were given back, this must only be
+ * called from the parser thread
+ */
+static void vtkWrapXML_FreeReturnedData(wrapxml_batch_t *batch)
+{
+  int i;
+
+  vtkWrapXMLThreads_Lock(batch->returnedMutex);
+  for (i = 0; i < batch->numberOfReturned; i++)
+  {
+    vtkParse_Free(batch->returned[i]);
+  }
+  batch->numberOfReturned = 0;
+  vtkWrapXMLThreads_Unlock(batch->returnedMutex);
+}
+
+/**
+ * The second stage: write the text for a header into memory, and
+ * add its classes to the manifest and the reflection tables
+ */
+static void vtkWrapXML_EmitJob(
+  wrapxml_batch_t *batch, wrapxml_job_t *job, int traceThread)
+{
+  WRAPXML_ALLOC_PHASE("emit");
+  job->memory = vtkWrapXMLOutput_OpenMemory();
+  vtkWrapXML_WriteOutput(
+    batch->options, job->data, NULL, batch->arena, batch->manifest,
+    batch->reflection, job->memory, job->outputFileName, traceThread);
+
+  /* the parser might be busy, so it frees the header later */
+  vtkWrapXML_ReturnData(batch, job->data);
+  job->data = NULL;
+  vtkWrapXMLArena_Reset(batch->arena);
+}
+
+/**
+ * The third stage: create the file and write the text into it,
+ * compressing it if requested
+ */
+static void vtkWrapXML_WriteJob(
+  wrapxml_batch_t *batch, wrapxml_job_t *job, int traceThread)
+{
+  WrapXMLTrace *trace = batch->options->Trace;
+  WrapXMLOutput *fp;
+  double start = vtkWrapXMLTrace_Now(trace);
+  size_t size;
+
+  WRAPXML_ALLOC_PHASE("commit");
+
+  /* the copy empties the memory file, so get the size first */
+  size = vtkWrapXMLOutput_Tell(job->memory);
+
+  fp = vtkWrapXMLOutput_Open(
+    job->outputFileName, batch->options->Compression);
+  if (!fp)
+  {
+    fprintf(stderr, "Error opening output file %s\n", job->outputFileName);
+    batch->errors++;
+  }
+  else
+  {
+    vtkWrapXMLOutput_Copy(fp, job->memory);
+    if (!vtkWrapXMLOutput_Close(fp))
+    {
+      fprintf(stderr, "Error writing output file %s\n", job->outputFileName);
+      batch->errors++;
+    }
+    else
+    {
+      batch->bytesWritten += size;
+    }
+  }
+
+  vtkWrapXMLTrace_Counter(
+    trace, "bytes written", (double)batch->bytesWritten);
+  vtkWrapXMLTrace_Span(trace, traceThread, "commit", job->fileName, start);
+
+  vtkWrapXMLOutput_Close(job->memory);
+  free(job->outputFileName);
+  free(job);
+}
+
+/**
+ * The thread for the second stage
+ */
+static void vtkWrapXML_EmitStage(void *arg)
+{
+  wrapxml_batch_t *batch = (wrapxml_batch_t *)arg;
+  WrapXMLTrace *trace = batch->options->Trace;
+  wrapxml_job_t *job;
+  const char *fileName;
+  double start;
+
+  while ((job = (wrapxml_job_t *)vtkWrapXMLThreads_Pop(batch->parsed)))
+  {
+    vtkWrapXML_TraceQueues(batch);
+    start = vtkWrapXMLTrace_Now(trace);
+    fileName = job->fileName;
+    vtkWrapXML_EmitJob(batch, job, WRAPXML_TRACE_EMITTER);
+    vtkWrapXMLTrace_Span(trace, WRAPXML_TRACE_EMITTER,
+      vtkWrapXML_BaseName(fileName), fileName, start);
+    vtkWrapXMLThreads_Push(batch->written, job);
+    vtkWrapXML_TraceQueues(batch);
+  }
+  vtkWrapXMLThreads_CloseQueue(batch->written);
+}
+
+/**
+ * The thread for the third stage
+ */
+static void vtkWrapXML_WriteStage(void *arg)
+{
+  wrapxml_batch_t *batch = (wrapxml_batch_t *)arg;
+  WrapXMLTrace *trace = batch->options->Trace;
+  wrapxml_job_t *job;
+  const char *fileName;
+  double start;
+
+  while ((job = (wrapxml_job_t *)vtkWrapXMLThreads_Pop(batch->written)))
+  {
+    vtkWrapXML_TraceQueues(batch);
+    start = vtkWrapXMLTrace_Now(trace);
+    fileName = job->fileName;
+    vtkWrapXML_WriteJob(batch, job, WRAPXML_TRACE_WRITER);
+    vtkWrapXMLTrace_Span(trace, WRAPXML_TRACE_WRITER,
+      vtkWrapXML_BaseName(fileName), fileName, start);
+  }
+}
+
+/**
+ * Get the output file for a header in batch mode, which is the header
+ * name in the output directory with a new suffix.  The directory "-"
+ * is stdout.  The name must be freed.
+ */
+static char *vtkWrapXML_BatchFileName(
+  const char *outputDir, const char *fileName, const char *suffix,
+  const char *compressSuffix)
+{
+  const char *cp;
+  char *outputFileName;
+  size_t l, m;
+
+  if (strcmp(outputDir, "-") == 0)
+  {
+    outputFileName = (char *)malloc(2);
+    strcpy(outputFileName, "-");
+    return outputFileName;
+  }
+
+  cp = fileName + strlen(fileName);
+  while (cp != fileName && cp[-1] != '/' && cp[-1] != '\\')
+  {
+    cp--;
+  }
+  m = strlen(cp);
+  if (strrchr(cp, '.'))
+  {
+    m = strrchr(cp, '.') - cp;
+  }
+  l = strlen(outputDir);
+  outputFileName = (char *)malloc(
+    l + m + strlen(suffix) + strlen(compressSuffix) + 2);
+  memcpy(outputFileName, outputDir, l);
+  outputFileName[l] = '/';
+  memcpy(&outputFileName[l + 1], cp, m);
+  strcpy(&outputFileName[l + 1 + m], suffix);
+  strcat(&outputFileName[l + 1 + m], compressSuffix);
+
+  return outputFileName;
+}
+
+/**
+ * Check whether any of the options have to look up base classes
+ */
+static int vtkWrapXML_UsesHierarchy(wrapxml_options_t *xmloptions)
+{
+  return (xmloptions->Inheritance || xmloptions->TypeCodes ||
+          (xmloptions->Thunks && xmloptions->ReflectionFile));
+}
+
+/**
+ * Create the index of the hierarchy files that were given with
+ * "--types", or return NULL if there are none or if none of the
+ * options need them.  The files themselves are only read when a base
+ * class is looked up.
+ */
+static WrapXMLHierarchy *vtkWrapXML_NewHierarchy(
+  wrapxml_options_t *xmloptions, OptionInfo *options)
+{
+  if (!vtkWrapXML_UsesHierarchy(xmloptions) ||
+      options->NumberOfHierarchyFileNames == 0)
+  {
+    return NULL;
+  }
+
+  return vtkWrapXMLHierarchy_New(
+    options->NumberOfHierarchyFileNames, options->HierarchyFileNames);
+}
+
+/**
+ * Parse all the headers on the command line and write an XML file
+ * for each one into the output directory, or write all of them to
+ * stdout if the directory is "-".  The headers go through a pipeline:
+ * this thread parses them, a second thread writes their text into
+ * memory, and a third thread writes the files.  The stages overlap,
+ * so that slow file systems do not hold up the parser.  Returns the
+ * number of headers that could not be parsed or written.
+ */
+static int vtkWrapXML_Batch(
+  wrapxml_options_t *xmloptions, WrapXMLArena *arena,
+  WrapXMLManifest *manifest, WrapXMLOutput *reflection,
+  int argc, char *argv[])
+{
+  FILE *ifile;
+  FileInfo *data;
+  OptionInfo *options;
+  wrapxml_batch_t batch;
+  wrapxml_job_t *job;
+  WrapXMLThread *emitter;
+  WrapXMLThread *writer;
+  const char *outputDir;
+  const char *fileName;
+  const char *suffix;
+  const char *compressSuffix;
+  WrapXMLTrace *trace = xmloptions->Trace;
+  double start, parseStart;
+  int errors = 0;
+  int i;
+
+  /* handle args, but don't parse anything yet */
+  vtkParse_MainMulti(argc, argv);
+  options = vtkParse_GetCommandLineOptions();
+  xmloptions->Hierarchy = vtkWrapXML_NewHierarchy(xmloptions, options);
+
+  outputDir = options->OutputFileName;
+  if (outputDir == NULL)
+  {
+    outputDir = ".";
+  }
+  else if (xmloptions->OutputFileName &&
+           strcmp(xmloptions->OutputFileName, "-") == 0)
+  {
+    outputDir = "-";
+  }
+
+  suffix = (xmloptions->JSONLines ? ".jsonl" : ".xml");
+  compressSuffix = vtkWrapXMLOutput_Suffix(xmloptions->Compression);
+
+  /* start the threads, or do all the stages here if that fails */
+  batch.options = xmloptions;
+  batch.arena = arena;
+  batch.manifest = manifest;
+  batch.reflection = reflection;
+  batch.parsed = vtkWrapXMLThreads_NewQueue(WRAPXML_BATCH_QUEUE_SIZE);
+  batch.written = vtkWrapXMLThreads_NewQueue(WRAPXML_BATCH_QUEUE_SIZE);
+  batch.returnedMutex = vtkWrapXMLThreads_NewMutex();
+  batch.returned = NULL;
+  batch.numberOfReturned = 0;
+  batch.maxReturned = 0;
+  batch.errors = 0;
+  batch.bytesWritten = 0;
+
+  emitter = NULL;
+  writer = vtkWrapXMLThreads_Start(vtkWrapXML_WriteStage, &batch);
+  if (writer)
+  {
+    emitter = vtkWrapXMLThreads_Start(vtkWrapXML_EmitStage, &batch);
+    if (!emitter)
+    {
+      vtkWrapXMLThreads_CloseQueue(batch.written);
+      vtkWrapXMLThreads_Join(writer);
+      writer = NULL;
+    }
+  }
+  if (emitter)
+  {
+    vtkWrapXMLTrace_ThreadName(trace, WRAPXML_TRACE_EMITTER, "emitter");
+    vtkWrapXMLTrace_ThreadName(trace, WRAPXML_TRACE_WRITER, "writer");
+  }
+
+  for (i = 0; i < options->NumberOfFiles; i++)
+  {
+    fileName = options->Files[i];
+    start = vtkWrapXMLTrace_Now(trace);
+
+    ifile = fopen(fileName, "r");
+    if (!ifile)
+    {
+      fprintf(stderr, "Error opening input file %s\n", fileName);
+      errors++;
+      continue;
+    }
+
+    /* free the headers that have been written since the last one */
+    vtkWrapXML_FreeReturnedData(&batch);
+
+    /* the parser does the preprocessing as it goes */
+    WRAPXML_ALLOC_PHASE("parse");
+    parseStart = vtkWrapXMLTrace_Now(trace);
+    data = vtkParse_ParseFile(fileName, ifile, stderr);
+    fclose(ifile);
+    vtkWrapXMLTrace_Span(
+      trace, WRAPXML_TRACE_PARSER, "parse", fileName, parseStart);
+
+    if (!data)
+    {
+      errors++;
+      continue;
+    }
+
+    job = (wrapxml_job_t *)malloc(sizeof(wrapxml_job_t));
+    job->data = data;
+    job->fileName = fileName;
+    job->outputFileName = vtkWrapXML_BatchFileName(
+      outputDir, fileName, suffix, compressSuffix);
+    job->memory = NULL;
+
+    if (emitter)
+    {
+      vtkWrapXMLTrace_Span(trace, WRAPXML_TRACE_PARSER,
+        vtkWrapXML_BaseName(fileName), fileName, start);
+      vtkWrapXMLThreads_Push(batch.parsed, job);
+      vtkWrapXML_TraceQueues(&batch);
+    }
+    else
+    {
+      vtkWrapXML_EmitJob(&batch, job, WRAPXML_TRACE_PARSER);
+      vtkWrapXML_WriteJob(&batch, job, WRAPXML_TRACE_PARSER);
+      vtkWrapXMLTrace_Span(trace, WRAPXML_TRACE_PARSER,
+        vtkWrapXML_BaseName(fileName), fileName, start);
+    }
+  }
+
+  /* wait for the other stages to finish */
+  vtkWrapXMLThreads_CloseQueue(batch.parsed);
+  if (emitter)
+  {
+    vtkWrapXMLThreads_Join(emitter);
+    vtkWrapXMLThreads_Join(writer);
+  }
+  vtkWrapXML_FreeReturnedData(&batch);
+  vtkWrapXMLThreads_DeleteMutex(batch.returnedMutex);
+  free(batch.returned);
+  vtkWrapXMLThreads_DeleteQueue(batch.parsed);
+  vtkWrapXMLThreads_DeleteQueue(batch.written);
+
+  return errors + batch.errors;
+}
+
+/**
+ * Check whether two files have the same contents
+ */
+static int vtkWrapXML_SameFiles(const char *file1, const char *file2)
+{
+  const char *data1;
+  const char *data2;
+  size_t size1, size2;
+  int same = 0;
+
+  data1 = vtkWrapXMLSystem_MapFile(file1, &size1);
+  data2 = vtkWrapXMLSystem_MapFile(file2, &size2);
+  if (data1 && data2)
+  {
+    same = (size1 == size2 && memcmp(data1, data2, size1) == 0);
+  }
+  if (data1)
+  {
+    vtkWrapXMLSystem_UnmapFile(data1, size1);
+  }
+  if (data2)
+  {
+    vtkWrapXMLSystem_UnmapFile(data2, size2);
+  }
+
+  return same;
+}
+
+/**
+ * Get the name of the temporary file that is written in place of a
+ * file, so that the file can be left alone if it has not changed.
+ * Returns NULL for stdout.
+ */
+static char *vtkWrapXML_TempName(const char *fileName)
+{
+  char *tempFile;
+  size_t n;
+
+  if (strcmp(fileName, "-") == 0)
+  {
+    return NULL;
+  }
+
+  n = strlen(fileName);
+  tempFile = (char *)malloc(n + 5);
+  memcpy(tempFile, fileName, n);
+  strcpy(&tempFile[n], ".tmp");
+
+  return tempFile;
+}
+
+/**
+ * Replace a file with the temporary file that was written in its place,
+ * unless their contents are the same.  The temporary file is removed,
+ * and its name is freed.  Returns zero on failure.
+ */
+static int vtkWrapXML_ReplaceFile(char *tempFile, const char *fileName)
+{
+  int ok = 1;
+
+  if (vtkWrapXML_SameFiles(tempFile, fileName))
+  {
+    remove(tempFile);
+  }
+  else
+  {
+    /* rename() cannot replace an existing file on Windows */
+    remove(fileName);
+    ok = (rename(tempFile, fileName) == 0);
+  }
+  free(tempFile);
+
+  return ok;
+}
+
+/**
+ * Write the manifest and free it, or exit if it cannot be written.
+ * The file is only replaced if its contents have changed, so that
+ * vtkWrapXMLIndex --update can skip it by checking its timestamp.
+ */
+static void vtkWrapXML_WriteManifest(
+  WrapXMLManifest *manifest, const char *manifestFile)
+{
+  char *tempFile;
+  int ok;
+
+  tempFile = vtkWrapXML_TempName(manifestFile);
+  if (tempFile == NULL)
+  {
+    ok = vtkWrapXMLManifest_Write(manifest, manifestFile);
+  }
+  else
+  {
+    ok = vtkWrapXMLManifest_Write(manifest, tempFile);
+    if (ok)
+    {
+      ok = vtkWrapXML_ReplaceFile(tempFile, manifestFile);
+    }
+    else
+    {
+      free(tempFile);
+    }
+  }
+
+  if (!ok)
+  {
+    fprintf(stderr, "Error writing manifest file %s\n", manifestFile);
+    exit(1);
+  }
+
+  vtkWrapXMLManifest_Free(manifest);
+}
+
+/**
+ * Write the property table and free it, or exit if it cannot be
+ * written.  Like the manifest, the file is only replaced if its
+ * contents have changed.
+ */
+static void vtkWrapXML_WritePropertyTable(
+  WrapXMLPropertyTable *table, const char *tableFile)
+{
+  char *tempFile;
+  int ok;
+
+  tempFile = vtkWrapXML_TempName(tableFile);
+  if (tempFile == NULL)
+  {
+    ok = vtkWrapXMLPropertyTable_Write(table, tableFile);
+  }
+  else
+  {
+    ok = vtkWrapXMLPropertyTable_Write(table, tempFile);
+    if (ok)
+    {
+      ok = vtkWrapXML_ReplaceFile(tempFile, tableFile);
+    }
+    else
+    {
+      free(tempFile);
+    }
+  }
+
+  if (!ok)
+  {
+    fprintf(stderr, "Error writing property table %s\n", tableFile);
+    exit(1);
+  }
+
+  vtkWrapXMLPropertyTable_Free(table);
+}
+
+/**
+ * Open the file for the reflection tables, or exit if it cannot be
+ * opened.  Like the manifest, it is written to a temporary file so
+ * that the file is only replaced if the tables have changed, and the
+ * module that includes it is only recompiled if the API has changed.
+ */
+static WrapXMLOutput *vtkWrapXML_OpenReflection(
+  const char *reflectionFile, char **tempFile)
+{
+  WrapXMLOutput *reflection;
+
+  *tempFile = vtkWrapXML_TempName(reflectionFile);
+  reflection = vtkWrapXMLOutput_Open(
+    (*tempFile ? *tempFile : reflectionFile), VTK_WRAP_XML_COMPRESS_NONE);
+  if (reflection == NULL)
+  {
+    fprintf(stderr, "Error opening reflection file %s\n", reflectionFile);
+    exit(1);
+  }
+
+  return reflection;
+}
+
+/**
+ * Close the file for the reflection tables, or exit on failure
+ */
+static void vtkWrapXML_CloseReflection(
+  WrapXMLOutput *reflection, const char *reflectionFile, char *tempFile)
+{
+  int ok;
+
+  ok = vtkWrapXMLOutput_Close(reflection);
+  if (ok && tempFile)
+  {
+    ok = vtkWrapXML_ReplaceFile(tempFile, reflectionFile);
+  }
+  else
+  {
+    free(tempFile);
+  }
+
+  if (!ok)
+  {
+    fprintf(stderr, "Error writing reflection file %s\n", reflectionFile);
+    exit(1);
+  }
+}
+
+/**
+ * Print the memory use, for checking that batch jobs do not grow,
+ * and the number of hierarchy files that had to be read.  The counts
+ * of the allocations are printed if they were kept.
+ */
+static void vtkWrapXML_PrintStats(
+  WrapXMLArena *arena, WrapXMLHierarchy *hierarchy)
+{
+  fprintf(stderr,
+          "vtkWrapXML: peak RSS %lu KiB, "
+          "arena high-water %lu KiB, arena reserved %lu KiB\n",
+          (unsigned long)(vtkWrapXMLSystem_PeakMemory()/1024),
+          (unsigned long)(arena->HighWater/1024),
+          (unsigned long)(arena->Reserved/1024));
+  if (hierarchy)
+  {
+    fprintf(stderr,
+            "vtkWrapXML: read %d of %d hierarchy files\n",
+            hierarchy->NumberOfLoadedFiles, hierarchy->NumberOfFiles);
+  }
+#ifdef VTK_WRAP_XML_ALLOCATION_STATS
+  vtkWrapXMLAlloc_Report(stderr);
+#endif
+}
+
+/**
+ * Create the file for the timeline, and name the threads in it
+ */
+static void vtkWrapXML_OpenTrace(wrapxml_options_t *options)
+{
+  char name[32];
+  int i;
+
+  options->Trace = vtkWrapXMLTrace_Open(options->TraceFile);
+  if (!options->Trace)
+  {
+    fprintf(stderr, "Error opening trace file %s\n", options->TraceFile);
+    exit(1);
+  }
+
+  vtkWrapXMLTrace_ThreadName(options->Trace, WRAPXML_TRACE_PARSER,
+    (options->Batch ? "parser" : "main"));
+  for (i = 1; i < options->ClassThreads; i++)
+  {
+    sprintf(name, "classes %d", i);
+    vtkWrapXMLTrace_ThreadName(
+      options->Trace, WRAPXML_TRACE_CLASSES + i, name);
+  }
+}
+
+/**
+ * Finish the timeline, returns zero if it could not be written
+ */
+static int vtkWrapXML_CloseTrace(wrapxml_options_t *options)
+{
+  if (options->Trace && !vtkWrapXMLTrace_Close(options->Trace))
+  {
+    fprintf(stderr, "Error writing trace file %s\n", options->TraceFile);
+    return 0;
+  }
+
+  return 1;
+}
+
+int main(int argc, char *argv[])
+{
+  FileInfo *data;
+  OptionInfo *options;
+  wrapxml_options_t xmloptions;
+  WrapXMLCache *cache;
+  WrapXMLArena *arena;
+  WrapXMLManifest *manifest;
+  WrapXMLOutput *reflection;
+  char *reflectionTemp;
+  uint64_t key;
+  const char *outputFileName;
+  double start, fileStart;
+  int rval = 0;
+
+  /* handle the options that vtkParse_Main() doesn't know about */
+  argc = vtkWrapXML_ParseOptions(&xmloptions, argc, argv);
+
+  /* convert a macros file into a snapshot, and do nothing else */
+  if (xmloptions.WriteMacrosFile)
+  {
+    if (argc != 2)
+    {
+      fprintf(stderr,
+              "Usage: vtkWrapXML --write-macros <snapshot> <macros.h>\n");
+      exit(1);
+    }
+    return !vtkWrapXMLMacros_WriteSnapshot(
+      argv[1], xmloptions.WriteMacrosFile);
+  }
+
+  if (xmloptions.Batch && xmloptions.ParseCacheFile)
+  {
+    fprintf(stderr, "vtkWrapXML: --parse-cache cannot be used with --batch\n");
+    exit(1);
+  }
+
+  /* the timeline of the run */
+  if (xmloptions.TraceFile)
+  {
+    vtkWrapXML_OpenTrace(&xmloptions);
+  }
+
+  /* pre-define a macro to identify the language */
+  vtkParse_DefineMacro("__VTK_WRAP_XML__", 0);
+
+  /* pre-define the macros from a snapshot, in place of -imacros */
+  WRAPXML_ALLOC_PHASE("preprocess");
+  start = vtkWrapXMLTrace_Now(xmloptions.Trace);
+  fileStart = start;
+  if (xmloptions.MacrosFile &&
+      vtkWrapXMLMacros_LoadSnapshot(xmloptions.MacrosFile) < 0)
+  {
+    fprintf(stderr, "Error reading macros snapshot %s\n",
+            xmloptions.MacrosFile);
+    exit(1);
+  }
+  vtkWrapXMLTrace_Span(
+    xmloptions.Trace, WRAPXML_TRACE_PARSER, "preprocess", NULL, start);
+
+  if (xmloptions.ManifestFile && xmloptions.JSONLines)
+  {
+    fprintf(stderr, "vtkWrapXML: --manifest requires the xml format\n");
+    exit(1);
+  }
+
+  if (xmloptions.Thunks && !xmloptions.ReflectionFile)
+  {
+    fprintf(stderr, "vtkWrapXML: --thunks requires --reflection\n");
+    exit(1);
+  }
+
+  /* the memory for everything that is created while writing a file */
+  arena = vtkWrapXMLArena_New();
+
+  /* the list of classes, with the location of each in the output */
+  manifest = NULL;
+  if (xmloptions.ManifestFile)
+  {
+    manifest = vtkWrapXMLManifest_New();
+  }
+
+  /* the properties of all the headers go into one table */
+  if (xmloptions.PropertyTableFile)
+  {
+    xmloptions.PropertyTable = vtkWrapXMLPropertyTable_New();
+  }
+
+  /* the reflection tables for all the headers go into one file */
+  reflection = NULL;
+  reflectionTemp = NULL;
+  if (xmloptions.ReflectionFile)
+  {
+    reflection = vtkWrapXML_OpenReflection(
+      xmloptions.ReflectionFile, &reflectionTemp);
+  }
+
+  if (xmloptions.Batch)
+  {
+    rval = (vtkWrapXML_Batch(
+      &xmloptions, arena, manifest, reflection, argc, argv) != 0);
+    WRAPXML_ALLOC_PHASE("finish");
+    if (manifest)
+    {
+      vtkWrapXML_WriteManifest(manifest, xmloptions.ManifestFile);
+    }
+    if (xmloptions.PropertyTable)
+    {
+      vtkWrapXML_WritePropertyTable(
+        xmloptions.PropertyTable, xmloptions.PropertyTableFile);
+    }
+    if (reflection)
+    {
+      vtkWrapXML_CloseReflection(
+        reflection, xmloptions.ReflectionFile, reflectionTemp);
+    }
+    if (xmloptions.Stats)
+    {
+      vtkWrapXML_PrintStats(arena, xmloptions.Hierarchy);
+    }
+    if (xmloptions.Hierarchy)
+    {
+      vtkWrapXMLHierarchy_Free(xmloptions.Hierarchy);
+    }
+    if (!vtkWrapXML_CloseTrace(&xmloptions))
+    {
+      rval = 1;
+    }
+    vtkWrapXMLArena_Delete(arena);
+    return rval;
+  }
+
+  /* load the results of a previous parse, if they are up-to-date */
+  cache = NULL;
+  key = 0;
+  if (xmloptions.ParseCacheFile)
+  {
+    WRAPXML_ALLOC_PHASE("load cache");
+    start = vtkWrapXMLTrace_Now(xmloptions.Trace);
+    key = vtkWrapXMLCache_Key(argc, argv);
+    if (xmloptions.MacrosFile)
+    {
+      key = vtkWrapXMLCache_KeyFile(key, xmloptions.MacrosFile);
+    }
+    if (xmloptions.OutputFileName)
+    {
+      cache = vtkWrapXMLCache_Load(xmloptions.ParseCacheFile, key);
+    }
+    vtkWrapXMLTrace_Span(xmloptions.Trace, WRAPXML_TRACE_PARSER,
+      "load cache", xmloptions.ParseCacheFile, start);
+  }
+
+  if (cache)
+  {
+    data = cache->Data;
+    outputFileName = xmloptions.OutputFileName;
+
+    /* the args must still be read, for the hierarchy files */
+    if (vtkWrapXML_UsesHierarchy(&xmloptions))
+    {
+      vtkParse_MainMulti(argc, argv);
+    }
+  }
+  else
+  {
+    /* handle args, parse header, the parser preprocesses as it goes */
+    WRAPXML_ALLOC_PHASE("parse");
+    start = vtkWrapXMLTrace_Now(xmloptions.Trace);
+    data = vtkParse_Main(argc, argv);
+    vtkWrapXMLTrace_Span(xmloptions.Trace, WRAPXML_TRACE_PARSER,
+      "parse", data->FileName, start);
+
+    /* get the command-line options */
+    options = vtkParse_GetCommandLineOptions();
+    outputFileName = options->OutputFileName;
+    if (xmloptions.OutputFileName &&
+        strcmp(xmloptions.OutputFileName, "-") == 0)
+    {
+      outputFileName = "-";
+    }
+
+    /* save the parse results for the next time */
+    if (xmloptions.ParseCacheFile)
+    {
+      cache = vtkWrapXMLCache_Create(data);
+      vtkWrapXMLCache_Write(
+        cache, xmloptions.ParseCacheFile, key, options->DepFileName);
+    }
+  }
+
+  xmloptions.Hierarchy =
+    vtkWrapXML_NewHierarchy(&xmloptions, vtkParse_GetCommandLineOptions());
+
+  vtkWrapXML_WriteFile(
+    &xmloptions, data, cache, arena, manifest, reflection, outputFileName);
+  WRAPXML_ALLOC_PHASE("finish");
+  vtkWrapXMLTrace_Span(xmloptions.Trace, WRAPXML_TRACE_PARSER,
+    vtkWrapXML_BaseName(data->FileName), data->FileName, fileStart);
+
+  if (manifest)
+  {
+    vtkWrapXML_WriteManifest(manifest, xmloptions.ManifestFile);
+  }
+
+  if (xmloptions.PropertyTable)
+  {
+    vtkWrapXML_WritePropertyTable(
+      xmloptions.PropertyTable, xmloptions.PropertyTableFile);
+  }
+
+  if (reflection)
+  {
+    vtkWrapXML_CloseReflection(
+      reflection, xmloptions.ReflectionFile, reflectionTemp);
+  }
+
+  if (xmloptions.Stats)
+  {
+    vtkWrapXML_PrintStats(arena, xmloptions.Hierarchy);
+  }
+
+  if (xmloptions.Hierarchy)
+  {
+    vtkWrapXMLHierarchy_Free(xmloptions.Hierarchy);
+  }
+
+  if (!vtkWrapXML_CloseTrace(&xmloptions))
+  {
+    rval = 1;
+  }
+
+  if (cache == NULL || !cache->IsLoaded)
+  {
+    vtkParse_Free(data);
+  }
+  if (cache)
+  {
+    vtkWrapXMLCache_Free(cache);
+  }
+  vtkWrapXMLArena_Delete(arena);
 
-  return 0;
+  return rval;
 }
@@ -0,0 +1,467 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLAlloc.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/* this file calls the real malloc and free */
+#define VTK_WRAP_XML_ALLOC_IMPLEMENTATION
+
+#include "vtkWrapXMLAlloc.h"
+
+#ifdef VTK_WRAP_XML_ALLOCATION_STATS
+
+#include "vtkWrapXMLThreads.h"
+#include <string.h>
+
+#if defined(_MSC_VER)
+#define ALLOC_THREAD_LOCAL __declspec(thread)
+#else
+#define ALLOC_THREAD_LOCAL __thread
+#endif
+
+/* the most phases that are kept apart, the rest go into "other" */
+#define MAX_PHASES 16
+
+/* the most call sites that are printed */
+#define MAX_REPORTED_SITES 25
+
+/* the counts for a call site or a phase */
+typedef struct _alloc_count
+{
+  unsigned long count; /* the number of allocations */
+  size_t bytes; /* the total size of the allocations */
+  size_t live; /* the bytes that have not been freed */
+  size_t peak; /* the highest that "live" has been */
+} alloc_count_t;
+
+/* a call site */
+typedef struct _alloc_site
+{
+  const char *file;
+  int line;
+  alloc_count_t counts;
+} alloc_site_t;
+
+/* a block that has not been freed */
+typedef struct _alloc_block
+{
+  void *ptr; /* the block, or NULL if the slot is empty */
+  size_t size;
+  int site;
+  int phase;
+} alloc_block_t;
+
+/* the phase of each thread */
+static ALLOC_THREAD_LOCAL const char *currentPhase = NULL;
+
+/* everything below is protected by the mutex */
+static WrapXMLMutex *allocMutex = NULL;
+
+static int numberOfPhases = 0;
+static const char *phaseNames[MAX_PHASES];
+static alloc_count_t phaseCounts[MAX_PHASES];
+
+static unsigned int siteSlots = 0; /* a power of two */
+static int numberOfSites = 0;
+static int *siteTable = NULL; /* one plus the site for each slot */
+static alloc_site_t *sites = NULL;
+
+static unsigned int blockSlots = 0; /* a power of two */
+static unsigned int numberOfBlocks = 0;
+static alloc_block_t *blocks = NULL;
+
+/*-------------------------------------------------------------------
+ * hash functions for the tables */
+
+static unsigned int siteHash(const char *file, int line)
+{
+  unsigned int h = 2166136261u ^ (unsigned int)line;
+
+  while (*file)
+  {
+    h = (h ^ (unsigned char)*file++)*16777619u;
+  }
+
+  return h;
+}
+
+static unsigned int blockHash(const void *ptr)
+{
+  size_t h = (size_t)ptr;
+
+  h ^= h >> 17;
+  h *= (size_t)0x9e3779b9u;
+  h ^= h >> 13;
+
+  return (unsigned int)h;
+}
+
+/*-------------------------------------------------------------------
+ * add an allocation to a count */
+
+static void countAdd(alloc_count_t *c, size_t n)
+{
+  c->count++;
+  c->bytes += n;
+  c->live += n;
+  if (c->live > c->peak)
+  {
+    c->peak = c->live;
+  }
+}
+
+/*-------------------------------------------------------------------
+ * find the phase of this thread, or add it */
+
+static int findPhase(void)
+{
+  const char *name = (currentPhase ? currentPhase : "other");
+  int i;
+
+  for (;;)
+  {
+    for (i = 0; i < numberOfPhases; i++)
+    {
+      if (strcmp(phaseNames[i], name) == 0)
+      {
+        return i;
+      }
+    }
+    if (numberOfPhases < MAX_PHASES - 1 || strcmp(name, "other") == 0)
+    {
+      break;
+    }
+    /* the last slot is kept for "other" */
+    name = "other";
+  }
+
+  phaseNames[numberOfPhases] = name;
+  return numberOfPhases++;
+}
+
+/*-------------------------------------------------------------------
+ * find a call site, or add it */
+
+static int findSite(const char *file, int line)
+{
+  alloc_site_t *oldSites;
+  unsigned int i;
+  int j;
+
+  if ((unsigned int)(2*(numberOfSites + 1)) >= siteSlots)
+  {
+    /* grow the table, the sites keep their numbers */
+    siteSlots = (siteSlots == 0 ? 256 : 2*siteSlots);
+    free(siteTable);
+    siteTable = (int *)calloc(siteSlots, sizeof(int));
+    oldSites = sites;
+    sites = (alloc_site_t *)malloc(siteSlots*sizeof(alloc_site_t));
+    if (numberOfSites > 0)
+    {
+      memcpy(sites, oldSites, numberOfSites*sizeof(alloc_site_t));
+    }
+    free(oldSites);
+    for (j = 0; j < numberOfSites; j++)
+    {
+      i = siteHash(sites[j].file, sites[j].line) & (siteSlots - 1);
+      while (siteTable[i])
+      {
+        i = (i + 1) & (siteSlots - 1);
+      }
+      siteTable[i] = j + 1;
+    }
+  }
+
+  i = siteHash(file, line) & (siteSlots - 1);
+  while ((j = siteTable[i]) != 0)
+  {
+    if (sites[j-1].line == line &&
+        (sites[j-1].file == file || strcmp(sites[j-1].file, file) == 0))
+    {
+      return j - 1;
+    }
+    i = (i + 1) & (siteSlots - 1);
+  }
+
+  j = numberOfSites++;
+  sites[j].file = file;
+  sites[j].line = line;
+  memset(&sites[j].counts, 0, sizeof(alloc_count_t));
+  siteTable[i] = j + 1;
+
+  return j;
+}
+
+/*-------------------------------------------------------------------
+ * remove a block from the table, if it is there */
+
+static void removeBlock(void *ptr)
+{
+  unsigned int i, j, k;
+
+  if (blockSlots == 0)
+  {
+    return;
+  }
+
+  i = blockHash(ptr) & (blockSlots - 1);
+  while (blocks[i].ptr != ptr)
+  {
+    if (blocks[i].ptr == NULL)
+    {
+      /* not allocated here */
+      return;
+    }
+    i = (i + 1) & (blockSlots - 1);
+  }
+
+  sites[blocks[i].site].counts.live -= blocks[i].size;
+  phaseCounts[blocks[i].phase].live -= blocks[i].size;
+  numberOfBlocks--;
+
+  /* move later blocks back, so that no probe sequence is broken */
+  j = i;
+  for (;;)
+  {
+    blocks[i].ptr = NULL;
+    for (;;)
+    {
+      j = (j + 1) & (blockSlots - 1);
+      if (blocks[j].ptr == NULL)
+      {
+        return;
+      }
+      k = blockHash(blocks[j].ptr) & (blockSlots - 1);
+      /* move the block unless its home k is cyclically in (i, j] */
+      if (i <= j ? (i >= k || k > j) : (i >= k && k > j))
+      {
+        break;
+      }
+    }
+    blocks[i] = blocks[j];
+    i = j;
+  }
+}
+
+/*-------------------------------------------------------------------
+ * add a block to the table of live blocks */
+
+static void addBlock(void *ptr, size_t size, int site, int phase)
+{
+  alloc_block_t *oldBlocks;
+  unsigned int oldSlots, i, k;
+
+  if (2*(numberOfBlocks + 1) >= blockSlots)
+  {
+    oldBlocks = blocks;
+    oldSlots = blockSlots;
+    blockSlots = (blockSlots == 0 ? 4096 : 2*blockSlots);
+    blocks = (alloc_block_t *)calloc(blockSlots, sizeof(alloc_block_t));
+    for (k = 0; k < oldSlots; k++)
+    {
+      if (oldBlocks[k].ptr)
+      {
+        i = blockHash(oldBlocks[k].ptr) & (blockSlots - 1);
+        while (blocks[i].ptr)
+        {
+          i = (i + 1) & (blockSlots - 1);
+        }
+        blocks[i] = oldBlocks[k];
+      }
+    }
+    free(oldBlocks);
+  }
+
+  /* a block that was given to the parser and freed by it is still in
+   * the table, so it is removed when the memory is allocated again */
+  removeBlock(ptr);
+
+  i = blockHash(ptr) & (blockSlots - 1);
+  while (blocks[i].ptr)
+  {
+    i = (i + 1) & (blockSlots - 1);
+  }
+  blocks[i].ptr = ptr;
+  blocks[i].size = size;
+  blocks[i].site = site;
+  blocks[i].phase = phase;
+  numberOfBlocks++;
+
+  countAdd(&sites[site].counts, size);
+  countAdd(&phaseCounts[phase], size);
+}
+
+/*-------------------------------------------------------------------
+ * the mutex is created on the first allocation, which is done before
+ * any threads are started */
+
+static void allocLock(void)
+{
+  if (allocMutex == NULL)
+  {
+    allocMutex = vtkWrapXMLThreads_NewMutex();
+  }
+  vtkWrapXMLThreads_Lock(allocMutex);
+}
+
+static void allocUnlock(void)
+{
+  vtkWrapXMLThreads_Unlock(allocMutex);
+}
+
+/*-------------------------------------------------------------------
+ * the allocation functions */
+
+void *vtkWrapXMLAlloc_Malloc(size_t n, const char *file, int line)
+{
+  void *ptr = malloc(n);
+
+  if (ptr)
+  {
+    allocLock();
+    addBlock(ptr, n, findSite(file, line), findPhase());
+    allocUnlock();
+  }
+
+  return ptr;
+}
+
+void *vtkWrapXMLAlloc_Calloc(
+  size_t m, size_t n, const char *file, int line)
+{
+  void *ptr = calloc(m, n);
+
+  if (ptr)
+  {
+    allocLock();
+    addBlock(ptr, m*n, findSite(file, line), findPhase());
+    allocUnlock();
+  }
+
+  return ptr;
+}
+
+void *vtkWrapXMLAlloc_Realloc(
+  void *ptr, size_t n, const char *file, int line)
+{
+  void *newPtr;
+
+  /* remove the block first, since realloc might free it */
+  allocLock();
+  if (ptr)
+  {
+    removeBlock(ptr);
+  }
+  allocUnlock();
+
+  newPtr = realloc(ptr, n);
+
+  if (newPtr)
+  {
+    allocLock();
+    addBlock(newPtr, n, findSite(file, line), findPhase());
+    allocUnlock();
+  }
+
+  return newPtr;
+}
+
+void vtkWrapXMLAlloc_Free(void *ptr)
+{
+  if (ptr)
+  {
+    allocLock();
+    removeBlock(ptr);
+    allocUnlock();
+    free(ptr);
+  }
+}
+
+/*-------------------------------------------------------------------
+ * set the phase of this thread */
+
+void vtkWrapXMLAlloc_SetPhase(const char *phase)
+{
+  currentPhase = phase;
+}
+
+/*-------------------------------------------------------------------
+ * print the counts */
+
+static int compareSites(const void *a, const void *b)
+{
+  const alloc_site_t *s1 = *(const alloc_site_t **)a;
+  const alloc_site_t *s2 = *(const alloc_site_t **)b;
+
+  if (s1->counts.count != s2->counts.count)
+  {
+    return (s1->counts.count > s2->counts.count ? -1 : 1);
+  }
+  return (s1->counts.bytes > s2->counts.bytes ? -1 :
+          s1->counts.bytes < s2->counts.bytes);
+}
+
+static void printCount(FILE *fp, const char *name, const alloc_count_t *c)
+{
+  fprintf(fp, "  %-32s %10lu %12lu %12lu\n", name, c->count,
+          (unsigned long)c->bytes, (unsigned long)c->peak);
+}
+
+void vtkWrapXMLAlloc_Report(FILE *fp)
+{
+  alloc_site_t **sorted;
+  const char *cp;
+  char name[40];
+  int i, n;
+
+  allocLock();
+
+  fprintf(fp, "vtkWrapXML: allocations by phase\n");
+  fprintf(fp, "  %-32s %10s %12s %12s\n",
+          "phase", "count", "bytes", "peak live");
+  for (i = 0; i < numberOfPhases; i++)
+  {
+    printCount(fp, phaseNames[i], &phaseCounts[i]);
+  }
+
+  sorted = (alloc_site_t **)malloc(
+    (numberOfSites + 1)*sizeof(alloc_site_t *));
+  for (i = 0; i < numberOfSites; i++)
+  {
+    sorted[i] = &sites[i];
+  }
+  qsort(sorted, numberOfSites, sizeof(alloc_site_t *), compareSites);
+
+  n = (numberOfSites < MAX_REPORTED_SITES ?
+       numberOfSites : MAX_REPORTED_SITES);
+  fprintf(fp, "vtkWrapXML: allocations by call site, %d of %d sites\n",
+          n, numberOfSites);
+  fprintf(fp, "  %-32s %10s %12s %12s\n",
+          "site", "count", "bytes", "peak live");
+  for (i = 0; i < n; i++)
+  {
+    /* the file name without the directory */
+    cp = sorted[i]->file + strlen(sorted[i]->file);
+    while (cp != sorted[i]->file && cp[-1] != '/' && cp[-1] != '\\')
+    {
+      cp--;
+    }
+    sprintf(name, "%.30s:%d", cp, sorted[i]->line);
+    printCount(fp, name, &sorted[i]->counts);
+  }
+
+  free(sorted);
+
+  allocUnlock();
+}
+
+#endif
@@ -0,0 +1,83 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLAlloc.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file counts the allocations that are done by vtkWrapXML, for
+ * finding the places where many small blocks are allocated.  It is
+ * only used if VTK_WRAP_XML_ALLOCATION_STATS is defined, which is done
+ * by the WRAPVTK_ALLOCATION_STATS option in CMake, otherwise it does
+ * nothing.
+ *
+ * A source file is counted by including this header after all of the
+ * system headers.  It replaces malloc, calloc, realloc, and free with
+ * functions that keep a count, the total bytes, and the peak live bytes
+ * for each call site and for each phase of the work.  The phase is set
+ * separately for each thread.  Blocks that were allocated elsewhere,
+ * for example by the parser, are freed as usual and are not counted.
+ */
+
+#ifndef VTK_WRAP_XML_ALLOC_H
+#define VTK_WRAP_XML_ALLOC_H
+
+#ifdef VTK_WRAP_XML_ALLOCATION_STATS
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Allocation functions that record the call site
+ */
+void *vtkWrapXMLAlloc_Malloc(size_t n, const char *file, int line);
+void *vtkWrapXMLAlloc_Calloc(
+  size_t m, size_t n, const char *file, int line);
+void *vtkWrapXMLAlloc_Realloc(
+  void *ptr, size_t n, const char *file, int line);
+void vtkWrapXMLAlloc_Free(void *ptr);
+
+/**
+ * Set the phase for the allocations that are done by this thread.
+ * The name must be a string constant.
+ */
+void vtkWrapXMLAlloc_SetPhase(const char *phase);
+
+/**
+ * Print the counts for each phase, and for the call sites that did
+ * the most allocations
+ */
+void vtkWrapXMLAlloc_Report(FILE *fp);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#ifndef VTK_WRAP_XML_ALLOC_IMPLEMENTATION
+#define malloc(n) vtkWrapXMLAlloc_Malloc((n), __FILE__, __LINE__)
+#define calloc(m, n) vtkWrapXMLAlloc_Calloc((m), (n), __FILE__, __LINE__)
+#define realloc(p, n) vtkWrapXMLAlloc_Realloc((p), (n), __FILE__, __LINE__)
+#define free(p) vtkWrapXMLAlloc_Free(p)
+#endif
+
+#define WRAPXML_ALLOC_PHASE(phase) vtkWrapXMLAlloc_SetPhase(phase)
+
+#else
+
+#define WRAPXML_ALLOC_PHASE(phase)
+
+#endif
+
+#endif
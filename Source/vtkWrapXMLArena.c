@@ -0,0 +1,159 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLArena.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLArena.h"
+#include <stdlib.h>
+#include <string.h>
+
+#include "vtkWrapXMLAlloc.h"
+
+/* the usual size of a block, larger allocations get their own block */
+#define ARENA_BLOCK_SIZE 65536
+
+/* the alignment of all allocations */
+#define ARENA_ALIGN 16
+
+/* the size of the block header, rounded up to the alignment */
+#define ARENA_HEADER_SIZE \
+  ((sizeof(WrapXMLArenaBlock) + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1))
+
+/*-------------------------------------------------------------------
+ * create a new arena */
+
+WrapXMLArena *vtkWrapXMLArena_New(void)
+{
+  return (WrapXMLArena *)calloc(1, sizeof(WrapXMLArena));
+}
+
+/*-------------------------------------------------------------------
+ * add a new block after the current block */
+
+static WrapXMLArenaBlock *newBlock(WrapXMLArena *arena, size_t n)
+{
+  WrapXMLArenaBlock *block;
+  size_t m = (n > ARENA_BLOCK_SIZE ? n : ARENA_BLOCK_SIZE);
+
+  block = (WrapXMLArenaBlock *)malloc(ARENA_HEADER_SIZE + m);
+  block->Size = m;
+  block->Used = 0;
+
+  if (arena->Current)
+  {
+    block->Next = arena->Current->Next;
+    arena->Current->Next = block;
+  }
+  else
+  {
+    block->Next = arena->First;
+    arena->First = block;
+  }
+
+  arena->Reserved += m;
+
+  return block;
+}
+
+/*-------------------------------------------------------------------
+ * allocate zeroed memory */
+
+void *vtkWrapXMLArena_Alloc(WrapXMLArena *arena, size_t n)
+{
+  WrapXMLArenaBlock *block = arena->Current;
+  char *cp;
+
+  n = (n + ARENA_ALIGN - 1) & ~(size_t)(ARENA_ALIGN - 1);
+  if (n == 0)
+  {
+    n = ARENA_ALIGN;
+  }
+
+  if (block == NULL || block->Size - block->Used < n)
+  {
+    /* reuse the next block if it is big enough, else make a new one */
+    if (block && block->Next && block->Next->Size >= n)
+    {
+      block = block->Next;
+      block->Used = 0;
+    }
+    else
+    {
+      block = newBlock(arena, n);
+    }
+    arena->Current = block;
+  }
+
+  cp = (char *)block + ARENA_HEADER_SIZE + block->Used;
+  block->Used += n;
+
+  arena->InUse += n;
+  if (arena->InUse > arena->HighWater)
+  {
+    arena->HighWater = arena->InUse;
+  }
+
+  memset(cp, 0, n);
+
+  return cp;
+}
+
+/*-------------------------------------------------------------------
+ * copy a string into the arena */
+
+char *vtkWrapXMLArena_StringCopy(WrapXMLArena *arena, const char *text)
+{
+  char *cp;
+  size_t n;
+
+  if (text == NULL)
+  {
+    return NULL;
+  }
+
+  n = strlen(text);
+  cp = (char *)vtkWrapXMLArena_Alloc(arena, n + 1);
+  memcpy(cp, text, n);
+
+  return cp;
+}
+
+/*-------------------------------------------------------------------
+ * release all allocations, the blocks are kept and are marked as
+ * empty when the allocator reaches them */
+
+void vtkWrapXMLArena_Reset(WrapXMLArena *arena)
+{
+  arena->Current = arena->First;
+  if (arena->First)
+  {
+    arena->First->Used = 0;
+  }
+  arena->InUse = 0;
+}
+
+/*-------------------------------------------------------------------
+ * free the arena */
+
+void vtkWrapXMLArena_Delete(WrapXMLArena *arena)
+{
+  WrapXMLArenaBlock *block;
+
+  while (arena->First)
+  {
+    block = arena->First;
+    arena->First = block->Next;
+    free(block);
+  }
+
+  free(arena);
+}
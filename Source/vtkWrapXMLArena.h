@@ -0,0 +1,85 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLArena.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file provides an arena allocator for the data that vtkWrapXML
+ * creates while it writes the XML for one header.  Nothing is freed
+ * individually, instead the whole arena is reset when the header is
+ * done.  The reset keeps the memory blocks, so that when many headers
+ * are wrapped by one process, the same memory is used for each header.
+ */
+
+#ifndef VTK_WRAP_XML_ARENA_H
+#define VTK_WRAP_XML_ARENA_H
+
+#include <stddef.h>
+
+/**
+ * A block of memory in the arena
+ */
+typedef struct _WrapXMLArenaBlock
+{
+  struct _WrapXMLArenaBlock *Next;  /* the next block in the arena */
+  size_t                     Size;  /* the usable size of the block */
+  size_t                     Used;  /* the number of bytes in use */
+} WrapXMLArenaBlock;
+
+/**
+ * The arena, which is a list of blocks
+ */
+typedef struct _WrapXMLArena
+{
+  WrapXMLArenaBlock *First;      /* the first block */
+  WrapXMLArenaBlock *Current;    /* the block that is being filled */
+  size_t             InUse;      /* bytes allocated since the last reset */
+  size_t             HighWater;  /* the largest value of InUse */
+  size_t             Reserved;   /* the total size of all blocks */
+} WrapXMLArena;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Create a new, empty arena
+ */
+WrapXMLArena *vtkWrapXMLArena_New(void);
+
+/**
+ * Allocate zeroed memory from the arena.  The memory is aligned for
+ * any of the types that are used by the parser.
+ */
+void *vtkWrapXMLArena_Alloc(WrapXMLArena *arena, size_t n);
+
+/**
+ * Copy a string into the arena.  A NULL string gives NULL.
+ */
+char *vtkWrapXMLArena_StringCopy(WrapXMLArena *arena, const char *text);
+
+/**
+ * Release everything that was allocated from the arena, but keep the
+ * memory blocks for reuse.  This takes constant time.
+ */
+void vtkWrapXMLArena_Reset(WrapXMLArena *arena);
+
+/**
+ * Free the arena and all of its memory blocks
+ */
+void vtkWrapXMLArena_Delete(WrapXMLArena *arena);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
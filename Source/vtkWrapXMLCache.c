@@ -0,0 +1,1123 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLCache.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLCache.h"
+#include "vtkWrapXMLArena.h"
+#include "vtkWrapXMLHash.h"
+#include "vtkWrapXMLSystem.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "vtkWrapXMLAlloc.h"
+
+/*-------------------------------------------------------------------
+ * The cache file starts with a magic string, the byte order, the
+ * format version, and the key.  This is followed by the list of
+ * dependencies with their timestamps, then the FileInfo, and then
+ * the ClassProperties for each class.  All integers are stored in
+ * native byte order, since a cache is never shared between machines.
+ * Strings are stored with their terminator, so that the loaded data
+ * can point directly into the mapped file. */
+
+#define CACHE_MAGIC "vtkxcach"
+#define CACHE_BYTEORDER 0x01020304
+#define CACHE_VERSION 1
+
+/*-------------------------------------------------------------------
+ * Memory for loaded data, which is all freed at once */
+
+typedef struct _CacheStorage
+{
+  const char *Map;         /* the mapped cache file */
+  size_t MapSize;          /* the size of the mapped file */
+  WrapXMLArena *Arena;     /* memory for the loaded structs */
+} CacheStorage;
+
+static void storageFree(CacheStorage *storage)
+{
+  if (storage->Arena)
+  {
+    vtkWrapXMLArena_Delete(storage->Arena);
+  }
+
+  vtkWrapXMLSystem_UnmapFile(storage->Map, storage->MapSize);
+  free(storage);
+}
+
+/*-------------------------------------------------------------------
+ * Writing to a memory buffer */
+
+typedef struct _CacheWriter
+{
+  char *Buffer;
+  size_t Size;
+  size_t MaxSize;
+} CacheWriter;
+
+static void writeBytes(CacheWriter *writer, const void *data, size_t n)
+{
+  if (writer->Size + n > writer->MaxSize)
+  {
+    writer->MaxSize = 2*(writer->Size + n);
+    writer->Buffer = (char *)realloc(writer->Buffer, writer->MaxSize);
+  }
+
+  memcpy(&writer->Buffer[writer->Size], data, n);
+  writer->Size += n;
+}
+
+static void writeInt(CacheWriter *writer, int value)
+{
+  writeBytes(writer, &value, sizeof(int));
+}
+
+static void writeString(CacheWriter *writer, const char *text)
+{
+  int n = (text ? (int)strlen(text) + 1 : 0);
+
+  writeInt(writer, n);
+  if (n)
+  {
+    writeBytes(writer, text, n);
+  }
+}
+
+/*-------------------------------------------------------------------
+ * Reading from the mapped file */
+
+typedef struct _CacheReader
+{
+  const char *Data;
+  size_t Size;
+  size_t Position;
+  int Error;
+  CacheStorage *Storage;
+} CacheReader;
+
+static void readBytes(CacheReader *reader, void *data, size_t n)
+{
+  if (reader->Error || reader->Size - reader->Position < n)
+  {
+    reader->Error = 1;
+    memset(data, 0, n);
+    return;
+  }
+
+  memcpy(data, &reader->Data[reader->Position], n);
+  reader->Position += n;
+}
+
+static int readInt(CacheReader *reader)
+{
+  int value;
+
+  readBytes(reader, &value, sizeof(int));
+
+  return value;
+}
+
+/* read a count, which is also used to size an allocation */
+static int readCount(CacheReader *reader)
+{
+  int n = readInt(reader);
+
+  if (n < 0 || (size_t)n > reader->Size)
+  {
+    reader->Error = 1;
+    n = 0;
+  }
+
+  return n;
+}
+
+static const char *readString(CacheReader *reader)
+{
+  const char *text;
+  int n = readCount(reader);
+
+  if (n == 0 || reader->Error)
+  {
+    return NULL;
+  }
+
+  if (reader->Size - reader->Position < (size_t)n ||
+      reader->Data[reader->Position + n - 1] != '\0')
+  {
+    reader->Error = 1;
+    return NULL;
+  }
+
+  text = &reader->Data[reader->Position];
+  reader->Position += n;
+
+  return text;
+}
+
+static void *readAlloc(CacheReader *reader, size_t n)
+{
+  return vtkWrapXMLArena_Alloc(reader->Storage->Arena, n);
+}
+
+/*-------------------------------------------------------------------
+ * Write the parse data */
+
+static void writeValue(CacheWriter *writer, ValueInfo *val);
+static void writeFunction(CacheWriter *writer, FunctionInfo *func);
+static void writeClass(CacheWriter *writer, ClassInfo *data);
+
+static void writeTemplate(CacheWriter *writer, TemplateInfo *info)
+{
+  int i;
+
+  writeInt(writer, (info != NULL));
+  if (info)
+  {
+    writeInt(writer, info->NumberOfParameters);
+    for (i = 0; i < info->NumberOfParameters; i++)
+    {
+      writeValue(writer, info->Parameters[i]);
+    }
+  }
+}
+
+static void writeValue(CacheWriter *writer, ValueInfo *val)
+{
+  int i;
+
+  writeInt(writer, (val != NULL));
+  if (val)
+  {
+    writeInt(writer, val->ItemType);
+    writeInt(writer, val->Access);
+    writeString(writer, val->Name);
+    writeString(writer, val->Comment);
+    writeString(writer, val->Value);
+    writeInt(writer, (int)val->Type);
+    writeString(writer, val->Class);
+    writeInt(writer, val->Count);
+    writeString(writer, val->CountHint);
+    writeInt(writer, val->NumberOfDimensions);
+    for (i = 0; i < val->NumberOfDimensions; i++)
+    {
+      writeString(writer, val->Dimensions[i]);
+    }
+    writeInt(writer, (val->Function != NULL));
+    if (val->Function)
+    {
+      writeFunction(writer, val->Function);
+    }
+    writeTemplate(writer, val->Template);
+    writeInt(writer, val->IsStatic);
+    writeInt(writer, val->IsEnum);
+    writeInt(writer, val->IsPack);
+    writeInt(writer, (int)val->Attributes);
+  }
+}
+
+static void writeFunction(CacheWriter *writer, FunctionInfo *func)
+{
+  int i;
+
+  writeInt(writer, func->ItemType);
+  writeInt(writer, func->Access);
+  writeString(writer, func->Name);
+  writeString(writer, func->Comment);
+  writeString(writer, func->Class);
+  writeString(writer, func->Signature);
+  writeTemplate(writer, func->Template);
+  writeInt(writer, func->NumberOfParameters);
+  for (i = 0; i < func->NumberOfParameters; i++)
+  {
+    writeValue(writer, func->Parameters[i]);
+  }
+  writeValue(writer, func->ReturnValue);
+  writeInt(writer, func->NumberOfPreconds);
+  for (i = 0; i < func->NumberOfPreconds; i++)
+  {
+    writeString(writer, func->Preconds[i]);
+  }
+  writeString(writer, func->Macro);
+  writeString(writer, func->SizeHint);
+  writeInt(writer, func->IsOperator);
+  writeInt(writer, func->IsVariadic);
+  writeInt(writer, func->IsLegacy);
+  writeInt(writer, func->IsExcluded);
+  writeInt(writer, func->IsStatic);
+  writeInt(writer, func->IsVirtual);
+  writeInt(writer, func->IsPureVirtual);
+  writeInt(writer, func->IsConst);
+  writeInt(writer, func->IsDeleted);
+  writeInt(writer, func->IsFinal);
+  writeInt(writer, func->IsOverride);
+  writeInt(writer, func->IsExplicit);
+}
+
+static void writeUsing(CacheWriter *writer, UsingInfo *item)
+{
+  writeInt(writer, item->ItemType);
+  writeInt(writer, item->Access);
+  writeString(writer, item->Name);
+  writeString(writer, item->Comment);
+  writeString(writer, item->Scope);
+}
+
+/* write a class, struct, union, enum, or namespace */
+static void writeClass(CacheWriter *writer, ClassInfo *data)
+{
+  int i;
+
+  writeInt(writer, data->ItemType);
+  writeInt(writer, data->Access);
+  writeString(writer, data->Name);
+  writeString(writer, data->Comment);
+  writeTemplate(writer, data->Template);
+
+  writeInt(writer, data->NumberOfSuperClasses);
+  for (i = 0; i < data->NumberOfSuperClasses; i++)
+  {
+    writeString(writer, data->SuperClasses[i]);
+  }
+
+  writeInt(writer, data->NumberOfItems);
+  for (i = 0; i < data->NumberOfItems; i++)
+  {
+    writeInt(writer, data->Items[i].Type);
+    writeInt(writer, data->Items[i].Index);
+  }
+
+  writeInt(writer, data->NumberOfClasses);
+  for (i = 0; i < data->NumberOfClasses; i++)
+  {
+    writeClass(writer, data->Classes[i]);
+  }
+
+  writeInt(writer, data->NumberOfFunctions);
+  for (i = 0; i < data->NumberOfFunctions; i++)
+  {
+    writeFunction(writer, data->Functions[i]);
+  }
+
+  writeInt(writer, data->NumberOfConstants);
+  for (i = 0; i < data->NumberOfConstants; i++)
+  {
+    writeValue(writer, data->Constants[i]);
+  }
+
+  writeInt(writer, data->NumberOfVariables);
+  for (i = 0; i < data->NumberOfVariables; i++)
+  {
+    writeValue(writer, data->Variables[i]);
+  }
+
+  writeInt(writer, data->NumberOfEnums);
+  for (i = 0; i < data->NumberOfEnums; i++)
+  {
+    writeClass(writer, data->Enums[i]);
+  }
+
+  writeInt(writer, data->NumberOfTypedefs);
+  for (i = 0; i < data->NumberOfTypedefs; i++)
+  {
+    writeValue(writer, data->Typedefs[i]);
+  }
+
+  writeInt(writer, data->NumberOfUsings);
+  for (i = 0; i < data->NumberOfUsings; i++)
+  {
+    writeUsing(writer, data->Usings[i]);
+  }
+
+  writeInt(writer, data->NumberOfNamespaces);
+  for (i = 0; i < data->NumberOfNamespaces; i++)
+  {
+    writeClass(writer, data->Namespaces[i]);
+  }
+
+  writeInt(writer, data->IsAbstract);
+  writeInt(writer, data->IsFinal);
+  writeInt(writer, data->HasDelete);
+  writeInt(writer, data->IsExcluded);
+}
+
+static void writeProperties(CacheWriter *writer, ClassProperties *properties)
+{
+  PropertyInfo *property;
+  int i, j, n;
+
+  writeInt(writer, properties->NumberOfProperties);
+  for (i = 0; i < properties->NumberOfProperties; i++)
+  {
+    property = properties->Properties[i];
+    writeString(writer, property->Name);
+    writeInt(writer, (int)property->Type);
+    writeInt(writer, property->Count);
+    writeString(writer, property->ClassName);
+    n = 0;
+    if (property->EnumConstantNames)
+    {
+      while (property->EnumConstantNames[n]) { n++; }
+    }
+    writeInt(writer, (property->EnumConstantNames ? n + 1 : 0));
+    for (j = 0; j < n; j++)
+    {
+      writeString(writer, property->EnumConstantNames[j]);
+    }
+    writeInt(writer, (int)property->PublicMethods);
+    writeInt(writer, (int)property->ProtectedMethods);
+    writeInt(writer, (int)property->PrivateMethods);
+    writeInt(writer, (int)property->LegacyMethods);
+    writeString(writer, property->Comment);
+    writeInt(writer, property->IsStatic);
+  }
+
+  writeInt(writer, properties->NumberOfMethods);
+  for (i = 0; i < properties->NumberOfMethods; i++)
+  {
+    writeInt(writer, (int)properties->MethodTypes[i]);
+    writeInt(writer, properties->MethodHasProperty[i]);
+    writeInt(writer, properties->MethodProperties[i]);
+  }
+}
+
+/*-------------------------------------------------------------------
+ * Read the parse data */
+
+static ValueInfo *readValue(CacheReader *reader);
+static FunctionInfo *readFunction(CacheReader *reader);
+static ClassInfo *readClass(CacheReader *reader);
+
+static TemplateInfo *readTemplate(CacheReader *reader)
+{
+  TemplateInfo *info;
+  int i;
+
+  if (!readInt(reader) || reader->Error)
+  {
+    return NULL;
+  }
+
+  info = (TemplateInfo *)readAlloc(reader, sizeof(TemplateInfo));
+  info->NumberOfParameters = readCount(reader);
+  info->Parameters = (ValueInfo **)readAlloc(
+    reader, sizeof(ValueInfo *)*info->NumberOfParameters);
+  for (i = 0; i < info->NumberOfParameters; i++)
+  {
+    info->Parameters[i] = readValue(reader);
+  }
+
+  return info;
+}
+
+static ValueInfo *readValue(CacheReader *reader)
+{
+  ValueInfo *val;
+  int i;
+
+  if (!readInt(reader) || reader->Error)
+  {
+    return NULL;
+  }
+
+  val = (ValueInfo *)readAlloc(reader, sizeof(ValueInfo));
+  val->ItemType = (parse_item_t)readInt(reader);
+  val->Access = (parse_access_t)readInt(reader);
+  val->Name = readString(reader);
+  val->Comment = readString(reader);
+  val->Value = readString(reader);
+  val->Type = (unsigned int)readInt(reader);
+  val->Class = readString(reader);
+  val->Count = readInt(reader);
+  val->CountHint = readString(reader);
+  val->NumberOfDimensions = readCount(reader);
+  val->Dimensions = (const char **)readAlloc(
+    reader, sizeof(char *)*val->NumberOfDimensions);
+  for (i = 0; i < val->NumberOfDimensions; i++)
+  {
+    val->Dimensions[i] = readString(reader);
+  }
+  if (readInt(reader) && !reader->Error)
+  {
+    val->Function = readFunction(reader);
+  }
+  val->Template = readTemplate(reader);
+  val->IsStatic = readInt(reader);
+  val->IsEnum = readInt(reader);
+  val->IsPack = readInt(reader);
+  val->Attributes = (unsigned int)readInt(reader);
+
+  return val;
+}
+
+static FunctionInfo *readFunction(CacheReader *reader)
+{
+  FunctionInfo *func;
+  int i;
+
+  func = (FunctionInfo *)readAlloc(reader, sizeof(FunctionInfo));
+  func->ItemType = (parse_item_t)readInt(reader);
+  func->Access = (parse_access_t)readInt(reader);
+  func->Name = readString(reader);
+  func->Comment = readString(reader);
+  func->Class = readString(reader);
+  func->Signature = readString(reader);
+  func->Template = readTemplate(reader);
+  func->NumberOfParameters = readCount(reader);
+  func->Parameters = (ValueInfo **)readAlloc(
+    reader, sizeof(ValueInfo *)*func->NumberOfParameters);
+  for (i = 0; i < func->NumberOfParameters; i++)
+  {
+    func->Parameters[i] = readValue(reader);
+  }
+  func->ReturnValue = readValue(reader);
+  func->NumberOfPreconds = readCount(reader);
+  func->Preconds = (const char **)readAlloc(
+    reader, sizeof(char *)*func->NumberOfPreconds);
+  for (i = 0; i < func->NumberOfPreconds; i++)
+  {
+    func->Preconds[i] = readString(reader);
+  }
+  func->Macro = readString(reader);
+  func->SizeHint = readString(reader);
+  func->IsOperator = readInt(reader);
+  func->IsVariadic = readInt(reader);
+  func->IsLegacy = readInt(reader);
+  func->IsExcluded = readInt(reader);
+  func->IsStatic = readInt(reader);
+  func->IsVirtual = readInt(reader);
+  func->IsPureVirtual = readInt(reader);
+  func->IsConst = readInt(reader);
+  func->IsDeleted = readInt(reader);
+  func->IsFinal = readInt(reader);
+  func->IsOverride = readInt(reader);
+  func->IsExplicit = readInt(reader);
+
+  return func;
+}
+
+static UsingInfo *readUsing(CacheReader *reader)
+{
+  UsingInfo *item;
+
+  item = (UsingInfo *)readAlloc(reader, sizeof(UsingInfo));
+  item->ItemType = (parse_item_t)readInt(reader);
+  item->Access = (parse_access_t)readInt(reader);
+  item->Name = readString(reader);
+  item->Comment = readString(reader);
+  item->Scope = readString(reader);
+
+  return item;
+}
+
+static ClassInfo *readClass(CacheReader *reader)
+{
+  ClassInfo *data;
+  int i;
+
+  data = (ClassInfo *)readAlloc(reader, sizeof(ClassInfo));
+  data->ItemType = (parse_item_t)readInt(reader);
+  data->Access = (parse_access_t)readInt(reader);
+  data->Name = readString(reader);
+  data->Comment = readString(reader);
+  data->Template = readTemplate(reader);
+
+  data->NumberOfSuperClasses = readCount(reader);
+  data->SuperClasses = (const char **)readAlloc(
+    reader, sizeof(char *)*data->NumberOfSuperClasses);
+  for (i = 0; i < data->NumberOfSuperClasses; i++)
+  {
+    data->SuperClasses[i] = readString(reader);
+  }
+
+  data->NumberOfItems = readCount(reader);
+  data->Items = (ItemInfo *)readAlloc(
+    reader, sizeof(ItemInfo)*data->NumberOfItems);
+  for (i = 0; i < data->NumberOfItems; i++)
+  {
+    data->Items[i].Type = (parse_item_t)readInt(reader);
+    data->Items[i].Index = readInt(reader);
+  }
+
+  data->NumberOfClasses = readCount(reader);
+  data->Classes = (ClassInfo **)readAlloc(
+    reader, sizeof(ClassInfo *)*data->NumberOfClasses);
+  for (i = 0; i < data->NumberOfClasses && !reader->Error; i++)
+  {
+    data->Classes[i] = readClass(reader);
+  }
+
+  data->NumberOfFunctions = readCount(reader);
+  data->Functions = (FunctionInfo **)readAlloc(
+    reader, sizeof(FunctionInfo *)*data->NumberOfFunctions);
+  for (i = 0; i < data->NumberOfFunctions && !reader->Error; i++)
+  {
+    data->Functions[i] = readFunction(reader);
+  }
+
+  data->NumberOfConstants = readCount(reader);
+  data->Constants = (ValueInfo **)readAlloc(
+    reader, sizeof(ValueInfo *)*data->NumberOfConstants);
+  for (i = 0; i < data->NumberOfConstants; i++)
+  {
+    data->Constants[i] = readValue(reader);
+  }
+
+  data->NumberOfVariables = readCount(reader);
+  data->Variables = (ValueInfo **)readAlloc(
+    reader, sizeof(ValueInfo *)*data->NumberOfVariables);
+  for (i = 0; i < data->NumberOfVariables; i++)
+  {
+    data->Variables[i] = readValue(reader);
+  }
+
+  data->NumberOfEnums = readCount(reader);
+  data->Enums = (EnumInfo **)readAlloc(
+    reader, sizeof(EnumInfo *)*data->NumberOfEnums);
+  for (i = 0; i < data->NumberOfEnums && !reader->Error; i++)
+  {
+    data->Enums[i] = readClass(reader);
+  }
+
+  data->NumberOfTypedefs = readCount(reader);
+  data->Typedefs = (ValueInfo **)readAlloc(
+    reader, sizeof(ValueInfo *)*data->NumberOfTypedefs);
+  for (i = 0; i < data->NumberOfTypedefs; i++)
+  {
+    data->Typedefs[i] = readValue(reader);
+  }
+
+  data->NumberOfUsings = readCount(reader);
+  data->Usings = (UsingInfo **)readAlloc(
+    reader, sizeof(UsingInfo *)*data->NumberOfUsings);
+  for (i = 0; i < data->NumberOfUsings && !reader->Error; i++)
+  {
+    data->Usings[i] = readUsing(reader);
+  }
+
+  data->NumberOfNamespaces = readCount(reader);
+  data->Namespaces = (NamespaceInfo **)readAlloc(
+    reader, sizeof(NamespaceInfo *)*data->NumberOfNamespaces);
+  for (i = 0; i < data->NumberOfNamespaces && !reader->Error; i++)
+  {
+    data->Namespaces[i] = readClass(reader);
+  }
+
+  data->IsAbstract = readInt(reader);
+  data->IsFinal = readInt(reader);
+  data->HasDelete = readInt(reader);
+  data->IsExcluded = readInt(reader);
+
+  return data;
+}
+
+static ClassProperties *readProperties(CacheReader *reader)
+{
+  ClassProperties *properties;
+  PropertyInfo *property;
+  int i, j, n;
+
+  properties = (ClassProperties *)readAlloc(reader, sizeof(ClassProperties));
+  properties->NumberOfProperties = readCount(reader);
+  properties->Properties = (PropertyInfo **)readAlloc(
+    reader, sizeof(PropertyInfo *)*properties->NumberOfProperties);
+  for (i = 0; i < properties->NumberOfProperties && !reader->Error; i++)
+  {
+    property = (PropertyInfo *)readAlloc(reader, sizeof(PropertyInfo));
+    properties->Properties[i] = property;
+    property->Name = readString(reader);
+    property->Type = (unsigned int)readInt(reader);
+    property->Count = readInt(reader);
+    property->ClassName = readString(reader);
+    n = readCount(reader);
+    if (n > 0)
+    {
+      property->EnumConstantNames = (const char **)readAlloc(
+        reader, sizeof(char *)*n);
+      for (j = 0; j < n - 1; j++)
+      {
+        property->EnumConstantNames[j] = readString(reader);
+      }
+      property->EnumConstantNames[n - 1] = NULL;
+    }
+    property->PublicMethods = (unsigned int)readInt(reader);
+    property->ProtectedMethods = (unsigned int)readInt(reader);
+    property->PrivateMethods = (unsigned int)readInt(reader);
+    property->LegacyMethods = (unsigned int)readInt(reader);
+    property->Comment = readString(reader);
+    property->IsStatic = readInt(reader);
+  }
+
+  n = readCount(reader);
+  properties->NumberOfMethods = n;
+  properties->MethodTypes = (unsigned int *)readAlloc(
+    reader, sizeof(unsigned int)*n);
+  properties->MethodHasProperty = (int *)readAlloc(reader, sizeof(int)*n);
+  properties->MethodProperties = (int *)readAlloc(reader, sizeof(int)*n);
+  for (i = 0; i < n; i++)
+  {
+    properties->MethodTypes[i] = (unsigned int)readInt(reader);
+    properties->MethodHasProperty[i] = readInt(reader);
+    properties->MethodProperties[i] = readInt(reader);
+  }
+
+  return properties;
+}
+
+/*-------------------------------------------------------------------
+ * Collect all classes in depth-first order */
+
+static void collectClasses(WrapXMLCache *cache, ClassInfo *scope, int *max)
+{
+  int i;
+
+  for (i = 0; i < scope->NumberOfClasses; i++)
+  {
+    if (cache->NumberOfClasses == *max)
+    {
+      *max = (*max == 0 ? 8 : 2*(*max));
+      cache->Classes = (ClassInfo **)realloc(
+        cache->Classes, sizeof(ClassInfo *)*(*max));
+    }
+    cache->Classes[cache->NumberOfClasses++] = scope->Classes[i];
+    collectClasses(cache, scope->Classes[i], max);
+  }
+
+  for (i = 0; i < scope->NumberOfNamespaces; i++)
+  {
+    collectClasses(cache, scope->Namespaces[i], max);
+  }
+}
+
+/*-------------------------------------------------------------------
+ * Read the dependencies from a make-style depfile, which has the form
+ * "output: dep1 dep2 \" with backslash-escaped spaces in filenames */
+
+static char **readDepFile(const char *depFile, int *count)
+{
+  const char *text;
+  size_t size, i;
+  char **deps = NULL;
+  char *dep;
+  size_t n;
+  int max = 0;
+
+  *count = 0;
+
+  text = vtkWrapXMLSystem_MapFile(depFile, &size);
+  if (text == NULL)
+  {
+    return NULL;
+  }
+
+  /* skip the target, e.g. "output:", but not a drive letter "C:\" */
+  for (i = 0; i < size; i++)
+  {
+    if (text[i] == ':' &&
+        (i + 1 == size || text[i+1] == ' ' || text[i+1] == '\t' ||
+         text[i+1] == '\r' || text[i+1] == '\n'))
+    {
+      i++;
+      break;
+    }
+  }
+
+  dep = (char *)malloc(size + 1);
+
+  while (i < size)
+  {
+    /* skip whitespace and line continuations */
+    while (i < size &&
+           (text[i] == ' ' || text[i] == '\t' || text[i] == '\r' ||
+            text[i] == '\n' ||
+            (text[i] == '\\' && i + 1 < size &&
+             (text[i+1] == '\n' || text[i+1] == '\r'))))
+    {
+      i++;
+    }
+
+    n = 0;
+    while (i < size && text[i] != ' ' && text[i] != '\t' &&
+           text[i] != '\r' && text[i] != '\n')
+    {
+      if (text[i] == '\\' && i + 1 < size &&
+          (text[i+1] == ' ' || text[i+1] == '#'))
+      {
+        i++;
+      }
+      else if (text[i] == '\\' && i + 1 < size &&
+               (text[i+1] == '\n' || text[i+1] == '\r'))
+      {
+        break;
+      }
+      else if (text[i] == '$' && i + 1 < size && text[i+1] == '$')
+      {
+        i++;
+      }
+      dep[n++] = text[i++];
+    }
+
+    if (n > 0)
+    {
+      if (*count == max)
+      {
+        max = (max == 0 ? 64 : 2*max);
+        deps = (char **)realloc(deps, sizeof(char *)*max);
+      }
+      deps[*count] = (char *)malloc(n + 1);
+      memcpy(deps[*count], dep, n);
+      deps[*count][n] = '\0';
+      (*count)++;
+    }
+  }
+
+  free(dep);
+  vtkWrapXMLSystem_UnmapFile(text, size);
+
+  return deps;
+}
+
+/*-------------------------------------------------------------------
+ * Compute the key from the parser arguments and the input files */
+
+uint64_t vtkWrapXMLCache_Key(int argc, char *argv[])
+{
+  uint64_t h = VTK_WRAP_XML_HASH_INIT;
+  int i;
+
+  h = vtkWrapXMLHash_Int(h, CACHE_VERSION);
+
+  for (i = 1; i < argc; i++)
+  {
+    /* the output files don't affect the parse */
+    if (strcmp(argv[i], "-o") == 0 || strcmp(argv[i], "-MF") == 0)
+    {
+      i++;
+      continue;
+    }
+
+    h = vtkWrapXMLHash_String(h, argv[i]);
+
+    /* the hierarchy files are not used by the parser */
+    if (strcmp(argv[i], "--types") == 0 && i + 1 < argc)
+    {
+      h = vtkWrapXMLHash_String(h, argv[++i]);
+    }
+    else if (argv[i][0] == '@')
+    {
+      h = vtkWrapXMLCache_KeyFile(h, &argv[i][1]);
+    }
+    else if (argv[i][0] != '-')
+    {
+      h = vtkWrapXMLCache_KeyFile(h, argv[i]);
+    }
+  }
+
+  return h;
+}
+
+/*-------------------------------------------------------------------
+ * Add the contents of a file to the key */
+
+uint64_t vtkWrapXMLCache_KeyFile(uint64_t key, const char *filename)
+{
+  const char *text;
+  size_t size;
+
+  text = vtkWrapXMLSystem_MapFile(filename, &size);
+  if (text)
+  {
+    key = vtkWrapXMLHash_Bytes(key, text, size);
+    vtkWrapXMLSystem_UnmapFile(text, size);
+  }
+  else
+  {
+    key = vtkWrapXMLHash_String(key, NULL);
+  }
+
+  return key;
+}
+
+/*-------------------------------------------------------------------
+ * Create the cache from parsed data */
+
+WrapXMLCache *vtkWrapXMLCache_Create(FileInfo *data)
+{
+  WrapXMLCache *cache;
+  int max = 0;
+  int i;
+
+  cache = (WrapXMLCache *)calloc(1, sizeof(WrapXMLCache));
+  cache->Data = data;
+  cache->IsLoaded = 0;
+
+  collectClasses(cache, data->Contents, &max);
+
+  cache->Properties = (ClassProperties **)malloc(
+    sizeof(ClassProperties *)*(cache->NumberOfClasses + 1));
+  for (i = 0; i < cache->NumberOfClasses; i++)
+  {
+    cache->Properties[i] = vtkParseProperties_Create(cache->Classes[i]);
+  }
+
+  return cache;
+}
+
+/*-------------------------------------------------------------------
+ * Write the cache to a file */
+
+int vtkWrapXMLCache_Write(
+  WrapXMLCache *cache, const char *cacheFile, uint64_t key,
+  const char *depFile)
+{
+  CacheWriter writer = { NULL, 0, 0 };
+  FileInfo *data = cache->Data;
+  char **deps = NULL;
+  int ndeps = 0;
+  long long stamp[2];
+  FILE *fp;
+  int mainClass;
+  int i;
+  int ok = 1;
+
+  writeBytes(&writer, CACHE_MAGIC, 8);
+  writeInt(&writer, CACHE_BYTEORDER);
+  writeInt(&writer, CACHE_VERSION);
+  writeBytes(&writer, &key, sizeof(key));
+
+  /* the timestamps of the dependencies, which might have changed
+   * even if the header itself has not */
+  if (depFile)
+  {
+    deps = readDepFile(depFile, &ndeps);
+  }
+  writeInt(&writer, ndeps);
+  for (i = 0; i < ndeps; i++)
+  {
+    if (!vtkWrapXMLSystem_FileStamp(deps[i], &stamp[0], &stamp[1]))
+    {
+      stamp[0] = -1;
+      stamp[1] = -1;
+    }
+    writeString(&writer, deps[i]);
+    writeBytes(&writer, stamp, sizeof(stamp));
+    free(deps[i]);
+  }
+  free(deps);
+
+  writeString(&writer, data->FileName);
+  writeString(&writer, data->NameComment);
+  writeString(&writer, data->Description);
+  writeString(&writer, data->Caveats);
+  writeString(&writer, data->SeeAlso);
+  writeClass(&writer, data->Contents);
+
+  mainClass = -1;
+  for (i = 0; i < data->Contents->NumberOfClasses; i++)
+  {
+    if (data->Contents->Classes[i] == data->MainClass)
+    {
+      mainClass = i;
+    }
+  }
+  writeInt(&writer, mainClass);
+
+  writeInt(&writer, cache->NumberOfClasses);
+  for (i = 0; i < cache->NumberOfClasses; i++)
+  {
+    writeProperties(&writer, cache->Properties[i]);
+  }
+
+  fp = fopen(cacheFile, "wb");
+  if (!fp)
+  {
+    fprintf(stderr, "Error opening cache file %s\n", cacheFile);
+    free(writer.Buffer);
+    return 0;
+  }
+
+  if (fwrite(writer.Buffer, 1, writer.Size, fp) != writer.Size)
+  {
+    fprintf(stderr, "Error writing cache file %s\n", cacheFile);
+    ok = 0;
+  }
+
+  fclose(fp);
+  free(writer.Buffer);
+
+  /* never leave a partial cache file behind */
+  if (!ok)
+  {
+    remove(cacheFile);
+  }
+
+  return ok;
+}
+
+/*-------------------------------------------------------------------
+ * Load the cache from a file */
+
+WrapXMLCache *vtkWrapXMLCache_Load(const char *cacheFile, uint64_t key)
+{
+  CacheReader reader;
+  CacheStorage *storage;
+  WrapXMLCache *cache;
+  FileInfo *data;
+  char magic[8];
+  uint64_t filekey;
+  long long stamp[2];
+  long long newstamp[2];
+  const char *dep;
+  int mainClass;
+  int ndeps;
+  int i;
+
+  storage = (CacheStorage *)calloc(1, sizeof(CacheStorage));
+  storage->Map = vtkWrapXMLSystem_MapFile(cacheFile, &storage->MapSize);
+  if (storage->Map == NULL)
+  {
+    free(storage);
+    return NULL;
+  }
+
+  storage->Arena = vtkWrapXMLArena_New();
+
+  reader.Data = storage->Map;
+  reader.Size = storage->MapSize;
+  reader.Position = 0;
+  reader.Error = 0;
+  reader.Storage = storage;
+
+  readBytes(&reader, magic, 8);
+  if (reader.Error || strncmp(magic, CACHE_MAGIC, 8) != 0 ||
+      readInt(&reader) != CACHE_BYTEORDER ||
+      readInt(&reader) != CACHE_VERSION)
+  {
+    storageFree(storage);
+    return NULL;
+  }
+
+  readBytes(&reader, &filekey, sizeof(filekey));
+  if (reader.Error || filekey != key)
+  {
+    storageFree(storage);
+    return NULL;
+  }
+
+  ndeps = readCount(&reader);
+  for (i = 0; i < ndeps && !reader.Error; i++)
+  {
+    dep = readString(&reader);
+    readBytes(&reader, stamp, sizeof(stamp));
+    if (reader.Error || dep == NULL ||
+        !vtkWrapXMLSystem_FileStamp(dep, &newstamp[0], &newstamp[1]) ||
+        newstamp[0] != stamp[0] || newstamp[1] != stamp[1])
+    {
+      storageFree(storage);
+      return NULL;
+    }
+  }
+
+  data = (FileInfo *)readAlloc(&reader, sizeof(FileInfo));
+  data->FileName = readString(&reader);
+  data->NameComment = readString(&reader);
+  data->Description = readString(&reader);
+  data->Caveats = readString(&reader);
+  data->SeeAlso = readString(&reader);
+  data->Contents = readClass(&reader);
+  mainClass = readInt(&reader);
+  if (!reader.Error && mainClass >= 0 &&
+      mainClass < data->Contents->NumberOfClasses)
+  {
+    data->MainClass = data->Contents->Classes[mainClass];
+  }
+
+  cache = (WrapXMLCache *)calloc(1, sizeof(WrapXMLCache));
+  cache->Data = data;
+  cache->IsLoaded = 1;
+  cache->Storage = storage;
+
+  if (!reader.Error)
+  {
+    i = 0;
+    collectClasses(cache, data->Contents, &i);
+    if (readInt(&reader) != cache->NumberOfClasses)
+    {
+      reader.Error = 1;
+    }
+  }
+
+  if (!reader.Error)
+  {
+    cache->Properties = (ClassProperties **)malloc(
+      sizeof(ClassProperties *)*(cache->NumberOfClasses + 1));
+    for (i = 0; i < cache->NumberOfClasses; i++)
+    {
+      cache->Properties[i] = readProperties(&reader);
+    }
+  }
+
+  if (reader.Error)
+  {
+    fprintf(stderr, "Warning: ignoring corrupt cache file %s\n", cacheFile);
+    vtkWrapXMLCache_Free(cache);
+    return NULL;
+  }
+
+  return cache;
+}
+
+/*-------------------------------------------------------------------
+ * Get the properties for a class */
+
+ClassProperties *vtkWrapXMLCache_GetProperties(
+  WrapXMLCache *cache, ClassInfo *classInfo)
+{
+  int i;
+
+  for (i = 0; i < cache->NumberOfClasses; i++)
+  {
+    if (cache->Classes[i] == classInfo)
+    {
+      return cache->Properties[i];
+    }
+  }
+
+  return NULL;
+}
+
+/*-------------------------------------------------------------------
+ * Free the cache */
+
+void vtkWrapXMLCache_Free(WrapXMLCache *cache)
+{
+  int i;
+
+  if (cache->Properties && !cache->IsLoaded)
+  {
+    for (i = 0; i < cache->NumberOfClasses; i++)
+    {
+      vtkParseProperties_Free(cache->Properties[i]);
+    }
+  }
+
+  free(cache->Properties);
+  free(cache->Classes);
+
+  if (cache->Storage)
+  {
+    storageFree((CacheStorage *)cache->Storage);
+  }
+
+  free(cache);
+}
@@ -0,0 +1,102 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLCache.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file contains methods for saving the parsed FileInfo, and the
+ * ClassProperties for each of its classes, to a compact binary file.
+ * When a header is wrapped again with different output options, the
+ * cache file can be loaded instead of parsing the header.
+ *
+ * A cache file is only used if its key matches, i.e. if the parser
+ * arguments and input files are the same as when it was written, and
+ * if none of the dependencies listed in the depfile have changed.
+ */
+
+#ifndef VTK_WRAP_XML_CACHE_H
+#define VTK_WRAP_XML_CACHE_H
+
+#include "vtkParseData.h"
+#include "vtkParseProperties.h"
+#include <stdint.h>
+
+/**
+ * The parsed data for a file, and the properties of its classes
+ */
+typedef struct _WrapXMLCache
+{
+  FileInfo          *Data;             /* the parsed file */
+  int                NumberOfClasses;  /* classes, depth-first order */
+  ClassInfo        **Classes;          /* all classes in the file */
+  ClassProperties  **Properties;       /* properties for each class */
+  int                IsLoaded;         /* Data was read from a cache */
+  void              *Storage;          /* memory for the loaded data */
+} WrapXMLCache;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Compute the cache key from the arguments that will be given to
+ * vtkParse_Main().  The key includes the contents of the header,
+ * of any "@" argument files, and of any other input files.
+ */
+uint64_t vtkWrapXMLCache_Key(int argc, char *argv[]);
+
+/**
+ * Add the contents of a file to the key, e.g. for a file that is used
+ * by the parser but that is not given in the arguments.
+ */
+uint64_t vtkWrapXMLCache_KeyFile(uint64_t key, const char *filename);
+
+/**
+ * Create a cache from data that was just parsed.  The properties
+ * of all classes are computed, but the FileInfo is still owned by
+ * the caller and must be freed with vtkParse_Free().
+ */
+WrapXMLCache *vtkWrapXMLCache_Create(FileInfo *data);
+
+/**
+ * Write the cache to a file.  If depFile is not NULL, then the
+ * dependencies listed in it will be checked when the cache is loaded.
+ * Returns zero on failure.
+ */
+int vtkWrapXMLCache_Write(
+  WrapXMLCache *cache, const char *cacheFile, uint64_t key,
+  const char *depFile);
+
+/**
+ * Load a cache file.  Returns NULL if the file does not exist, or if
+ * it is out of date with respect to the key or the dependencies.
+ */
+WrapXMLCache *vtkWrapXMLCache_Load(const char *cacheFile, uint64_t key);
+
+/**
+ * Get the properties of a class, or NULL if the class is not cached.
+ * The properties belong to the cache and must not be freed.
+ */
+ClassProperties *vtkWrapXMLCache_GetProperties(
+  WrapXMLCache *cache, ClassInfo *classInfo);
+
+/**
+ * Free the cache.  If the data was loaded from a cache file, then
+ * the FileInfo is freed, too.
+ */
+void vtkWrapXMLCache_Free(WrapXMLCache *cache);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,793 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLCxx.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLCxx.h"
+#include "vtkParseProperties.h"
+#include "vtkParseType.h"
+#include "vtkWrapXMLPerfectHash.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*-------------------------------------------------------------------
+ * The state of the writer */
+
+typedef struct _wrapcxx_state
+{
+  WrapXMLOutput *file; /* the file being written to */
+  WrapXMLArena *arena; /* memory that is released after each file */
+  WrapXMLSignatures *signatures; /* signatures that have been rendered */
+  WrapXMLFingerprints *fingerprints; /* the API of each class */
+  int thunks; /* write the accessor thunks */
+  WrapXMLHierarchy *hierarchy; /* for base classes in other headers */
+  NamespaceInfo *contents; /* the classes of the header */
+} wrapcxx_state_t;
+
+/* the kinds of values that thunks can be written for */
+#define CXX_VALUE_NONE 0
+#define CXX_VALUE_NUMBER 1
+#define CXX_VALUE_ARRAY 2
+#define CXX_VALUE_STRING 3
+#define CXX_VALUE_OBJECT 4
+
+/* set for each property that has a getter or a setter */
+#define CXX_HAS_GET 0x1
+#define CXX_HAS_SET 0x2
+
+/*-------------------------------------------------------------------
+ * write a string as a C++ string literal, or as nullptr if the string
+ * is NULL, octal escapes have three digits so they cannot run on */
+
+static void cxxString(wrapcxx_state_t *w, const char *text)
+{
+  const char *cp;
+  const char *escape;
+  char temp[8];
+
+  if (text == NULL)
+  {
+    vtkWrapXMLOutput_Puts(w->file, "nullptr");
+    return;
+  }
+
+  vtkWrapXMLOutput_Putc(w->file, '\"');
+  for (cp = text; *cp != '\0'; cp++)
+  {
+    switch (*cp)
+    {
+      case '\"':
+        escape = "\\\"";
+        break;
+      case '\\':
+        escape = "\\\\";
+        break;
+      case '?':
+        /* avoid trigraphs */
+        escape = "\\?";
+        break;
+      default:
+        if ((unsigned char)*cp >= 0x20 && (unsigned char)*cp < 0x7f)
+        {
+          continue;
+        }
+        sprintf(temp, "\\%03o", (unsigned int)(unsigned char)*cp);
+        escape = temp;
+        break;
+    }
+
+    vtkWrapXMLOutput_Write(w->file, text, cp - text);
+    vtkWrapXMLOutput_Puts(w->file, escape);
+    text = cp + 1;
+  }
+  vtkWrapXMLOutput_Write(w->file, text, cp - text);
+  vtkWrapXMLOutput_Putc(w->file, '\"');
+}
+
+/*-------------------------------------------------------------------
+ * check whether a function is a method that should be listed, this
+ * matches the methods that are written to the XML */
+
+static int cxxIsMethod(ClassInfo *data, FunctionInfo *func)
+{
+  if (func->Access != VTK_ACCESS_PUBLIC || func->IsDeleted ||
+      func->Name == NULL)
+  {
+    return 0;
+  }
+
+  /* eliminate macros masquerading as class methods */
+  if (!func->ReturnValue && strcmp(data->Name, func->Name) != 0 &&
+      !(func->Name[0] == '~' && strcmp(data->Name, &func->Name[1]) == 0))
+  {
+    return 0;
+  }
+
+  return 1;
+}
+
+/*-------------------------------------------------------------------
+ * get the kind of value that a property has, for the thunks */
+
+static int cxxValueKind(PropertyInfo *property)
+{
+  unsigned int baseType = (property->Type & VTK_PARSE_BASE_TYPE);
+  unsigned int indirection = (property->Type & VTK_PARSE_INDIRECT);
+
+  if (property->IsStatic || property->ClassName == NULL)
+  {
+    return CXX_VALUE_NONE;
+  }
+
+  switch (baseType)
+  {
+    case VTK_PARSE_OBJECT:
+      return (indirection == VTK_PARSE_POINTER ?
+              CXX_VALUE_OBJECT : CXX_VALUE_NONE);
+    case VTK_PARSE_FLOAT:
+    case VTK_PARSE_DOUBLE:
+    case VTK_PARSE_CHAR:
+    case VTK_PARSE_SIGNED_CHAR:
+    case VTK_PARSE_UNSIGNED_CHAR:
+    case VTK_PARSE_SHORT:
+    case VTK_PARSE_UNSIGNED_SHORT:
+    case VTK_PARSE_INT:
+    case VTK_PARSE_UNSIGNED_INT:
+    case VTK_PARSE_LONG:
+    case VTK_PARSE_UNSIGNED_LONG:
+    case VTK_PARSE_LONG_LONG:
+    case VTK_PARSE_UNSIGNED_LONG_LONG:
+    case VTK_PARSE_ID_TYPE:
+    case VTK_PARSE_SIZE_T:
+    case VTK_PARSE_SSIZE_T:
+    case VTK_PARSE_BOOL:
+      break;
+    default:
+      return CXX_VALUE_NONE;
+  }
+
+  if (indirection == 0)
+  {
+    return CXX_VALUE_NUMBER;
+  }
+  else if (indirection == VTK_PARSE_POINTER && baseType == VTK_PARSE_CHAR &&
+           property->Count == 0)
+  {
+    return CXX_VALUE_STRING;
+  }
+  else if (indirection == VTK_PARSE_POINTER && property->Count > 0)
+  {
+    return CXX_VALUE_ARRAY;
+  }
+
+  return CXX_VALUE_NONE;
+}
+
+/*-------------------------------------------------------------------
+ * find the public method of a property that has the given type, the
+ * suffix is for SetValueTo methods, and legacy methods are not used
+ * since they might have been removed from the build */
+
+static const char *cxxPropertyMethod(
+  ClassInfo *data, ClassProperties *properties, int p,
+  unsigned int methodType, const char *suffix)
+{
+  FunctionInfo *func;
+  size_t l, m;
+  int i;
+
+  for (i = 0; i < data->NumberOfFunctions; i++)
+  {
+    func = data->Functions[i];
+    if (properties->MethodHasProperty[i] &&
+        properties->MethodProperties[i] == p &&
+        properties->MethodTypes[i] == methodType &&
+        func->Access == VTK_ACCESS_PUBLIC && func->Name &&
+        !func->IsStatic && !func->IsLegacy && !func->IsDeleted)
+    {
+      if (suffix == NULL)
+      {
+        return func->Name;
+      }
+      l = strlen(func->Name);
+      m = strlen(suffix);
+      if (l > m + 2 && strcmp(&func->Name[l - m], suffix) == 0 &&
+          strncmp(&func->Name[l - m - 2], "To", 2) == 0)
+      {
+        return func->Name;
+      }
+    }
+  }
+
+  return NULL;
+}
+
+/*-------------------------------------------------------------------
+ * write the getter for a property, and return zero if there is none */
+
+static int cxxGetter(
+  wrapcxx_state_t *w, ClassInfo *data, ClassProperties *properties, int p)
+{
+  PropertyInfo *property = properties->Properties[p];
+  const char *type = property->ClassName;
+  const char *getMethod;
+  const char *multiMethod;
+  int kind = cxxValueKind(property);
+  int i;
+
+  getMethod = cxxPropertyMethod(data, properties, p, VTK_METHOD_GET, NULL);
+  multiMethod =
+    cxxPropertyMethod(data, properties, p, VTK_METHOD_GET_MULTI, NULL);
+
+  if (kind == CXX_VALUE_NONE ||
+      (getMethod == NULL && (kind != CXX_VALUE_ARRAY || multiMethod == NULL)))
+  {
+    return 0;
+  }
+
+  vtkWrapXMLOutput_Printf(w->file,
+    "static void %s_%s_Get(vtkObjectBase *object, void *value)\n{\n"
+    "  %s *self = static_cast<%s *>(object);\n",
+    data->Name, property->Name, data->Name, data->Name);
+
+  switch (kind)
+  {
+    case CXX_VALUE_NUMBER:
+      vtkWrapXMLOutput_Printf(w->file,
+        "  *static_cast<%s *>(value) = self->%s();\n", type, getMethod);
+      break;
+    case CXX_VALUE_STRING:
+      vtkWrapXMLOutput_Printf(w->file,
+        "  *static_cast<const char **>(value) = self->%s();\n", getMethod);
+      break;
+    case CXX_VALUE_OBJECT:
+      vtkWrapXMLOutput_Printf(w->file,
+        "  *static_cast<vtkObjectBase **>(value) = self->%s();\n",
+        getMethod);
+      break;
+    case CXX_VALUE_ARRAY:
+      vtkWrapXMLOutput_Printf(w->file,
+        "  %s *v = static_cast<%s *>(value);\n", type, type);
+      if (getMethod)
+      {
+        vtkWrapXMLOutput_Printf(w->file,
+          "  const %s *a = self->%s();\n"
+          "  if (a)\n  {\n"
+          "    for (int i = 0; i < %d; i++)\n    {\n"
+          "      v[i] = a[i];\n    }\n  }\n",
+          type, getMethod, property->Count);
+      }
+      else
+      {
+        vtkWrapXMLOutput_Printf(w->file, "  self->%s(", multiMethod);
+        for (i = 0; i < property->Count; i++)
+        {
+          vtkWrapXMLOutput_Printf(w->file, "%sv[%d]", (i ? ", " : ""), i);
+        }
+        vtkWrapXMLOutput_Puts(w->file, ");\n");
+      }
+      break;
+  }
+
+  vtkWrapXMLOutput_Puts(w->file, "}\n\n");
+
+  return 1;
+}
+
+/*-------------------------------------------------------------------
+ * write the setter for a property, and return zero if there is none */
+
+static int cxxSetter(
+  wrapcxx_state_t *w, ClassInfo *data, ClassProperties *properties, int p)
+{
+  PropertyInfo *property = properties->Properties[p];
+  const char *type = property->ClassName;
+  const char *setMethod;
+  const char *multiMethod;
+  const char *onMethod;
+  const char *offMethod;
+  const char *method;
+  int kind = cxxValueKind(property);
+  int i;
+
+  setMethod = cxxPropertyMethod(data, properties, p, VTK_METHOD_SET, NULL);
+  multiMethod =
+    cxxPropertyMethod(data, properties, p, VTK_METHOD_SET_MULTI, NULL);
+  onMethod = cxxPropertyMethod(data, properties, p, VTK_METHOD_BOOL_ON, NULL);
+  offMethod =
+    cxxPropertyMethod(data, properties, p, VTK_METHOD_BOOL_OFF, NULL);
+
+  if (kind == CXX_VALUE_NONE)
+  {
+    return 0;
+  }
+  else if (setMethod == NULL && kind == CXX_VALUE_ARRAY)
+  {
+    if (multiMethod == NULL)
+    {
+      return 0;
+    }
+  }
+  else if (setMethod == NULL && kind == CXX_VALUE_NUMBER)
+  {
+    /* use the SetValueTo methods, or else the boolean methods */
+    if (!(property->EnumConstantNames && property->EnumConstantNames[0] &&
+          (property->PublicMethods & VTK_METHOD_SET_VALUE_TO)) &&
+        (onMethod == NULL || offMethod == NULL))
+    {
+      return 0;
+    }
+  }
+  else if (setMethod == NULL)
+  {
+    return 0;
+  }
+
+  vtkWrapXMLOutput_Printf(w->file,
+    "static void %s_%s_Set(vtkObjectBase *object, const void *value)\n{\n"
+    "  %s *self = static_cast<%s *>(object);\n",
+    data->Name, property->Name, data->Name, data->Name);
+
+  switch (kind)
+  {
+    case CXX_VALUE_NUMBER:
+      if (setMethod)
+      {
+        vtkWrapXMLOutput_Printf(w->file,
+          "  self->%s(*static_cast<const %s *>(value));\n", setMethod, type);
+      }
+      else if (property->EnumConstantNames && property->EnumConstantNames[0] &&
+               (property->PublicMethods & VTK_METHOD_SET_VALUE_TO))
+      {
+        vtkWrapXMLOutput_Puts(w->file,
+          "  switch (*static_cast<const int *>(value))\n  {\n");
+        for (i = 0; property->EnumConstantNames[i]; i++)
+        {
+          method = cxxPropertyMethod(data, properties, p,
+            VTK_METHOD_SET_VALUE_TO, property->EnumConstantNames[i]);
+          if (method)
+          {
+            vtkWrapXMLOutput_Printf(w->file,
+              "    case %d:\n      self->%s();\n      break;\n", i, method);
+          }
+        }
+        vtkWrapXMLOutput_Puts(w->file,
+          "    default:\n      break;\n  }\n");
+      }
+      else
+      {
+        vtkWrapXMLOutput_Printf(w->file,
+          "  if (*static_cast<const %s *>(value))\n  {\n"
+          "    self->%s();\n  }\n  else\n  {\n    self->%s();\n  }\n",
+          type, onMethod, offMethod);
+      }
+      break;
+    case CXX_VALUE_STRING:
+      vtkWrapXMLOutput_Printf(w->file,
+        "  self->%s(*static_cast<const char *const *>(value));\n",
+        setMethod);
+      break;
+    case CXX_VALUE_OBJECT:
+      vtkWrapXMLOutput_Printf(w->file,
+        "  vtkObjectBase *o = *static_cast<vtkObjectBase *const *>(value);\n"
+        "  %s *v = %s::SafeDownCast(o);\n"
+        "  if (v || !o)\n  {\n    self->%s(v);\n  }\n",
+        type, type, setMethod);
+      break;
+    case CXX_VALUE_ARRAY:
+      vtkWrapXMLOutput_Printf(w->file,
+        "  const %s *v = static_cast<const %s *>(value);\n", type, type);
+      if (setMethod)
+      {
+        vtkWrapXMLOutput_Printf(w->file,
+          "  self->%s(const_cast<%s *>(v));\n", setMethod, type);
+      }
+      else
+      {
+        vtkWrapXMLOutput_Printf(w->file, "  self->%s(", multiMethod);
+        for (i = 0; i < property->Count; i++)
+        {
+          vtkWrapXMLOutput_Printf(w->file, "%sv[%d]", (i ? ", " : ""), i);
+        }
+        vtkWrapXMLOutput_Puts(w->file, ");\n");
+      }
+      break;
+  }
+
+  vtkWrapXMLOutput_Puts(w->file, "}\n\n");
+
+  return 1;
+}
+
+/*-------------------------------------------------------------------
+ * write the thunks for the public properties, and return the flags
+ * that say which properties have them */
+
+static const int *cxxThunks(
+  wrapcxx_state_t *w, ClassInfo *data, ClassProperties *properties,
+  const int *indices)
+{
+  PropertyInfo *property;
+  int *flags;
+  int i, j;
+
+  flags = (int *)vtkWrapXMLArena_Alloc(
+    w->arena, sizeof(int)*(properties->NumberOfProperties + 1));
+
+  /* the object types must be complete for the conversions, and by
+     VTK convention each class is declared in a header of the same name */
+  for (i = 0; i < properties->NumberOfProperties; i++)
+  {
+    property = properties->Properties[i];
+    if (indices[i] >= 0 && cxxValueKind(property) == CXX_VALUE_OBJECT)
+    {
+      for (j = 0; j < i; j++)
+      {
+        if (indices[j] >= 0 &&
+            cxxValueKind(properties->Properties[j]) == CXX_VALUE_OBJECT &&
+            strcmp(properties->Properties[j]->ClassName,
+                   property->ClassName) == 0)
+        {
+          break;
+        }
+      }
+      if (j == i)
+      {
+        vtkWrapXMLOutput_Printf(w->file, "#include \"%s.h\"\n",
+                                property->ClassName);
+      }
+    }
+  }
+  vtkWrapXMLOutput_Putc(w->file, '\n');
+
+  for (i = 0; i < properties->NumberOfProperties; i++)
+  {
+    flags[i] = 0;
+    if (indices[i] >= 0)
+    {
+      if (cxxGetter(w, data, properties, i))
+      {
+        flags[i] |= CXX_HAS_GET;
+      }
+      if (cxxSetter(w, data, properties, i))
+      {
+        flags[i] |= CXX_HAS_SET;
+      }
+    }
+  }
+
+  return flags;
+}
+
+/*-------------------------------------------------------------------
+ * write the perfect hash table for a list of names, the table is left
+ * empty if it cannot be built, so that lookups will find nothing */
+
+static void cxxHash(
+  wrapcxx_state_t *w, WrapXMLPerfectHash *hash, const char **names,
+  int n, const char *className, const char *what)
+{
+  char *prefix;
+
+  if (!vtkWrapXMLPerfectHash_Build(hash, names, n, w->arena))
+  {
+    fprintf(stderr, "vtkWrapXML: cannot build the %s hash for %s\n",
+            what, className);
+    memset(hash, 0, sizeof(WrapXMLPerfectHash));
+    return;
+  }
+
+  prefix = (char *)vtkWrapXMLArena_Alloc(
+    w->arena, strlen(className) + strlen(what) + 2);
+  sprintf(prefix, "%s_%s", className, what);
+  vtkWrapXMLPerfectHash_Write(w->file, hash, prefix);
+}
+
+/*-------------------------------------------------------------------
+ * write the tables for the properties, and return a map from the
+ * property index to the index in the table, or -1 if not public */
+
+static int *cxxProperties(
+  wrapcxx_state_t *w, ClassInfo *data, ClassProperties *properties,
+  int *countp, WrapXMLPerfectHash *hash)
+{
+  PropertyInfo *property;
+  const int *flags = NULL;
+  const char **names;
+  int *indices;
+  int count = 0;
+  int i, j;
+
+  memset(hash, 0, sizeof(WrapXMLPerfectHash));
+
+  indices = (int *)vtkWrapXMLArena_Alloc(
+    w->arena, sizeof(int)*(properties->NumberOfProperties + 1));
+
+  /* the names of the enum values come first */
+  for (i = 0; i < properties->NumberOfProperties; i++)
+  {
+    property = properties->Properties[i];
+    indices[i] = -1;
+    if (property->PublicMethods == 0)
+    {
+      continue;
+    }
+    indices[i] = count++;
+
+    if (property->EnumConstantNames && property->EnumConstantNames[0])
+    {
+      vtkWrapXMLOutput_Printf(w->file,
+        "static constexpr const char *const %s_%s_Values[] = {\n",
+        data->Name, property->Name);
+      for (j = 0; property->EnumConstantNames[j]; j++)
+      {
+        vtkWrapXMLOutput_Puts(w->file, "  ");
+        cxxString(w, property->EnumConstantNames[j]);
+        vtkWrapXMLOutput_Puts(w->file, ",\n");
+      }
+      vtkWrapXMLOutput_Puts(w->file, "};\n\n");
+    }
+  }
+
+  *countp = count;
+  if (count == 0)
+  {
+    return indices;
+  }
+
+  /* the thunks take a vtkObjectBase pointer, so other classes have
+   * no thunks and their properties have a null Get and Set */
+  if (w->thunks && vtkWrapXMLHierarchy_IsVTKObject(
+        w->hierarchy, w->contents, data->Name))
+  {
+    flags = cxxThunks(w, data, properties, indices);
+  }
+
+  names = (const char **)vtkWrapXMLArena_Alloc(
+    w->arena, sizeof(char *)*count);
+
+  vtkWrapXMLOutput_Printf(w->file,
+    "static constexpr WrapXMLReflectionProperty %s_Properties[] = {\n",
+    data->Name);
+  for (i = 0; i < properties->NumberOfProperties; i++)
+  {
+    property = properties->Properties[i];
+    if (indices[i] < 0)
+    {
+      continue;
+    }
+    names[indices[i]] = property->Name;
+    for (j = 0; property->EnumConstantNames &&
+         property->EnumConstantNames[j]; j++)
+    {
+      ;
+    }
+    vtkWrapXMLOutput_Puts(w->file, "  { ");
+    cxxString(w, property->Name);
+    vtkWrapXMLOutput_Printf(w->file, ", 0x%x, %d, ",
+                            property->Type, property->Count);
+    cxxString(w, property->ClassName);
+    if (j > 0)
+    {
+      vtkWrapXMLOutput_Printf(w->file, ", %s_%s_Values, %d, ",
+                              data->Name, property->Name, j);
+    }
+    else
+    {
+      vtkWrapXMLOutput_Puts(w->file, ", nullptr, 0, ");
+    }
+    vtkWrapXMLOutput_Printf(w->file, "0x%08x, ", property->PublicMethods);
+    if (flags && (flags[i] & CXX_HAS_GET))
+    {
+      vtkWrapXMLOutput_Printf(w->file, "%s_%s_Get, ",
+                              data->Name, property->Name);
+    }
+    else
+    {
+      vtkWrapXMLOutput_Puts(w->file, "nullptr, ");
+    }
+    if (flags && (flags[i] & CXX_HAS_SET))
+    {
+      vtkWrapXMLOutput_Printf(w->file, "%s_%s_Set },\n",
+                              data->Name, property->Name);
+    }
+    else
+    {
+      vtkWrapXMLOutput_Puts(w->file, "nullptr },\n");
+    }
+  }
+  vtkWrapXMLOutput_Puts(w->file, "};\n\n");
+
+  /* the lookup table for the property names */
+  cxxHash(w, hash, names, count, data->Name, "Property");
+
+  return indices;
+}
+
+/*-------------------------------------------------------------------
+ * write the table of methods, and return the number of methods */
+
+static int cxxMethods(
+  wrapcxx_state_t *w, ClassInfo *data, ClassProperties *properties,
+  const int *indices)
+{
+  FunctionInfo *func;
+  const char *signature;
+  size_t n;
+  int count = 0;
+  int property;
+  int i;
+
+  for (i = 0; i < data->NumberOfFunctions; i++)
+  {
+    func = data->Functions[i];
+    if (!cxxIsMethod(data, func))
+    {
+      continue;
+    }
+
+    if (count++ == 0)
+    {
+      vtkWrapXMLOutput_Printf(w->file,
+        "static constexpr WrapXMLReflectionMethod %s_Methods[] = {\n",
+        data->Name);
+    }
+
+    property = -1;
+    if (properties->MethodHasProperty[i])
+    {
+      property = indices[properties->MethodProperties[i]];
+    }
+
+    signature = vtkWrapXMLSignatures_Get(w->signatures, func, &n);
+
+    vtkWrapXMLOutput_Puts(w->file, "  { ");
+    cxxString(w, func->Name);
+    vtkWrapXMLOutput_Puts(w->file, ", ");
+    cxxString(w, signature);
+    vtkWrapXMLOutput_Printf(w->file, ", %d, %d },\n",
+                            property, (func->IsStatic != 0));
+  }
+
+  if (count)
+  {
+    vtkWrapXMLOutput_Puts(w->file, "};\n\n");
+  }
+
+  return count;
+}
+
+/*-------------------------------------------------------------------
+ * write the tables for a class, followed by its descriptor */
+
+static void cxxClass(wrapcxx_state_t *w, ClassInfo *data)
+{
+  ClassProperties *properties;
+  WrapXMLPerfectHash hash;
+  const int *indices;
+  char fingerprint[20];
+  int numberOfProperties;
+  int numberOfMethods;
+
+  vtkWrapXMLFingerprints_ToString(
+    vtkWrapXMLFingerprints_Class(w->fingerprints, data), fingerprint);
+  properties = vtkWrapXMLFingerprints_Properties(w->fingerprints, data);
+
+  indices = cxxProperties(w, data, properties, &numberOfProperties, &hash);
+  numberOfMethods = cxxMethods(w, data, properties, indices);
+
+  vtkWrapXMLOutput_Printf(w->file,
+    "static constexpr WrapXMLReflectionClass %s_Reflection = {\n  ",
+    data->Name);
+  cxxString(w, data->Name);
+  vtkWrapXMLOutput_Puts(w->file, ",\n  ");
+  cxxString(w, (data->NumberOfSuperClasses ? data->SuperClasses[0] : NULL));
+  vtkWrapXMLOutput_Printf(w->file, ",\n  %d,\n", (data->IsAbstract != 0));
+  if (numberOfProperties)
+  {
+    vtkWrapXMLOutput_Printf(w->file, "  %d, %s_Properties,\n",
+                            numberOfProperties, data->Name);
+  }
+  else
+  {
+    vtkWrapXMLOutput_Puts(w->file, "  0, nullptr,\n");
+  }
+  if (hash.Size)
+  {
+    vtkWrapXMLOutput_Printf(w->file,
+      "  { %d, %s_PropertyDisplacements, %s_PropertySlots },\n",
+      hash.NumberOfBuckets, data->Name, data->Name);
+  }
+  else
+  {
+    vtkWrapXMLOutput_Puts(w->file, "  { 0, nullptr, nullptr },\n");
+  }
+  if (numberOfMethods)
+  {
+    vtkWrapXMLOutput_Printf(w->file, "  %d, %s_Methods,\n",
+                            numberOfMethods, data->Name);
+  }
+  else
+  {
+    vtkWrapXMLOutput_Puts(w->file, "  0, nullptr,\n");
+  }
+  vtkWrapXMLOutput_Printf(w->file, "  0x%sull\n};\n\n", fingerprint);
+}
+
+/*-------------------------------------------------------------------
+ * check whether a class can be described, templates cannot */
+
+static int cxxIsClass(ClassInfo *data)
+{
+  return (data->Template == NULL && data->Name != NULL &&
+          (data->ItemType == VTK_CLASS_INFO ||
+           data->ItemType == VTK_STRUCT_INFO));
+}
+
+/*-------------------------------------------------------------------
+ * write the tables for all the classes in a file */
+
+void vtkWrapXMLCxx_WriteFile(
+  WrapXMLOutput *fp, FileInfo *data, WrapXMLFingerprints *fingerprints,
+  int thunks, WrapXMLHierarchy *hierarchy)
+{
+  wrapcxx_state_t w;
+  NamespaceInfo *contents = data->Contents;
+  const char *cp = data->FileName;
+  size_t l;
+  int i;
+
+  w.file = fp;
+  w.arena = fingerprints->Arena;
+  w.signatures = fingerprints->Signatures;
+  w.fingerprints = fingerprints;
+  w.thunks = thunks;
+  w.hierarchy = hierarchy;
+  w.contents = contents;
+
+  /* the list of classes is what vtkWrapXMLReflect looks for */
+  vtkWrapXMLOutput_Puts(fp, "// classes:");
+  for (i = 0; contents && i < contents->NumberOfClasses; i++)
+  {
+    if (cxxIsClass(contents->Classes[i]))
+    {
+      vtkWrapXMLOutput_Printf(fp, " %s", contents->Classes[i]->Name);
+    }
+  }
+  vtkWrapXMLOutput_Puts(fp, "\n");
+  if (cp)
+  {
+    l = strlen(cp);
+    while (l > 0 && cp[l-1] != '/' && cp[l-1] != '\\' && cp[l-1] != ':')
+    {
+      l--;
+    }
+    vtkWrapXMLOutput_Printf(fp, "// generated from %s, do not edit\n",
+                            &cp[l]);
+  }
+  vtkWrapXMLOutput_Putc(fp, '\n');
+
+  /* the thunks call the methods, so they need the declarations */
+  if (thunks && cp)
+  {
+    vtkWrapXMLOutput_Printf(fp, "#include \"%s\"\n\n", &cp[l]);
+  }
+
+  for (i = 0; contents && i < contents->NumberOfClasses; i++)
+  {
+    if (cxxIsClass(contents->Classes[i]))
+    {
+      cxxClass(&w, contents->Classes[i]);
+    }
+  }
+}
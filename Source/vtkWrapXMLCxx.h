@@ -0,0 +1,69 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLCxx.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file contains the C++ reflection backend for vtkWrapXML.  For
+ * each class in a header, it writes constexpr arrays that describe the
+ * public properties and methods of the class, and a constexpr class
+ * descriptor, using the types from vtkWrapXMLReflection.h.  The output
+ * is a fragment that cannot be compiled by itself: the vtkWrapXMLReflect
+ * program includes the fragments of all the headers in a module into
+ * a single source file, and adds the table of classes for the module.
+ *
+ * Each fragment starts with a line that lists its classes,
+ *
+ *   // classes: vtkFoo vtkBar
+ *
+ * and the descriptor of each class is named after the class, e.g.
+ * "vtkFoo_Reflection".  The descriptor includes a perfect hash table
+ * for looking up the properties of the class by name.
+ *
+ * Optionally, a getter and a setter thunk is written for each property
+ * whose value is a number, an array of numbers, a string, or an object.
+ * The thunks call the Get/Set, GetMulti/SetMulti, SetValueTo, and On/Off
+ * methods that were found for the property, so the fragment includes
+ * the header of the class, and the source file must be compiled with
+ * the include path and linked with the library of the module.  Thunks
+ * are only written for classes that are derived from vtkObjectBase.
+ */
+
+#ifndef VTK_WRAP_XML_CXX_H
+#define VTK_WRAP_XML_CXX_H
+
+#include "vtkParseData.h"
+#include "vtkWrapXMLFingerprints.h"
+#include "vtkWrapXMLHierarchy.h"
+#include "vtkWrapXMLOutput.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Write the reflection tables for the classes in a parsed file.  The
+ * fingerprint table provides the signatures, the class properties, and
+ * the arena that all memory is allocated from.  If "thunks" is set,
+ * then the accessor thunks for the properties are written too, and the
+ * hierarchy (which can be NULL) is used to find out which classes are
+ * derived from vtkObjectBase.
+ */
+void vtkWrapXMLCxx_WriteFile(
+  WrapXMLOutput *fp, FileInfo *data, WrapXMLFingerprints *fingerprints,
+  int thunks, WrapXMLHierarchy *hierarchy);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,765 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLDiff.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ The vtkWrapXMLDiff program compares the API of two wrapped builds.
+ Each build is given as a manifest, or as the directory that holds the
+ "modules.manifest" that is written by vtk_module_wrap_xml().  The
+ manifest gives the byte range of each class element, so the classes
+ can be read without parsing the rest of the XML.
+
+ The API fingerprints of the classes are taken from the manifests, so
+ the classes that have not changed are never read.  For manifests that
+ do not have fingerprints, a fingerprint is computed for each class from
+ its element, with the comments removed and the whitespace collapsed.
+ Only the classes whose fingerprints differ are examined further.  For
+ these classes, the members are matched by kind and by key, where the
+ key is the signature for methods and the name for everything else,
+ and each pair of members is compared by its own fingerprint.  The
+ report has one line per difference:
+
+   - class vtkOldClass
+   + class vtkNewClass
+   ~ class vtkChangedClass
+     - method void SetValue(int v)
+     + method void SetValue(double v)
+     ~ property Value
+
+ The exit code is 0 if the builds have the same API, 1 if they differ,
+ and 2 if an error occurred, so that the program can be used as a test.
+*/
+
+#include "vtkWrapXMLHash.h"
+#include "vtkWrapXMLInput.h"
+#include "vtkWrapXMLManifest.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * A build, with a fingerprint for each class in its manifest
+ */
+typedef struct _DiffBuild
+{
+  WrapXMLManifest *Manifest;   /* the classes */
+  char *Directory;             /* the directory of the manifest */
+  uint64_t *Fingerprints;      /* the fingerprint of each class */
+  int *Table;                  /* hash table of class names */
+  int TableSize;               /* a power of two */
+  char *TextFile;              /* the file that is held in "Text" */
+  char *Text;                  /* the uncompressed XML */
+  size_t TextLength;           /* the length of the XML */
+} DiffBuild;
+
+/**
+ * A member of a class, the strings point into the XML
+ */
+typedef struct _DiffMember
+{
+  const char *Kind;      /* the element name */
+  size_t KindLength;
+  const char *Key;       /* the signature, or the name */
+  size_t KeyLength;
+  uint64_t KeyHash;      /* the hash of the kind and the key */
+  uint64_t Hash;         /* the fingerprint of the member */
+  int IsEnumValue;       /* set for enum constants */
+  int Matched;           /* set if the other build has the member */
+} DiffMember;
+
+/**
+ * Print the usage and exit
+ */
+static void vtkWrapXMLDiff_Usage(void)
+{
+  fprintf(stderr,
+    "Usage: vtkWrapXMLDiff [-o <report>] <old> <new>\n"
+    "  -o <report>   write the report to a file instead of stdout\n"
+    "  <old> <new>   a manifest, or a directory with modules.manifest\n");
+  exit(2);
+}
+
+/*-------------------------------------------------------------------
+ * scanning the XML */
+
+static int isSpace(char c)
+{
+  return (c == ' ' || c == '\t' || c == '\n' || c == '\r');
+}
+
+/* find the end of the tag that starts at "cp", i.e. after the '>' */
+static const char *tagEnd(const char *cp, const char *end)
+{
+  while (cp < end && *cp != '>')
+  {
+    if (*cp == '\"')
+    {
+      do
+      {
+        cp++;
+      }
+      while (cp < end && *cp != '\"');
+    }
+    cp++;
+  }
+
+  return (cp < end ? cp + 1 : end);
+}
+
+/* find the end of the element that starts at "cp" */
+static const char *elementEnd(const char *cp, const char *end)
+{
+  const char *te;
+  int depth = 0;
+
+  do
+  {
+    while (cp < end && *cp != '<')
+    {
+      cp++;
+    }
+    if (cp == end)
+    {
+      break;
+    }
+    te = tagEnd(cp, end);
+    if (cp[1] == '/')
+    {
+      depth--;
+    }
+    else if (te[-2] != '/')
+    {
+      depth++;
+    }
+    cp = te;
+  }
+  while (depth > 0);
+
+  return cp;
+}
+
+/* get the value of an attribute in the tag at "cp" */
+static const char *attribute(
+  const char *cp, const char *end, const char *name, size_t *length)
+{
+  const char *te = tagEnd(cp, end);
+  const char *vp;
+  size_t l = strlen(name);
+
+  for (; cp + l + 2 < te; cp++)
+  {
+    if (isSpace(cp[0]) && strncmp(&cp[1], name, l) == 0 &&
+        cp[l + 1] == '=' && cp[l + 2] == '\"')
+    {
+      vp = &cp[l + 3];
+      cp = vp;
+      while (cp < te && *cp != '\"')
+      {
+        cp++;
+      }
+      *length = cp - vp;
+      return vp;
+    }
+  }
+
+  return NULL;
+}
+
+/* check whether the element at "cp" has the given name */
+static int isElement(const char *cp, const char *end, const char *name)
+{
+  size_t l = strlen(name);
+
+  return (cp + l + 1 < end && cp[0] == '<' &&
+          strncmp(&cp[1], name, l) == 0 &&
+          (isSpace(cp[l + 1]) || cp[l + 1] == '>' || cp[l + 1] == '/'));
+}
+
+/* hash an element with the comments removed and the whitespace
+   collapsed, so that only the API contributes to the hash */
+static uint64_t hashElement(uint64_t h, const char *cp, const char *end)
+{
+  const char *sp;
+
+  while (cp < end)
+  {
+    if (isSpace(*cp))
+    {
+      while (cp < end && isSpace(*cp))
+      {
+        cp++;
+      }
+      h = vtkWrapXMLHash_Bytes(h, " ", 1);
+    }
+    else if (*cp == '<' && (isElement(cp, end, "comment") ||
+                            isElement(cp, end, "doc")))
+    {
+      cp = elementEnd(cp, end);
+    }
+    else
+    {
+      sp = cp;
+      do
+      {
+        cp++;
+      }
+      while (cp < end && !isSpace(*cp) && *cp != '<');
+      h = vtkWrapXMLHash_Bytes(h, sp, cp - sp);
+    }
+  }
+
+  return h;
+}
+
+/* hash text with the whitespace collapsed and trimmed */
+static uint64_t hashText(uint64_t h, const char *cp, size_t n)
+{
+  const char *end = cp + n;
+  const char *sp;
+
+  while (cp < end)
+  {
+    while (cp < end && isSpace(*cp))
+    {
+      cp++;
+    }
+    sp = cp;
+    while (cp < end && !isSpace(*cp))
+    {
+      cp++;
+    }
+    if (cp != sp)
+    {
+      h = vtkWrapXMLHash_Bytes(h, sp, cp - sp);
+      h = vtkWrapXMLHash_Bytes(h, " ", 1);
+    }
+  }
+
+  return h;
+}
+
+/* print text with the whitespace collapsed and trimmed, and with the
+   XML entities replaced by the characters that they stand for */
+static void printText(FILE *fp, const char *cp, size_t n)
+{
+  static const char *entities[] = {
+    "&lt;", "<", "&gt;", ">", "&quot;", "\"", "&amp;", "&", NULL };
+  const char *end = cp + n;
+  size_t l;
+  int space = 0;
+  int i;
+
+  while (cp < end && isSpace(*cp))
+  {
+    cp++;
+  }
+  for (; cp < end; cp++)
+  {
+    if (isSpace(*cp))
+    {
+      space = 1;
+    }
+    else
+    {
+      if (space)
+      {
+        fputc(' ', fp);
+        space = 0;
+      }
+      for (i = 0; *cp == '&' && entities[i]; i += 2)
+      {
+        l = strlen(entities[i]);
+        if ((size_t)(end - cp) >= l && strncmp(cp, entities[i], l) == 0)
+        {
+          break;
+        }
+      }
+      if (*cp == '&' && entities[i])
+      {
+        fputs(entities[i + 1], fp);
+        cp += strlen(entities[i]) - 1;
+      }
+      else
+      {
+        fputc(*cp, fp);
+      }
+    }
+  }
+}
+
+/*-------------------------------------------------------------------
+ * get the members of a class element */
+
+static int getMembers(const char *text, size_t n, DiffMember **membersp)
+{
+  const char *end = text + n;
+  const char *cp;
+  const char *ep;
+  const char *sp;
+  DiffMember *members = NULL;
+  DiffMember *m;
+  size_t l;
+  int count = 0;
+
+  /* skip the start tag of the class */
+  cp = tagEnd(text, end);
+  if (cp[-2] == '/')
+  {
+    *membersp = NULL;
+    return 0;
+  }
+
+  for (;;)
+  {
+    while (cp < end && *cp != '<')
+    {
+      cp++;
+    }
+    if (cp == end || cp[1] == '/')
+    {
+      break;
+    }
+
+    ep = elementEnd(cp, end);
+    if (!isElement(cp, end, "comment") && !isElement(cp, end, "doc"))
+    {
+      if ((count & (count - 1)) == 0)
+      {
+        members = (DiffMember *)realloc(
+          members, sizeof(DiffMember)*(count == 0 ? 1 : 2*count));
+      }
+      m = &members[count++];
+      memset(m, 0, sizeof(DiffMember));
+
+      m->Kind = cp + 1;
+      for (l = 0; cp + l + 1 < ep && !isSpace(cp[l + 1]) &&
+           cp[l + 1] != '>' && cp[l + 1] != '/'; l++)
+      {
+        ;
+      }
+      m->KindLength = l;
+
+      /* methods are matched by signature, everything else by name */
+      for (sp = tagEnd(cp, ep); sp < ep; sp = elementEnd(sp, ep))
+      {
+        while (sp < ep && *sp != '<')
+        {
+          sp++;
+        }
+        if (isElement(sp, ep, "signature"))
+        {
+          m->Key = tagEnd(sp, ep);
+          for (l = 0; m->Key + l < ep && m->Key[l] != '<'; l++)
+          {
+            ;
+          }
+          m->KeyLength = l;
+          break;
+        }
+      }
+      if (m->Key == NULL)
+      {
+        m->Key = attribute(cp, ep, "name", &m->KeyLength);
+      }
+      if (m->Key == NULL)
+      {
+        m->Key = cp;
+        m->KeyLength = tagEnd(cp, ep) - cp;
+      }
+
+      sp = attribute(cp, ep, "enum", &l);
+      m->IsEnumValue = (sp && l == 1 && sp[0] == '1');
+
+      m->KeyHash = vtkWrapXMLHash_Bytes(
+        VTK_WRAP_XML_HASH_INIT, m->Kind, m->KindLength);
+      m->KeyHash = hashText(m->KeyHash, m->Key, m->KeyLength);
+      m->Hash = hashElement(VTK_WRAP_XML_HASH_INIT, cp, ep);
+    }
+    cp = ep;
+  }
+
+  *membersp = members;
+  return count;
+}
+
+/*-------------------------------------------------------------------
+ * load a build */
+
+/* get the text of a class, reading its file if it is not loaded */
+static const char *classText(DiffBuild *b, int i, size_t *n)
+{
+  WrapXMLManifestEntry *e = &b->Manifest->Entries[i];
+  char *path;
+  size_t l, m;
+
+  if (e->File == NULL || e->End < e->Start)
+  {
+    return NULL;
+  }
+
+  l = strlen(b->Directory);
+  m = strlen(e->File);
+  path = (char *)malloc(l + m + 2);
+  memcpy(path, b->Directory, l);
+  path[l] = '/';
+  memcpy(&path[l + 1], e->File, m + 1);
+
+  if (b->TextFile == NULL || strcmp(b->TextFile, path) != 0)
+  {
+    free(b->TextFile);
+    free(b->Text);
+    b->TextFile = path;
+    b->Text = vtkWrapXMLInput_ReadAll(path, &b->TextLength);
+    if (b->Text == NULL)
+    {
+      fprintf(stderr, "vtkWrapXMLDiff: cannot read %s\n", path);
+      exit(2);
+    }
+  }
+  else
+  {
+    free(path);
+  }
+
+  if (e->End > b->TextLength)
+  {
+    fprintf(stderr, "vtkWrapXMLDiff: %s is older than its manifest\n",
+            b->TextFile);
+    exit(2);
+  }
+
+  *n = e->End - e->Start;
+  return &b->Text[e->Start];
+}
+
+/* find a class by name, or return -1 */
+static int findClass(DiffBuild *b, const char *name)
+{
+  unsigned int mask = b->TableSize - 1;
+  unsigned int j;
+  int i;
+
+  j = (unsigned int)vtkWrapXMLHash_String(VTK_WRAP_XML_HASH_INIT, name);
+  for (;; j++)
+  {
+    i = b->Table[j & mask];
+    if (i < 0 || strcmp(b->Manifest->Entries[i].Name, name) == 0)
+    {
+      return i;
+    }
+  }
+}
+
+static void loadBuild(DiffBuild *b, const char *name)
+{
+  WrapXMLManifest *manifest;
+  const char *cp;
+  size_t l;
+  unsigned int mask;
+  unsigned int j;
+  int i;
+
+  memset(b, 0, sizeof(DiffBuild));
+
+  /* the name is either a manifest, or the directory that holds one */
+  manifest = vtkWrapXMLManifest_New();
+  if (vtkWrapXMLManifest_Read(manifest, name))
+  {
+    cp = strrchr(name, '/');
+#if defined(_WIN32)
+    if (strrchr(name, '\\') > cp)
+    {
+      cp = strrchr(name, '\\');
+    }
+#endif
+    l = (cp ? (size_t)(cp - name) : 1);
+    b->Directory = (char *)malloc(l + 1);
+    memcpy(b->Directory, (cp ? name : "."), l);
+    b->Directory[l] = '\0';
+  }
+  else
+  {
+    l = strlen(name);
+    b->Directory = (char *)malloc(l + 1);
+    memcpy(b->Directory, name, l + 1);
+    b->TextFile = (char *)malloc(l + 18);
+    memcpy(b->TextFile, name, l);
+    strcpy(&b->TextFile[l], "/modules.manifest");
+    if (!vtkWrapXMLManifest_Read(manifest, b->TextFile))
+    {
+      fprintf(stderr, "vtkWrapXMLDiff: cannot read manifest %s\n", name);
+      exit(2);
+    }
+    free(b->TextFile);
+    b->TextFile = NULL;
+  }
+  b->Manifest = manifest;
+
+  /* the table is kept less than half full */
+  b->TableSize = 16;
+  while (b->TableSize < 2*manifest->NumberOfEntries)
+  {
+    b->TableSize *= 2;
+  }
+  b->Table = (int *)malloc(sizeof(int)*b->TableSize);
+  mask = b->TableSize - 1;
+  for (j = 0; j <= mask; j++)
+  {
+    b->Table[j] = -1;
+  }
+
+  for (i = 0; i < manifest->NumberOfEntries; i++)
+  {
+    /* if a class is listed twice, then the first one is used */
+    if (manifest->Entries[i].Name == NULL ||
+        findClass(b, manifest->Entries[i].Name) >= 0)
+    {
+      continue;
+    }
+    j = (unsigned int)vtkWrapXMLHash_String(
+      VTK_WRAP_XML_HASH_INIT, manifest->Entries[i].Name);
+    while (b->Table[j & mask] >= 0)
+    {
+      j++;
+    }
+    b->Table[j & mask] = i;
+  }
+}
+
+/* check whether the manifest has the fingerprints of all the classes */
+static int hasFingerprints(DiffBuild *b)
+{
+  int i;
+
+  for (i = 0; i < b->Manifest->NumberOfEntries; i++)
+  {
+    if (b->Manifest->Entries[i].Fingerprint == 0)
+    {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+/* get the fingerprints from the manifest, or by hashing the XML */
+static void fingerprintBuild(DiffBuild *b, int fromManifest)
+{
+  WrapXMLManifest *manifest = b->Manifest;
+  const char *text;
+  size_t n;
+  int i;
+
+  b->Fingerprints =
+    (uint64_t *)malloc(sizeof(uint64_t)*(manifest->NumberOfEntries + 1));
+
+  for (i = 0; i < manifest->NumberOfEntries; i++)
+  {
+    b->Fingerprints[i] = 0;
+    if (fromManifest)
+    {
+      b->Fingerprints[i] = manifest->Entries[i].Fingerprint;
+    }
+    else if (manifest->Entries[i].Name &&
+             findClass(b, manifest->Entries[i].Name) == i)
+    {
+      text = classText(b, i, &n);
+      b->Fingerprints[i] = (text ?
+        hashElement(VTK_WRAP_XML_HASH_INIT, text, text + n) : 0);
+    }
+  }
+}
+
+static void freeBuild(DiffBuild *b)
+{
+  vtkWrapXMLManifest_Free(b->Manifest);
+  free(b->Directory);
+  free(b->Fingerprints);
+  free(b->Table);
+  free(b->TextFile);
+  free(b->Text);
+}
+
+/*-------------------------------------------------------------------
+ * compare two builds */
+
+static void printMember(FILE *fp, int c, const DiffMember *m)
+{
+  fprintf(fp, "  %c ", c);
+  if (m->IsEnumValue)
+  {
+    fputs("enum value", fp);
+  }
+  else
+  {
+    fwrite(m->Kind, 1, m->KindLength, fp);
+  }
+  fputc(' ', fp);
+  printText(fp, m->Key, m->KeyLength);
+  fputc('\n', fp);
+}
+
+/* compare the members of a class that has changed */
+static void diffClass(
+  FILE *fp, DiffBuild *oldBuild, int i, DiffBuild *newBuild, int j)
+{
+  const char *text;
+  DiffMember *oldMembers;
+  DiffMember *newMembers;
+  int oldCount, newCount;
+  size_t n;
+  int k, l;
+
+  text = classText(oldBuild, i, &n);
+  oldCount = getMembers(text, n, &oldMembers);
+  text = classText(newBuild, j, &n);
+  newCount = getMembers(text, n, &newMembers);
+
+  fprintf(fp, "~ class %s\n", newBuild->Manifest->Entries[j].Name);
+
+  for (l = 0; l < newCount; l++)
+  {
+    for (k = 0; k < oldCount; k++)
+    {
+      if (!oldMembers[k].Matched &&
+          oldMembers[k].KeyHash == newMembers[l].KeyHash)
+      {
+        oldMembers[k].Matched = 1;
+        newMembers[l].Matched = 1;
+        if (oldMembers[k].Hash != newMembers[l].Hash)
+        {
+          newMembers[l].Matched = 2;
+        }
+        break;
+      }
+    }
+  }
+
+  for (k = 0; k < oldCount; k++)
+  {
+    if (!oldMembers[k].Matched)
+    {
+      printMember(fp, '-', &oldMembers[k]);
+    }
+  }
+  for (l = 0; l < newCount; l++)
+  {
+    if (newMembers[l].Matched != 1)
+    {
+      printMember(fp, (newMembers[l].Matched ? '~' : '+'), &newMembers[l]);
+    }
+  }
+
+  free(oldMembers);
+  free(newMembers);
+}
+
+static int diffBuilds(FILE *fp, DiffBuild *oldBuild, DiffBuild *newBuild)
+{
+  WrapXMLManifestEntry *e;
+  int differences = 0;
+  int i, j;
+
+  for (i = 0; i < oldBuild->Manifest->NumberOfEntries; i++)
+  {
+    e = &oldBuild->Manifest->Entries[i];
+    if (e->Name && findClass(oldBuild, e->Name) == i &&
+        findClass(newBuild, e->Name) < 0)
+    {
+      fprintf(fp, "- class %s\n", e->Name);
+      differences++;
+    }
+  }
+
+  for (j = 0; j < newBuild->Manifest->NumberOfEntries; j++)
+  {
+    e = &newBuild->Manifest->Entries[j];
+    if (e->Name == NULL || findClass(newBuild, e->Name) != j)
+    {
+      continue;
+    }
+    i = findClass(oldBuild, e->Name);
+    if (i < 0)
+    {
+      fprintf(fp, "+ class %s\n", e->Name);
+      differences++;
+    }
+    else if (oldBuild->Fingerprints[i] != newBuild->Fingerprints[j])
+    {
+      diffClass(fp, oldBuild, i, newBuild, j);
+      differences++;
+    }
+  }
+
+  return differences;
+}
+
+int main(int argc, char *argv[])
+{
+  DiffBuild oldBuild;
+  DiffBuild newBuild;
+  const char *outputFile = NULL;
+  FILE *fp = stdout;
+  int fromManifest;
+  int differences;
+  int i;
+
+  /* get the options, they must precede the builds */
+  for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++)
+  {
+    if (strcmp(argv[i], "-o") == 0 && i + 1 < argc)
+    {
+      outputFile = argv[++i];
+    }
+    else
+    {
+      vtkWrapXMLDiff_Usage();
+    }
+  }
+
+  if (argc - i != 2)
+  {
+    vtkWrapXMLDiff_Usage();
+  }
+
+  loadBuild(&oldBuild, argv[i]);
+  loadBuild(&newBuild, argv[i + 1]);
+
+  /* the API fingerprints that vtkWrapXML puts in the manifests are
+     used if both builds have them, otherwise the XML must be read */
+  fromManifest = (hasFingerprints(&oldBuild) && hasFingerprints(&newBuild));
+  fingerprintBuild(&oldBuild, fromManifest);
+  fingerprintBuild(&newBuild, fromManifest);
+
+  if (outputFile && strcmp(outputFile, "-") != 0)
+  {
+    fp = fopen(outputFile, "w");
+    if (fp == NULL)
+    {
+      fprintf(stderr, "vtkWrapXMLDiff: cannot write %s\n", outputFile);
+      exit(2);
+    }
+  }
+
+  differences = diffBuilds(fp, &oldBuild, &newBuild);
+
+  if (fp != stdout)
+  {
+    fclose(fp);
+  }
+
+  freeBuild(&oldBuild);
+  freeBuild(&newBuild);
+
+  return (differences != 0);
+}
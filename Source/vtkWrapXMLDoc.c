@@ -0,0 +1,667 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLDoc.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLDoc.h"
+#include <ctype.h>
+#include <string.h>
+
+/* the part of the comment that lines are added to */
+#define DOC_DETAILS 0
+#define DOC_BRIEF 1
+#define DOC_PARAM 2
+#define DOC_RETURN 3
+#define DOC_SEEALSO 4
+#define DOC_SECTION 5
+
+/* text that is being collected */
+typedef struct _doc_text
+{
+  char *text;
+  size_t length;
+  size_t size;
+} doc_text_t;
+
+/* the state of the parser */
+typedef struct _doc_parser
+{
+  WrapXMLDoc *doc;
+  WrapXMLArena *arena;
+  doc_text_t brief;
+  doc_text_t details;
+  doc_text_t ret;
+  doc_text_t *params; /* the text for doc->ParamNames */
+  doc_text_t *sections; /* the text for doc->SectionTitles */
+  int target; /* the part that lines go to */
+  int block; /* DOC_DETAILS or DOC_SECTION, for after a paragraph */
+  int inCode; /* set within @code or @verbatim */
+  size_t indent; /* the indentation that is removed from each line */
+} doc_parser_t;
+
+/*-------------------------------------------------------------------
+ * whitespace, tolerating non-ascii characters */
+
+static int isSpace(int c)
+{
+  return ((c & 0x80) == 0 && isspace(c));
+}
+
+static int isAlpha(int c)
+{
+  return ((c & 0x80) == 0 && isalpha(c));
+}
+
+/*-------------------------------------------------------------------
+ * grow an array when its size reaches a power of two */
+
+static void *growArray(
+  WrapXMLArena *arena, void *array, int n, size_t itemSize)
+{
+  void *newArray;
+
+  if (n == 0 || (n & (n - 1)) == 0)
+  {
+    newArray = vtkWrapXMLArena_Alloc(arena, itemSize*(n == 0 ? 4 : 2*n));
+    if (n > 0)
+    {
+      memcpy(newArray, array, itemSize*n);
+    }
+    return newArray;
+  }
+
+  return array;
+}
+
+/*-------------------------------------------------------------------
+ * copy part of a string into the arena */
+
+static const char *copyString(WrapXMLArena *arena, const char *cp, size_t n)
+{
+  char *text = (char *)vtkWrapXMLArena_Alloc(arena, n + 1);
+
+  memcpy(text, cp, n);
+  text[n] = '\0';
+
+  return text;
+}
+
+/*-------------------------------------------------------------------
+ * add a line to some text, blank lines at the start are dropped */
+
+static void appendLine(
+  WrapXMLArena *arena, doc_text_t *t, const char *line, size_t n)
+{
+  char *text;
+  size_t size;
+
+  if (t->length == 0 && n == 0)
+  {
+    return;
+  }
+
+  if (t->length + n + 2 > t->size)
+  {
+    size = 2*t->size;
+    if (size < t->length + n + 2)
+    {
+      size = t->length + n + 2;
+    }
+    if (size < 64)
+    {
+      size = 64;
+    }
+    text = (char *)vtkWrapXMLArena_Alloc(arena, size);
+    if (t->length > 0)
+    {
+      memcpy(text, t->text, t->length);
+    }
+    t->text = text;
+    t->size = size;
+  }
+
+  if (t->length > 0)
+  {
+    t->text[t->length++] = '\n';
+  }
+  memcpy(&t->text[t->length], line, n);
+  t->length += n;
+  t->text[t->length] = '\0';
+}
+
+/*-------------------------------------------------------------------
+ * get the collected text without trailing whitespace, or NULL */
+
+static const char *finishText(doc_text_t *t)
+{
+  while (t->length > 0 && isSpace(t->text[t->length - 1]))
+  {
+    t->text[--t->length] = '\0';
+  }
+
+  return (t->length > 0 ? t->text : NULL);
+}
+
+/*-------------------------------------------------------------------
+ * get the text that lines are being added to */
+
+static doc_text_t *targetText(doc_parser_t *parser)
+{
+  switch (parser->target)
+  {
+    case DOC_BRIEF:
+      return &parser->brief;
+    case DOC_PARAM:
+      return &parser->params[parser->doc->NumberOfParams - 1];
+    case DOC_RETURN:
+      return &parser->ret;
+    case DOC_SECTION:
+      return &parser->sections[parser->doc->NumberOfSections - 1];
+  }
+
+  return &parser->details;
+}
+
+/*-------------------------------------------------------------------
+ * start a new parameter or section */
+
+static void addParam(doc_parser_t *parser, const char *name, size_t n)
+{
+  WrapXMLDoc *doc = parser->doc;
+  int i = doc->NumberOfParams;
+
+  doc->ParamNames = (const char **)growArray(
+    parser->arena, (void *)doc->ParamNames, i, sizeof(char *));
+  parser->params = (doc_text_t *)growArray(
+    parser->arena, parser->params, i, sizeof(doc_text_t));
+  doc->ParamNames[i] = copyString(parser->arena, name, n);
+  memset(&parser->params[i], 0, sizeof(doc_text_t));
+  doc->NumberOfParams++;
+  parser->target = DOC_PARAM;
+}
+
+static void addSection(doc_parser_t *parser, const char *title, size_t n)
+{
+  WrapXMLDoc *doc = parser->doc;
+  int i = doc->NumberOfSections;
+
+  while (n > 0 && (isSpace(title[n-1]) || title[n-1] == ':'))
+  {
+    n--;
+  }
+
+  doc->SectionTitles = (const char **)growArray(
+    parser->arena, (void *)doc->SectionTitles, i, sizeof(char *));
+  parser->sections = (doc_text_t *)growArray(
+    parser->arena, parser->sections, i, sizeof(doc_text_t));
+  doc->SectionTitles[i] = copyString(parser->arena, title, n);
+  memset(&parser->sections[i], 0, sizeof(doc_text_t));
+  doc->NumberOfSections++;
+  parser->target = DOC_SECTION;
+  parser->block = DOC_SECTION;
+}
+
+/*-------------------------------------------------------------------
+ * add the names in a line to the see-also list */
+
+static void addSeeAlso(doc_parser_t *parser, const char *cp, size_t l)
+{
+  WrapXMLDoc *doc = parser->doc;
+  size_t i, j;
+
+  i = 0;
+  for (;;)
+  {
+    while (i < l && (isSpace(cp[i]) || cp[i] == ','))
+    {
+      i++;
+    }
+    if (i == l)
+    {
+      break;
+    }
+    j = i;
+    while (j < l && !isSpace(cp[j]) && cp[j] != ',')
+    {
+      j++;
+    }
+    doc->SeeAlso = (const char **)growArray(
+      parser->arena, (void *)doc->SeeAlso, doc->NumberOfSeeAlso,
+      sizeof(char *));
+    doc->SeeAlso[doc->NumberOfSeeAlso++] =
+      copyString(parser->arena, &cp[i], j - i);
+    i = j;
+  }
+}
+
+/*-------------------------------------------------------------------
+ * skip whitespace within a line */
+
+static size_t skipSpace(const char *cp, size_t i, size_t l)
+{
+  while (i < l && isSpace(cp[i]))
+  {
+    i++;
+  }
+  return i;
+}
+
+/*-------------------------------------------------------------------
+ * check for a command, and return the length of its name */
+
+static size_t commandLength(const char *cp, size_t l)
+{
+  size_t n = 0;
+
+  if (l > 1 && (cp[0] == '@' || cp[0] == '\\'))
+  {
+    n = 1;
+    while (n < l && isAlpha(cp[n]))
+    {
+      n++;
+    }
+  }
+
+  return (n > 1 ? n - 1 : 0);
+}
+
+static int isCommand(const char *cp, size_t n, const char *name)
+{
+  return (strlen(name) == n && strncmp(cp, name, n) == 0);
+}
+
+/*-------------------------------------------------------------------
+ * handle a ".SECTION" line */
+
+static void sectionLine(doc_parser_t *parser, const char *cp, size_t l)
+{
+  size_t i = skipSpace(cp, 8, l);
+
+  if (l - i >= 11 && strncmp(&cp[i], "Description", 11) == 0)
+  {
+    /* this is the main text */
+    parser->target = DOC_DETAILS;
+    parser->block = DOC_DETAILS;
+  }
+  else if (l - i >= 8 && (strncmp(&cp[i], "See also", 8) == 0 ||
+                          strncmp(&cp[i], "See Also", 8) == 0))
+  {
+    parser->target = DOC_SEEALSO;
+  }
+  else
+  {
+    addSection(parser, &cp[i], l - i);
+  }
+}
+
+/*-------------------------------------------------------------------
+ * handle a line that starts with a command, returns zero if the
+ * command is not one that starts a part of the comment */
+
+static int commandLine(doc_parser_t *parser, const char *cp, size_t l)
+{
+  size_t n = commandLength(cp, l);
+  const char *name = &cp[1];
+  size_t i = n + 1;
+  size_t j;
+
+  if (isCommand(name, n, "brief") || isCommand(name, n, "short"))
+  {
+    parser->target = DOC_BRIEF;
+  }
+  else if (isCommand(name, n, "param") || isCommand(name, n, "tparam"))
+  {
+    /* skip the direction, e.g. [in] or [out] */
+    if (i < l && cp[i] == '[')
+    {
+      while (i < l && cp[i] != ']')
+      {
+        i++;
+      }
+      i += (i < l);
+    }
+    i = skipSpace(cp, i, l);
+    j = i;
+    while (j < l && !isSpace(cp[j]))
+    {
+      j++;
+    }
+    addParam(parser, &cp[i], j - i);
+    i = j;
+  }
+  else if (isCommand(name, n, "return") || isCommand(name, n, "returns") ||
+           isCommand(name, n, "result"))
+  {
+    parser->target = DOC_RETURN;
+  }
+  else if (isCommand(name, n, "sa") || isCommand(name, n, "see"))
+  {
+    parser->target = DOC_SEEALSO;
+  }
+  else if (isCommand(name, n, "section") ||
+           isCommand(name, n, "subsection"))
+  {
+    /* skip the section id, the title follows it */
+    i = skipSpace(cp, i, l);
+    while (i < l && !isSpace(cp[i]))
+    {
+      i++;
+    }
+    i = skipSpace(cp, i, l);
+    addSection(parser, &cp[i], l - i);
+    return 1;
+  }
+  else if (isCommand(name, n, "par"))
+  {
+    i = skipSpace(cp, i, l);
+    addSection(parser, &cp[i], l - i);
+    return 1;
+  }
+  else if (isCommand(name, n, "class") || isCommand(name, n, "struct") ||
+           isCommand(name, n, "union") || isCommand(name, n, "file") ||
+           isCommand(name, n, "interface") ||
+           isCommand(name, n, "namespace"))
+  {
+    /* these name the item that the comment is for */
+    parser->target = parser->block;
+    return 1;
+  }
+  else
+  {
+    return 0;
+  }
+
+  /* the rest of the line goes into the new part */
+  i = skipSpace(cp, i, l);
+  if (parser->target == DOC_SEEALSO)
+  {
+    addSeeAlso(parser, &cp[i], l - i);
+  }
+  else if (i < l)
+  {
+    appendLine(parser->arena, targetText(parser), &cp[i], l - i);
+  }
+
+  return 1;
+}
+
+/*-------------------------------------------------------------------
+ * handle one line of a comment */
+
+static void parseLine(doc_parser_t *parser, const char *line, size_t l)
+{
+  const char *cp;
+  size_t i, n;
+
+  /* remove the indentation that all lines share */
+  i = 0;
+  while (i < l && i < parser->indent && isSpace(line[i]))
+  {
+    i++;
+  }
+  line += i;
+  l -= i;
+
+  i = skipSpace(line, 0, l);
+  cp = &line[i];
+  n = commandLength(cp, l - i);
+
+  if (parser->inCode)
+  {
+    if ((n > 0 && (isCommand(&cp[1], n, "endcode") ||
+                   isCommand(&cp[1], n, "endverbatim"))))
+    {
+      parser->inCode = 0;
+    }
+    appendLine(parser->arena, targetText(parser), line, l);
+    return;
+  }
+
+  if (i == l)
+  {
+    /* a blank line ends a paragraph */
+    if (parser->target != DOC_DETAILS && parser->target != DOC_SECTION)
+    {
+      parser->target = parser->block;
+    }
+    else
+    {
+      appendLine(parser->arena, targetText(parser), line, 0);
+    }
+    return;
+  }
+
+  if (l - i >= 8 && strncmp(cp, ".SECTION", 8) == 0)
+  {
+    sectionLine(parser, cp, l - i);
+    return;
+  }
+
+  if (n > 0 && commandLine(parser, cp, l - i))
+  {
+    return;
+  }
+
+  if (n > 0 && (isCommand(&cp[1], n, "code") ||
+                isCommand(&cp[1], n, "verbatim")))
+  {
+    parser->inCode = 1;
+  }
+
+  if (parser->target == DOC_SEEALSO)
+  {
+    addSeeAlso(parser, cp, l - i);
+  }
+  else if (parser->target == DOC_DETAILS || parser->target == DOC_SECTION)
+  {
+    appendLine(parser->arena, targetText(parser), line, l);
+  }
+  else if (n > 0 || parser->inCode)
+  {
+    /* other commands, like @note, start a new paragraph */
+    parser->target = parser->block;
+    appendLine(parser->arena, targetText(parser), line, l);
+  }
+  else
+  {
+    appendLine(parser->arena, targetText(parser), cp, l - i);
+  }
+}
+
+/*-------------------------------------------------------------------
+ * handle all lines of some text */
+
+static void parseText(doc_parser_t *parser, const char *text)
+{
+  size_t i, j, k;
+
+  /* find the indentation that all non-blank lines share */
+  parser->indent = (size_t)-1;
+  for (i = 0; text[i] != '\0'; i = k)
+  {
+    for (j = i; text[j] == ' ' || text[j] == '\t'; j++) { }
+    for (k = j; text[k] != '\0' && text[k] != '\n'; k++) { }
+    if (k > j && !(k == j + 1 && text[j] == '\r') && j - i < parser->indent)
+    {
+      parser->indent = j - i;
+    }
+    k += (text[k] == '\n');
+  }
+
+  for (i = 0; text[i] != '\0'; i = k)
+  {
+    for (j = i; text[j] != '\0' && text[j] != '\n'; j++) { }
+    k = j + (text[j] == '\n');
+    while (j > i && isSpace(text[j-1]))
+    {
+      j--;
+    }
+    parseLine(parser, &text[i], j - i);
+  }
+}
+
+/*-------------------------------------------------------------------
+ * set up the parser */
+
+static void initParser(
+  doc_parser_t *parser, WrapXMLDoc *doc, WrapXMLArena *arena)
+{
+  memset(doc, 0, sizeof(WrapXMLDoc));
+  memset(parser, 0, sizeof(doc_parser_t));
+  parser->doc = doc;
+  parser->arena = arena;
+  parser->target = DOC_DETAILS;
+  parser->block = DOC_DETAILS;
+}
+
+/*-------------------------------------------------------------------
+ * store the collected text in the doc */
+
+static void finishParser(doc_parser_t *parser)
+{
+  WrapXMLDoc *doc = parser->doc;
+  int i;
+
+  doc->Brief = finishText(&parser->brief);
+  doc->Details = finishText(&parser->details);
+  doc->Return = finishText(&parser->ret);
+
+  if (doc->NumberOfParams > 0)
+  {
+    doc->ParamText = (const char **)vtkWrapXMLArena_Alloc(
+      parser->arena, sizeof(char *)*doc->NumberOfParams);
+  }
+  for (i = 0; i < doc->NumberOfParams; i++)
+  {
+    doc->ParamText[i] = finishText(&parser->params[i]);
+  }
+
+  if (doc->NumberOfSections > 0)
+  {
+    doc->SectionText = (const char **)vtkWrapXMLArena_Alloc(
+      parser->arena, sizeof(char *)*doc->NumberOfSections);
+  }
+  for (i = 0; i < doc->NumberOfSections; i++)
+  {
+    doc->SectionText[i] = finishText(&parser->sections[i]);
+  }
+}
+
+/*-------------------------------------------------------------------
+ * split a doxygen comment */
+
+void vtkWrapXMLDoc_Parse(
+  WrapXMLDoc *doc, const char *comment, WrapXMLArena *arena)
+{
+  doc_parser_t parser;
+
+  initParser(&parser, doc, arena);
+  if (comment)
+  {
+    parseText(&parser, comment);
+  }
+  finishParser(&parser);
+}
+
+/*-------------------------------------------------------------------
+ * split the documentation of a file */
+
+void vtkWrapXMLDoc_ParseFile(
+  WrapXMLDoc *doc, const FileInfo *data, WrapXMLArena *arena)
+{
+  doc_parser_t parser;
+  const char *cp;
+  const char *name;
+  const char *rest;
+  size_t n;
+
+  initParser(&parser, doc, arena);
+
+  if (data->NameComment)
+  {
+    cp = data->NameComment;
+    while (*cp == ' ')
+    {
+      cp++;
+    }
+    appendLine(arena, &parser.brief, cp, strlen(cp));
+  }
+
+  if (data->Description)
+  {
+    parseText(&parser, data->Description);
+  }
+
+  if (data->Caveats && data->Caveats[0] != '\0')
+  {
+    addSection(&parser, "Caveats", 7);
+    parseText(&parser, data->Caveats);
+  }
+
+  if (data->SeeAlso && data->SeeAlso[0] != '\0')
+  {
+    parser.target = DOC_SEEALSO;
+    cp = data->SeeAlso;
+    while ((name = vtkWrapXMLDoc_NextSeeAlso(data->SeeAlso, &cp, &n, &rest)))
+    {
+      addSeeAlso(&parser, name, n);
+    }
+    if (rest)
+    {
+      parseText(&parser, rest);
+    }
+  }
+
+  finishParser(&parser);
+}
+
+/*-------------------------------------------------------------------
+ * get the next name from a VTK-style see-also section */
+
+const char *vtkWrapXMLDoc_NextSeeAlso(
+  const char *text, const char **cpp, size_t *n, const char **rest)
+{
+  const char *cp = *cpp;
+
+  *rest = NULL;
+  *n = 0;
+
+  while (isSpace(*cp))
+  {
+    cp++;
+  }
+  if (*cp == '\0')
+  {
+    *cpp = cp;
+    return NULL;
+  }
+
+  /* there might be another section in the See also */
+  if (strncmp(cp, ".SECTION", 8) == 0)
+  {
+    while (cp > text && isSpace(cp[-1]) && cp[-1] != '\n')
+    {
+      cp--;
+    }
+    *rest = cp;
+    *cpp = cp + strlen(cp);
+    return NULL;
+  }
+
+  while (cp[*n] != '\0' && !isSpace(cp[*n]))
+  {
+    (*n)++;
+  }
+  *cpp = cp + *n;
+
+  return cp;
+}
@@ -0,0 +1,85 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLDoc.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file splits documentation comments into their parts, so that
+ * the parts can be written as separate elements and the readers of the
+ * XML do not have to parse the comments themselves.
+ *
+ * The doxygen commands @brief, @param, @return, @sa and @see, @section
+ * and @par are recognized, with either "@" or "\" before the command,
+ * as are the ".SECTION" lines of old VTK headers.  All other text goes
+ * into the details, and nothing is recognized within @code or
+ * @verbatim blocks.  The strings are allocated from the arena.
+ */
+
+#ifndef VTK_WRAP_XML_DOC_H
+#define VTK_WRAP_XML_DOC_H
+
+#include "vtkParseData.h"
+#include "vtkWrapXMLArena.h"
+#include <stddef.h>
+
+/**
+ * The parts of a comment, each part is NULL or empty if not present
+ */
+typedef struct _WrapXMLDoc
+{
+  const char   *Brief;             /* the brief description */
+  const char   *Details;           /* the text that is in no other part */
+  const char   *Return;            /* the description of the return value */
+  int           NumberOfParams;
+  const char  **ParamNames;        /* the name of each parameter */
+  const char  **ParamText;         /* the description of each parameter */
+  int           NumberOfSections;
+  const char  **SectionTitles;     /* the title of each section */
+  const char  **SectionText;       /* the text of each section */
+  int           NumberOfSeeAlso;
+  const char  **SeeAlso;           /* the names in the see-also list */
+} WrapXMLDoc;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Split a doxygen comment into its parts
+ */
+void vtkWrapXMLDoc_Parse(
+  WrapXMLDoc *doc, const char *comment, WrapXMLArena *arena);
+
+/**
+ * Split the VTK-style documentation of a file into its parts: the
+ * .NAME is the brief description, the description is the details, and
+ * the caveats are a section.
+ */
+void vtkWrapXMLDoc_ParseFile(
+  WrapXMLDoc *doc, const FileInfo *data, WrapXMLArena *arena);
+
+/**
+ * Get the next name from a VTK-style "See also" section, which is a
+ * list of names separated by whitespace.  The position "cp" is moved
+ * past the name, and the length of the name is returned in "n".  At
+ * the end of the list, NULL is returned.  If the list is ended by
+ * another ".SECTION", then "rest" is set to the start of its line,
+ * otherwise "rest" is set to NULL.
+ */
+const char *vtkWrapXMLDoc_NextSeeAlso(
+  const char *text, const char **cp, size_t *n, const char **rest);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,328 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLFingerprints.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLFingerprints.h"
+#include "vtkWrapXMLHash.h"
+#include <string.h>
+
+/*-------------------------------------------------------------------
+ * initialize the table */
+
+void vtkWrapXMLFingerprints_Init(
+  WrapXMLFingerprints *prints, WrapXMLSignatures *sigs,
+  WrapXMLCache *cache, WrapXMLArena *arena)
+{
+  memset(prints, 0, sizeof(WrapXMLFingerprints));
+  prints->Signatures = sigs;
+  prints->Cache = cache;
+  prints->Arena = arena;
+}
+
+/*-------------------------------------------------------------------
+ * find a class in the table, or add it, the arrays grow in powers of
+ * two and a file seldom has more than a few classes */
+
+static int findClass(WrapXMLFingerprints *prints, ClassInfo *classInfo)
+{
+  void *mem;
+  int n = prints->NumberOfClasses;
+  int i;
+
+  for (i = 0; i < n; i++)
+  {
+    if (prints->Classes[i] == classInfo)
+    {
+      return i;
+    }
+  }
+
+  if (n == 0 || (n >= 8 && (n & (n - 1)) == 0))
+  {
+    i = (n == 0 ? 8 : 2*n);
+    mem = vtkWrapXMLArena_Alloc(prints->Arena, sizeof(ClassInfo *)*i);
+    if (n)
+    {
+      memcpy(mem, prints->Classes, sizeof(ClassInfo *)*n);
+    }
+    prints->Classes = (ClassInfo **)mem;
+    mem = vtkWrapXMLArena_Alloc(prints->Arena, sizeof(ClassProperties *)*i);
+    if (n)
+    {
+      memcpy(mem, prints->Properties, sizeof(ClassProperties *)*n);
+    }
+    prints->Properties = (ClassProperties **)mem;
+    mem = vtkWrapXMLArena_Alloc(prints->Arena, sizeof(uint64_t)*i);
+    if (n)
+    {
+      memcpy(mem, prints->Values, sizeof(uint64_t)*n);
+    }
+    prints->Values = (uint64_t *)mem;
+  }
+
+  prints->Classes[n] = classInfo;
+  prints->Properties[n] = NULL;
+  prints->Values[n] = 0;
+  prints->NumberOfClasses = n + 1;
+
+  return n;
+}
+
+/*-------------------------------------------------------------------
+ * hash the parts of the API */
+
+static uint64_t hashFingerprint(uint64_t h, uint64_t value)
+{
+  h = vtkWrapXMLHash_Int(h, (unsigned int)(value & 0xffffffffu));
+  return vtkWrapXMLHash_Int(h, (unsigned int)(value >> 32));
+}
+
+static uint64_t hashValue(uint64_t h, ValueInfo *val)
+{
+  h = vtkWrapXMLHash_Int(h, val->ItemType);
+  h = vtkWrapXMLHash_Int(h, val->Access);
+  h = vtkWrapXMLHash_String(h, val->Name);
+  h = vtkWrapXMLHash_Int(h, val->Type);
+  h = vtkWrapXMLHash_String(h, val->Class);
+  h = vtkWrapXMLHash_Int(h, (unsigned int)val->Count);
+  h = vtkWrapXMLHash_String(h, val->Value);
+  h = vtkWrapXMLHash_Int(h, (unsigned int)val->IsStatic);
+  return vtkWrapXMLHash_Int(h, (unsigned int)val->IsEnum);
+}
+
+static uint64_t hashFunction(
+  WrapXMLFingerprints *prints, uint64_t h, FunctionInfo *func)
+{
+  const char *sig;
+  size_t n;
+
+  /* the rendered signature is the normalized form of the declaration */
+  sig = vtkWrapXMLSignatures_Get(prints->Signatures, func, &n);
+  h = vtkWrapXMLHash_Int(h, func->Access);
+  return vtkWrapXMLHash_Bytes(h, sig, n + 1);
+}
+
+static uint64_t hashEnum(uint64_t h, EnumInfo *item)
+{
+  int i;
+
+  h = vtkWrapXMLHash_Int(h, item->ItemType);
+  h = vtkWrapXMLHash_Int(h, item->Access);
+  h = vtkWrapXMLHash_String(h, item->Name);
+  h = vtkWrapXMLHash_Int(h, (unsigned int)item->NumberOfConstants);
+  for (i = 0; i < item->NumberOfConstants; i++)
+  {
+    h = hashValue(h, item->Constants[i]);
+  }
+
+  return h;
+}
+
+static uint64_t hashProperties(uint64_t h, ClassProperties *properties)
+{
+  PropertyInfo *property;
+  int i;
+
+  h = vtkWrapXMLHash_Int(h, (unsigned int)properties->NumberOfProperties);
+  for (i = 0; i < properties->NumberOfProperties; i++)
+  {
+    property = properties->Properties[i];
+    h = vtkWrapXMLHash_String(h, property->Name);
+    h = vtkWrapXMLHash_Int(h, property->Type);
+    h = vtkWrapXMLHash_Int(h, (unsigned int)property->Count);
+    h = vtkWrapXMLHash_String(h, property->ClassName);
+    h = vtkWrapXMLHash_Int(h, property->PublicMethods);
+    h = vtkWrapXMLHash_Int(h, property->ProtectedMethods);
+    h = vtkWrapXMLHash_Int(h, (unsigned int)property->IsStatic);
+  }
+
+  return h;
+}
+
+/* hash the items of a class or a namespace, in declaration order */
+static uint64_t hashItems(
+  WrapXMLFingerprints *prints, uint64_t h, ClassInfo *data)
+{
+  int i, j;
+
+  h = vtkWrapXMLHash_Int(h, (unsigned int)data->NumberOfItems);
+  for (i = 0; i < data->NumberOfItems; i++)
+  {
+    j = data->Items[i].Index;
+    switch (data->Items[i].Type)
+    {
+      case VTK_VARIABLE_INFO:
+        h = hashValue(h, data->Variables[j]);
+        break;
+      case VTK_CONSTANT_INFO:
+        h = hashValue(h, data->Constants[j]);
+        break;
+      case VTK_TYPEDEF_INFO:
+        h = hashValue(h, data->Typedefs[j]);
+        break;
+      case VTK_ENUM_INFO:
+        h = hashEnum(h, data->Enums[j]);
+        break;
+      case VTK_FUNCTION_INFO:
+        h = hashFunction(prints, h, data->Functions[j]);
+        break;
+      case VTK_USING_INFO:
+        h = vtkWrapXMLHash_Int(h, data->Usings[j]->Access);
+        h = vtkWrapXMLHash_String(h, data->Usings[j]->Name);
+        h = vtkWrapXMLHash_String(h, data->Usings[j]->Scope);
+        break;
+      case VTK_CLASS_INFO:
+      case VTK_STRUCT_INFO:
+      case VTK_UNION_INFO:
+        h = hashFingerprint(
+          h, vtkWrapXMLFingerprints_Class(prints, data->Classes[j]));
+        break;
+      case VTK_NAMESPACE_INFO:
+        h = vtkWrapXMLHash_String(h, data->Namespaces[j]->Name);
+        h = hashItems(prints, h, data->Namespaces[j]);
+        break;
+    }
+  }
+
+  return h;
+}
+
+/*-------------------------------------------------------------------
+ * get the properties and the fingerprint of a class */
+
+ClassProperties *vtkWrapXMLFingerprints_Properties(
+  WrapXMLFingerprints *prints, ClassInfo *classInfo)
+{
+  int i = findClass(prints, classInfo);
+
+  if (prints->Properties[i] == NULL)
+  {
+    if (prints->Cache)
+    {
+      prints->Properties[i] =
+        vtkWrapXMLCache_GetProperties(prints->Cache, classInfo);
+    }
+    if (prints->Properties[i] == NULL)
+    {
+      prints->Properties[i] =
+        vtkParseProperties_CreateInArena(classInfo, prints->Arena);
+    }
+  }
+
+  return prints->Properties[i];
+}
+
+uint64_t vtkWrapXMLFingerprints_Class(
+  WrapXMLFingerprints *prints, ClassInfo *classInfo)
+{
+  ClassProperties *properties;
+  uint64_t h;
+  int i, n;
+
+  i = findClass(prints, classInfo);
+  if (prints->Values[i] != 0)
+  {
+    return prints->Values[i];
+  }
+
+  properties = vtkWrapXMLFingerprints_Properties(prints, classInfo);
+
+  h = VTK_WRAP_XML_HASH_INIT;
+  h = vtkWrapXMLHash_Int(h, classInfo->ItemType);
+  h = vtkWrapXMLHash_Int(h, classInfo->Access);
+  h = vtkWrapXMLHash_String(h, classInfo->Name);
+  h = vtkWrapXMLHash_Int(h, (unsigned int)classInfo->IsAbstract);
+  h = vtkWrapXMLHash_Int(h, (unsigned int)classInfo->IsFinal);
+
+  n = (classInfo->Template ? classInfo->Template->NumberOfParameters : -1);
+  h = vtkWrapXMLHash_Int(h, (unsigned int)n);
+  for (i = 0; i < n; i++)
+  {
+    h = hashValue(h, classInfo->Template->Parameters[i]);
+  }
+
+  h = vtkWrapXMLHash_Int(h, (unsigned int)classInfo->NumberOfSuperClasses);
+  for (i = 0; i < classInfo->NumberOfSuperClasses; i++)
+  {
+    h = vtkWrapXMLHash_String(h, classInfo->SuperClasses[i]);
+  }
+
+  h = hashItems(prints, h, classInfo);
+  h = hashProperties(h, properties);
+
+  /* zero marks a fingerprint that has not been computed */
+  if (h == 0)
+  {
+    h = 1;
+  }
+
+  /* the table might have grown, so find the class again */
+  prints->Values[findClass(prints, classInfo)] = h;
+
+  return h;
+}
+
+/*-------------------------------------------------------------------
+ * add the classes from another table */
+
+void vtkWrapXMLFingerprints_Merge(
+  WrapXMLFingerprints *prints, const WrapXMLFingerprints *other)
+{
+  int i, j;
+
+  for (i = 0; i < other->NumberOfClasses; i++)
+  {
+    j = findClass(prints, other->Classes[i]);
+    if (prints->Properties[j] == NULL)
+    {
+      prints->Properties[j] = other->Properties[i];
+    }
+    if (prints->Values[j] == 0)
+    {
+      prints->Values[j] = other->Values[i];
+    }
+  }
+}
+
+/*-------------------------------------------------------------------
+ * get the fingerprint of a file, the file name does not contribute
+ * so the fingerprint does not depend on where the header is */
+
+uint64_t vtkWrapXMLFingerprints_File(
+  WrapXMLFingerprints *prints, FileInfo *data)
+{
+  uint64_t h = VTK_WRAP_XML_HASH_INIT;
+
+  if (data->Contents)
+  {
+    h = hashItems(prints, h, data->Contents);
+  }
+
+  return h;
+}
+
+/*-------------------------------------------------------------------
+ * write a fingerprint as text */
+
+void vtkWrapXMLFingerprints_ToString(uint64_t value, char *text)
+{
+  static const char digits[] = "0123456789abcdef";
+  int i;
+
+  for (i = 15; i >= 0; i--)
+  {
+    text[i] = digits[value & 0xf];
+    value >>= 4;
+  }
+  text[16] = '\0';
+}
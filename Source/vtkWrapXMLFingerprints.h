@@ -0,0 +1,103 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLFingerprints.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file provides the API fingerprints, which are 64-bit hashes of
+ * the parts of a class that make up its API: the signatures and access
+ * of its methods, the names, types, and method bitfields of its
+ * properties, its enums and constants, its variables and typedefs, its
+ * base classes, and the fingerprints of its nested classes.  Comments
+ * do not contribute.  The fingerprint of a file combines those of its
+ * classes with its other contents, so a single compare says whether
+ * anything in the API of the file has changed.
+ *
+ * The fingerprints of the classes are kept in a table, along with the
+ * properties that were found while computing them, so that the writer
+ * does not have to find the properties a second time.
+ */
+
+#ifndef VTK_WRAP_XML_FINGERPRINTS_H
+#define VTK_WRAP_XML_FINGERPRINTS_H
+
+#include "vtkParseData.h"
+#include "vtkParseProperties.h"
+#include "vtkWrapXMLArena.h"
+#include "vtkWrapXMLCache.h"
+#include "vtkWrapXMLSignatures.h"
+#include <stdint.h>
+
+/**
+ * The fingerprints of the classes in a file
+ */
+typedef struct _WrapXMLFingerprints
+{
+  int                 NumberOfClasses;
+  ClassInfo         **Classes;     /* the classes, in the order computed */
+  ClassProperties   **Properties;  /* the properties of each class */
+  uint64_t           *Values;      /* the fingerprint of each class */
+  WrapXMLSignatures  *Signatures;  /* the signatures of the methods */
+  WrapXMLCache       *Cache;       /* the cached properties, or NULL */
+  WrapXMLArena       *Arena;       /* the memory for the table */
+} WrapXMLFingerprints;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Initialize an empty table.  The cache is optional.
+ */
+void vtkWrapXMLFingerprints_Init(
+  WrapXMLFingerprints *prints, WrapXMLSignatures *sigs,
+  WrapXMLCache *cache, WrapXMLArena *arena);
+
+/**
+ * Get the fingerprint of a file, this also computes the fingerprints
+ * of all of the classes in the file.
+ */
+uint64_t vtkWrapXMLFingerprints_File(
+  WrapXMLFingerprints *prints, FileInfo *data);
+
+/**
+ * Get the fingerprint of a class
+ */
+uint64_t vtkWrapXMLFingerprints_Class(
+  WrapXMLFingerprints *prints, ClassInfo *classInfo);
+
+/**
+ * Get the properties of a class, which are found if the fingerprint
+ * of the class has not been computed yet
+ */
+ClassProperties *vtkWrapXMLFingerprints_Properties(
+  WrapXMLFingerprints *prints, ClassInfo *classInfo);
+
+/**
+ * Add the classes from another table that are not yet in this one, with
+ * their properties and fingerprints.  Nothing is copied, so the other
+ * table's arena must not be reset while this table is in use.
+ */
+void vtkWrapXMLFingerprints_Merge(
+  WrapXMLFingerprints *prints, const WrapXMLFingerprints *other);
+
+/**
+ * Write a fingerprint as 16 hexadecimal digits, "text" must have room
+ * for 17 characters.
+ */
+void vtkWrapXMLFingerprints_ToString(uint64_t value, char *text);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
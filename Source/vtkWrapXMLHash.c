@@ -0,0 +1,65 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLHash.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLHash.h"
+#include <string.h>
+
+#define FNV_PRIME 0x100000001b3ull
+
+/*-------------------------------------------------------------------
+ * hash a block of bytes */
+
+uint64_t vtkWrapXMLHash_Bytes(uint64_t h, const void *data, size_t n)
+{
+  const unsigned char *cp = (const unsigned char *)data;
+  size_t i;
+
+  for (i = 0; i < n; i++)
+  {
+    h ^= cp[i];
+    h *= FNV_PRIME;
+  }
+
+  return h;
+}
+
+/*-------------------------------------------------------------------
+ * hash a string, with its terminator */
+
+uint64_t vtkWrapXMLHash_String(uint64_t h, const char *text)
+{
+  if (text == NULL)
+  {
+    /* use a byte that cannot appear in a string */
+    h ^= 0xff;
+    return h * FNV_PRIME;
+  }
+
+  return vtkWrapXMLHash_Bytes(h, text, strlen(text) + 1);
+}
+
+/*-------------------------------------------------------------------
+ * hash an integer as four little-endian bytes */
+
+uint64_t vtkWrapXMLHash_Int(uint64_t h, unsigned int value)
+{
+  unsigned char bytes[4];
+
+  bytes[0] = (unsigned char)(value & 0xff);
+  bytes[1] = (unsigned char)((value >> 8) & 0xff);
+  bytes[2] = (unsigned char)((value >> 16) & 0xff);
+  bytes[3] = (unsigned char)((value >> 24) & 0xff);
+
+  return vtkWrapXMLHash_Bytes(h, bytes, 4);
+}
@@ -0,0 +1,56 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLHash.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file provides a simple 64-bit hash (FNV-1a) that is used for
+ * cache keys and for content hashing.  The hash is stable across
+ * platforms and runs, so it can be stored in files.
+ */
+
+#ifndef VTK_WRAP_XML_HASH_H
+#define VTK_WRAP_XML_HASH_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * The initial value for a hash
+ */
+#define VTK_WRAP_XML_HASH_INIT 0xcbf29ce484222325ull
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Add a block of bytes to a hash
+ */
+uint64_t vtkWrapXMLHash_Bytes(uint64_t h, const void *data, size_t n);
+
+/**
+ * Add a string to a hash, including its terminator so that adjacent
+ * strings cannot run together.  A NULL string is distinct from "".
+ */
+uint64_t vtkWrapXMLHash_String(uint64_t h, const char *text);
+
+/**
+ * Add an integer to a hash, independent of the byte order
+ */
+uint64_t vtkWrapXMLHash_Int(uint64_t h, unsigned int value);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,301 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLHierarchy.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLHierarchy.h"
+#include "vtkWrapXMLHash.h"
+#include "vtkWrapXMLSystem.h"
+#include <stdlib.h>
+#include <string.h>
+
+#include "vtkWrapXMLAlloc.h"
+
+/*-------------------------------------------------------------------
+ * the length of a type name, without its template arguments */
+
+static size_t nameLength(const char *name, size_t l)
+{
+  size_t n;
+
+  for (n = 0; n < l; n++)
+  {
+    if (name[n] == '<' || name[n] == ' ' || name[n] == '\t' ||
+        name[n] == '\r')
+    {
+      break;
+    }
+  }
+
+  return n;
+}
+
+/*-------------------------------------------------------------------
+ * the index slot for a name */
+
+static unsigned int nameSlot(const char *name, size_t n, unsigned int size)
+{
+  uint64_t h = vtkWrapXMLHash_Bytes(VTK_WRAP_XML_HASH_INIT, name, n);
+
+  return (unsigned int)(h >> 32) & (size - 1);
+}
+
+/*-------------------------------------------------------------------
+ * find the slot for a name, or the empty slot where it would go */
+
+static unsigned int findSlot(
+  const WrapXMLHierarchy *hierarchy, const char *name, size_t n)
+{
+  unsigned int i;
+
+  i = nameSlot(name, n, hierarchy->Size);
+  while (hierarchy->Names[i] &&
+         !(strncmp(hierarchy->Names[i], name, n) == 0 &&
+           hierarchy->Names[i][n] == '\0'))
+  {
+    i = (i + 1) & (hierarchy->Size - 1);
+  }
+
+  return i;
+}
+
+/*-------------------------------------------------------------------
+ * double the size of the index */
+
+static void growIndex(WrapXMLHierarchy *hierarchy)
+{
+  WrapXMLHierarchy old = *hierarchy;
+  unsigned int i, j;
+
+  hierarchy->Size = (old.Size == 0 ? 1024 : 2*old.Size);
+  hierarchy->Names = (const char **)vtkWrapXMLArena_Alloc(
+    hierarchy->Arena, sizeof(char *)*hierarchy->Size);
+  hierarchy->FileIndices = (int *)vtkWrapXMLArena_Alloc(
+    hierarchy->Arena, sizeof(int)*hierarchy->Size);
+
+  for (i = 0; i < old.Size; i++)
+  {
+    if (old.Names[i])
+    {
+      j = findSlot(hierarchy, old.Names[i], strlen(old.Names[i]));
+      hierarchy->Names[j] = old.Names[i];
+      hierarchy->FileIndices[j] = old.FileIndices[i];
+    }
+  }
+}
+
+/*-------------------------------------------------------------------
+ * add the first word of each line of a file to the index */
+
+static void indexFile(WrapXMLHierarchy *hierarchy, int fileIndex)
+{
+  const char *text;
+  char *cp;
+  size_t size, i, j, n;
+  unsigned int k;
+
+  text = vtkWrapXMLSystem_MapFile(hierarchy->FileNames[fileIndex], &size);
+  if (text == NULL)
+  {
+    return;
+  }
+
+  for (i = 0; i < size; i = j + 1)
+  {
+    for (j = i; j < size && text[j] != '\n'; j++) { }
+
+    n = nameLength(&text[i], j - i);
+    if (n == 0)
+    {
+      continue;
+    }
+
+    if ((unsigned int)(2*(hierarchy->Count + 1)) >= hierarchy->Size)
+    {
+      growIndex(hierarchy);
+    }
+
+    /* if a type is in several files, the first file is used */
+    k = findSlot(hierarchy, &text[i], n);
+    if (hierarchy->Names[k] == NULL)
+    {
+      cp = (char *)vtkWrapXMLArena_Alloc(hierarchy->Arena, n + 1);
+      memcpy(cp, &text[i], n);
+      hierarchy->Names[k] = cp;
+      hierarchy->FileIndices[k] = fileIndex;
+      hierarchy->Count++;
+    }
+  }
+
+  vtkWrapXMLSystem_UnmapFile(text, size);
+}
+
+/*-------------------------------------------------------------------
+ * create the index */
+
+WrapXMLHierarchy *vtkWrapXMLHierarchy_New(int n, char **fileNames)
+{
+  WrapXMLHierarchy *hierarchy;
+  int i;
+
+  hierarchy = (WrapXMLHierarchy *)calloc(1, sizeof(WrapXMLHierarchy));
+  hierarchy->Arena = vtkWrapXMLArena_New();
+  hierarchy->Mutex = vtkWrapXMLThreads_NewMutex();
+  hierarchy->NumberOfFiles = n;
+  hierarchy->FileNames = (const char **)vtkWrapXMLArena_Alloc(
+    hierarchy->Arena, sizeof(char *)*(n + 1));
+  hierarchy->Files = (HierarchyInfo **)vtkWrapXMLArena_Alloc(
+    hierarchy->Arena, sizeof(HierarchyInfo *)*(n + 1));
+
+  growIndex(hierarchy);
+  for (i = 0; i < n; i++)
+  {
+    hierarchy->FileNames[i] =
+      vtkWrapXMLArena_StringCopy(hierarchy->Arena, fileNames[i]);
+    indexFile(hierarchy, i);
+  }
+
+  return hierarchy;
+}
+
+/*-------------------------------------------------------------------
+ * find a type, and read its file if necessary */
+
+HierarchyEntry *vtkWrapXMLHierarchy_FindEntry(
+  WrapXMLHierarchy *hierarchy, const char *name)
+{
+  HierarchyEntry *entry = NULL;
+  HierarchyInfo *info;
+  unsigned int k;
+  size_t n;
+  int fileIndex;
+
+  n = nameLength(name, strlen(name));
+  k = findSlot(hierarchy, name, n);
+  if (hierarchy->Names[k] == NULL)
+  {
+    return NULL;
+  }
+  fileIndex = hierarchy->FileIndices[k];
+
+  vtkWrapXMLThreads_Lock(hierarchy->Mutex);
+  info = hierarchy->Files[fileIndex];
+  if (info == NULL)
+  {
+    info = vtkParseHierarchy_ReadFile(hierarchy->FileNames[fileIndex]);
+    hierarchy->Files[fileIndex] = info;
+    hierarchy->NumberOfLoadedFiles += (info != NULL);
+  }
+  if (info)
+  {
+    entry = vtkParseHierarchy_FindEntry(info, name);
+  }
+  vtkWrapXMLThreads_Unlock(hierarchy->Mutex);
+
+  return entry;
+}
+
+/*-------------------------------------------------------------------
+ * get a class and its bases, breadth-first and without repeats */
+
+int vtkWrapXMLHierarchy_BaseClasses(
+  WrapXMLHierarchy *hierarchy, NamespaceInfo *data, ClassInfo *classInfo,
+  const char *className, const char **classNames)
+{
+  const char **superClasses;
+  HierarchyEntry *entry;
+  ClassInfo *local;
+  int i, j, k, m, n;
+
+  classNames[0] = (classInfo ? classInfo->Name : className);
+  n = 1;
+  for (i = 0; i < n; i++)
+  {
+    superClasses = NULL;
+    m = 0;
+    local = (i == 0 ? classInfo : NULL);
+    for (j = 0; local == NULL && data && j < data->NumberOfClasses; j++)
+    {
+      if (data->Classes[j]->Name &&
+          strcmp(data->Classes[j]->Name, classNames[i]) == 0)
+      {
+        local = data->Classes[j];
+      }
+    }
+    if (local)
+    {
+      superClasses = local->SuperClasses;
+      m = local->NumberOfSuperClasses;
+    }
+    else if (hierarchy && (entry = vtkWrapXMLHierarchy_FindEntry(
+               hierarchy, classNames[i])) != NULL)
+    {
+      superClasses = entry->SuperClasses;
+      m = entry->NumberOfSuperClasses;
+    }
+
+    for (j = 0; j < m && n < VTK_WRAP_XML_MAX_BASES; j++)
+    {
+      k = 0;
+      while (k < n && strcmp(classNames[k], superClasses[j]) != 0) { k++; }
+      if (k == n)
+      {
+        classNames[n++] = superClasses[j];
+      }
+    }
+  }
+
+  return n;
+}
+
+/*-------------------------------------------------------------------
+ * check whether a class is derived from vtkObjectBase */
+
+int vtkWrapXMLHierarchy_IsVTKObject(
+  WrapXMLHierarchy *hierarchy, NamespaceInfo *data, const char *className)
+{
+  const char *classNames[VTK_WRAP_XML_MAX_BASES];
+  int i, n;
+
+  n = vtkWrapXMLHierarchy_BaseClasses(
+    hierarchy, data, NULL, className, classNames);
+
+  for (i = 0; i < n; i++)
+  {
+    if (strcmp(classNames[i], "vtkObjectBase") == 0)
+    {
+      return 1;
+    }
+  }
+
+  return 0;
+}
+
+/*-------------------------------------------------------------------
+ * free the index */
+
+void vtkWrapXMLHierarchy_Free(WrapXMLHierarchy *hierarchy)
+{
+  int i;
+
+  for (i = 0; i < hierarchy->NumberOfFiles; i++)
+  {
+    if (hierarchy->Files[i])
+    {
+      vtkParseHierarchy_Free(hierarchy->Files[i]);
+    }
+  }
+
+  vtkWrapXMLThreads_DeleteMutex(hierarchy->Mutex);
+  vtkWrapXMLArena_Delete(hierarchy->Arena);
+  free(hierarchy);
+}
@@ -0,0 +1,104 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLHierarchy.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file provides lookups in the hierarchy files that are given
+ * with "--types".  A module is given the hierarchy files of all of its
+ * dependencies, but a header usually needs only a few of them, so the
+ * files are not read up front.  Instead, the first word of each line
+ * of each file is put into an index, which maps each type name to the
+ * file that has it, and a file is only read by vtkParseHierarchy when
+ * one of its types is looked up.
+ *
+ * The lookups can be done from several threads at once.
+ */
+
+#ifndef VTK_WRAP_XML_HIERARCHY_H
+#define VTK_WRAP_XML_HIERARCHY_H
+
+#include "vtkParseData.h"
+#include "vtkParseHierarchy.h"
+#include "vtkWrapXMLArena.h"
+#include "vtkWrapXMLThreads.h"
+
+/**
+ * The index of the hierarchy files, and the files that have been read
+ */
+typedef struct _WrapXMLHierarchy
+{
+  int              NumberOfFiles;        /* the hierarchy files */
+  const char     **FileNames;            /* the name of each file */
+  HierarchyInfo  **Files;                /* each file, or NULL if unread */
+  int              NumberOfLoadedFiles;  /* the files that were read */
+  unsigned int     Size;                 /* index slots, a power of two */
+  int              Count;                /* the names in the index */
+  const char     **Names;                /* the type name for each slot */
+  int             *FileIndices;          /* the file for each slot */
+  WrapXMLArena    *Arena;                /* the memory for the index */
+  WrapXMLMutex    *Mutex;                /* protects the lazy reads */
+} WrapXMLHierarchy;
+
+/**
+ * The most base classes that are followed for one class, including
+ * the class itself
+ */
+#define VTK_WRAP_XML_MAX_BASES 64
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Create the index for a set of hierarchy files.  Files that cannot
+ * be opened are ignored.
+ */
+WrapXMLHierarchy *vtkWrapXMLHierarchy_New(int n, char **fileNames);
+
+/**
+ * Find the hierarchy entry for a type, reading the file that has it if
+ * it has not been read yet.  Template arguments are ignored.  Returns
+ * NULL if the type is not in any of the files.
+ */
+HierarchyEntry *vtkWrapXMLHierarchy_FindEntry(
+  WrapXMLHierarchy *hierarchy, const char *name);
+
+/**
+ * Get a class and all of its bases, breadth-first and without repeats,
+ * by looking up each base class first in the namespace and then in the
+ * hierarchy files.  The class is given by its info if it is known, or
+ * else by its name.  The hierarchy can be NULL, and then only the
+ * namespace is used.  The "classNames" array must have room for
+ * VTK_WRAP_XML_MAX_BASES names.  Returns the number of names.
+ */
+int vtkWrapXMLHierarchy_BaseClasses(
+  WrapXMLHierarchy *hierarchy, NamespaceInfo *data, ClassInfo *classInfo,
+  const char *className, const char **classNames);
+
+/**
+ * Check whether a class is derived from vtkObjectBase, as far as can be
+ * seen from the namespace and the hierarchy files
+ */
+int vtkWrapXMLHierarchy_IsVTKObject(
+  WrapXMLHierarchy *hierarchy, NamespaceInfo *data, const char *className);
+
+/**
+ * Free the index and all of the files that were read
+ */
+void vtkWrapXMLHierarchy_Free(WrapXMLHierarchy *hierarchy);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
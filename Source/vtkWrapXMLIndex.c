@@ -0,0 +1,305 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLIndex.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ The vtkWrapXMLIndex program merges the manifests that are written by
+ "vtkWrapXML --manifest" into a single manifest.  It is used to make a
+ manifest for each module from the manifests of the headers, and then
+ to make a manifest for all of the modules.  The module name and the
+ directory of the XML files can be set for the classes as they are
+ merged, so that the merged manifest is self-contained.
+
+ With "--update", the existing merged manifest is patched instead of
+ being rewritten.  Each input manifest is a segment of the merged
+ manifest, and only the inputs whose size or modification time have
+ changed are read again.  Their classes are appended as new segments,
+ and tombstones are appended for the old segments and for the inputs
+ that are no longer given.  The merged manifest is compacted, i.e.
+ rewritten without the dead segments, when the dead segments outnumber
+ the live ones or when "--compact" is given.
+*/
+
+#include "vtkWrapXMLInput.h"
+#include "vtkWrapXMLManifest.h"
+#include "vtkWrapXMLSystem.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Print the usage and exit
+ */
+static void vtkWrapXMLIndex_Usage(void)
+{
+  fprintf(stderr,
+    "Usage: vtkWrapXMLIndex -o <manifest> [--module <name>]"
+    " [--prefix <dir>] [--update] [--compact] <manifest>...\n"
+    "  -o <manifest>     the merged manifest, or \"-\" for stdout\n"
+    "  --module <name>   set the module for all classes\n"
+    "  --prefix <dir>    prepend a directory to all file names\n"
+    "  --update          only merge the manifests that have changed\n"
+    "  --compact         remove the dead segments from the manifest\n"
+    "  @<file>           read the manifest names from a file\n");
+  exit(1);
+}
+
+/**
+ * The options and the state of the merge
+ */
+typedef struct _IndexInfo
+{
+  WrapXMLManifest *Output;   /* the merged manifest */
+  const char *Module;        /* the module to set, or NULL */
+  const char *Prefix;        /* the directory to prepend, or NULL */
+  int NumberOfOldSegments;   /* the segments that were read */
+  char *Seen;                /* set for each old segment that was given */
+  int Changed;               /* set if any segments were added */
+} IndexInfo;
+
+/**
+ * Merge one manifest into the output manifest, unless the output
+ * already has an up-to-date segment for it
+ */
+static void vtkWrapXMLIndex_Merge(IndexInfo *info, const char *filename)
+{
+  WrapXMLManifest *output = info->Output;
+  WrapXMLManifest *input;
+  WrapXMLManifestSegment *s;
+  WrapXMLManifestEntry entry;
+  const char *module = info->Module;
+  const char *prefix = info->Prefix;
+  long long mtime = 0;
+  long long size = 0;
+  char *path = NULL;
+  size_t l, m;
+  int i, id;
+
+  vtkWrapXMLSystem_FileStamp(filename, &mtime, &size);
+
+  s = vtkWrapXMLManifest_FindSegment(output, filename);
+  if (s)
+  {
+    i = (int)(s - output->Segments);
+    if (i < info->NumberOfOldSegments)
+    {
+      info->Seen[i] = 1;
+    }
+    if (s->MTime == mtime && s->Size == size)
+    {
+      return;
+    }
+    vtkWrapXMLManifest_RemoveSegment(output, s->Id);
+  }
+
+  input = vtkWrapXMLManifest_New();
+  if (!vtkWrapXMLManifest_Read(input, filename))
+  {
+    fprintf(stderr, "vtkWrapXMLIndex: cannot read manifest %s\n", filename);
+    exit(1);
+  }
+
+  id = vtkWrapXMLManifest_AddSegment(output, filename, mtime, size);
+  info->Changed = 1;
+
+  for (i = 0; i < input->NumberOfEntries; i++)
+  {
+    entry = input->Entries[i];
+    entry.Segment = id;
+    if (module)
+    {
+      entry.Module = module;
+    }
+    if (prefix && entry.File)
+    {
+      l = strlen(prefix);
+      m = strlen(entry.File);
+      path = (char *)realloc(path, l + m + 2);
+      memcpy(path, prefix, l);
+      path[l] = '/';
+      memcpy(&path[l + 1], entry.File, m + 1);
+      entry.File = path;
+    }
+    vtkWrapXMLManifest_AddEntry(output, &entry);
+  }
+
+  free(path);
+  vtkWrapXMLManifest_Free(input);
+}
+
+/**
+ * Merge all the manifests that are listed in a file
+ */
+static void vtkWrapXMLIndex_MergeList(IndexInfo *info, const char *listfile)
+{
+  char *text;
+  char *cp;
+  char *line;
+  size_t n;
+
+  text = vtkWrapXMLInput_ReadAll(listfile, &n);
+  if (text == NULL)
+  {
+    fprintf(stderr, "vtkWrapXMLIndex: cannot read %s\n", listfile);
+    exit(1);
+  }
+
+  for (cp = text; *cp != '\0';)
+  {
+    line = cp;
+    while (*cp != '\n' && *cp != '\r' && *cp != '\0')
+    {
+      cp++;
+    }
+    if (*cp != '\0')
+    {
+      *cp++ = '\0';
+    }
+    if (line[0] != '\0')
+    {
+      vtkWrapXMLIndex_Merge(info, line);
+    }
+  }
+
+  free(text);
+}
+
+int main(int argc, char *argv[])
+{
+  IndexInfo info;
+  WrapXMLManifest *output;
+  WrapXMLManifestSegment *s;
+  const char *outputFile = NULL;
+  int update = 0;
+  int compact = 0;
+  int rewrite;
+  int live, dead;
+  int i, j;
+
+  memset(&info, 0, sizeof(info));
+
+  /* get the options, they must precede the manifests */
+  for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++)
+  {
+    if (strcmp(argv[i], "--update") == 0)
+    {
+      update = 1;
+    }
+    else if (strcmp(argv[i], "--compact") == 0)
+    {
+      compact = 1;
+    }
+    else if (i + 1 >= argc)
+    {
+      vtkWrapXMLIndex_Usage();
+    }
+    else if (strcmp(argv[i], "-o") == 0)
+    {
+      outputFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "--module") == 0)
+    {
+      info.Module = argv[++i];
+    }
+    else if (strcmp(argv[i], "--prefix") == 0)
+    {
+      info.Prefix = argv[++i];
+    }
+    else
+    {
+      vtkWrapXMLIndex_Usage();
+    }
+  }
+
+  if (outputFile == NULL)
+  {
+    vtkWrapXMLIndex_Usage();
+  }
+
+  /* an update starts from the existing manifest, if there is one */
+  output = vtkWrapXMLManifest_New();
+  rewrite = 1;
+  if (update && strcmp(outputFile, "-") != 0)
+  {
+    if (vtkWrapXMLManifest_Read(output, outputFile))
+    {
+      rewrite = 0;
+    }
+    else
+    {
+      vtkWrapXMLManifest_Free(output);
+      output = vtkWrapXMLManifest_New();
+    }
+  }
+
+  info.Output = output;
+  info.NumberOfOldSegments = output->NumberOfSegments;
+  info.Seen = (char *)calloc(info.NumberOfOldSegments + 1, 1);
+
+  for (; i < argc; i++)
+  {
+    if (argv[i][0] == '@')
+    {
+      vtkWrapXMLIndex_MergeList(&info, &argv[i][1]);
+    }
+    else
+    {
+      vtkWrapXMLIndex_Merge(&info, argv[i]);
+    }
+  }
+
+  /* bury the segments of the manifests that were not given */
+  for (j = 0; j < info.NumberOfOldSegments; j++)
+  {
+    s = &output->Segments[j];
+    if (!info.Seen[j] && s->State == VTK_WRAP_XML_SEGMENT_SAVED)
+    {
+      vtkWrapXMLManifest_RemoveSegment(output, s->Id);
+      info.Changed = 1;
+    }
+  }
+  free(info.Seen);
+
+  /* compact the manifest if most of it is dead */
+  live = 0;
+  dead = 0;
+  for (j = 0; j < output->NumberOfSegments; j++)
+  {
+    s = &output->Segments[j];
+    if (s->State == VTK_WRAP_XML_SEGMENT_SAVED ||
+        s->State == VTK_WRAP_XML_SEGMENT_NEW)
+    {
+      live++;
+    }
+    else
+    {
+      dead++;
+    }
+  }
+  if (compact || dead > live)
+  {
+    rewrite = 1;
+  }
+
+  if ((rewrite && !vtkWrapXMLManifest_Write(output, outputFile)) ||
+      (!rewrite && info.Changed &&
+       !vtkWrapXMLManifest_Append(output, outputFile)))
+  {
+    fprintf(stderr, "vtkWrapXMLIndex: cannot write %s\n", outputFile);
+    exit(1);
+  }
+
+  vtkWrapXMLManifest_Free(output);
+
+  return 0;
+}
@@ -0,0 +1,271 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLInput.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLInput.h"
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef VTK_WRAP_XML_USE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef VTK_WRAP_XML_USE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "vtkWrapXMLAlloc.h"
+
+/* the size of the buffer for reading the file */
+#define INPUT_BUFFER_SIZE 65536
+
+/*-------------------------------------------------------------------
+ * read more packed data from the file, returns zero at end of file */
+
+static int fillPacked(WrapXMLInput *in)
+{
+  in->PackedPos = 0;
+  in->PackedEnd = fread(in->Packed, 1, in->PackedSize, in->File);
+
+  return (in->PackedEnd != 0);
+}
+
+/*-------------------------------------------------------------------
+ * open the file and check the magic number */
+
+WrapXMLInput *vtkWrapXMLInput_Open(const char *filename)
+{
+  WrapXMLInput *in;
+  const unsigned char *magic;
+  FILE *fp;
+
+  if (strcmp(filename, "-") == 0)
+  {
+    fp = stdin;
+  }
+  else
+  {
+    fp = fopen(filename, "rb");
+    if (!fp)
+    {
+      return NULL;
+    }
+  }
+
+  in = (WrapXMLInput *)calloc(1, sizeof(WrapXMLInput));
+  in->File = fp;
+  in->PackedSize = INPUT_BUFFER_SIZE;
+  in->Packed = (char *)malloc(in->PackedSize);
+  fillPacked(in);
+
+  /* gzip starts with 1f 8b, and zstd starts with 28 b5 2f fd */
+  magic = (const unsigned char *)in->Packed;
+  if (in->PackedEnd >= 2 && magic[0] == 0x1f && magic[1] == 0x8b)
+  {
+    in->Compression = VTK_WRAP_XML_COMPRESS_GZIP;
+  }
+  else if (in->PackedEnd >= 4 && magic[0] == 0x28 && magic[1] == 0xb5 &&
+           magic[2] == 0x2f && magic[3] == 0xfd)
+  {
+    in->Compression = VTK_WRAP_XML_COMPRESS_ZSTD;
+  }
+
+  switch (in->Compression)
+  {
+#ifdef VTK_WRAP_XML_USE_ZLIB
+    case VTK_WRAP_XML_COMPRESS_GZIP:
+      /* the 32 in the window bits allows a gzip header */
+      in->Stream = calloc(1, sizeof(z_stream));
+      if (inflateInit2((z_stream *)in->Stream, 15 + 32) != Z_OK)
+      {
+        in->Error = 1;
+      }
+      break;
+#endif
+
+#ifdef VTK_WRAP_XML_USE_ZSTD
+    case VTK_WRAP_XML_COMPRESS_ZSTD:
+      in->Stream = ZSTD_createDCtx();
+      if (in->Stream == NULL)
+      {
+        in->Error = 1;
+      }
+      break;
+#endif
+
+    case VTK_WRAP_XML_COMPRESS_NONE:
+      break;
+
+    default:
+      /* compressed with a method that is not available */
+      in->Compression = VTK_WRAP_XML_COMPRESS_NONE;
+      vtkWrapXMLInput_Close(in);
+      return NULL;
+  }
+
+  return in;
+}
+
+/*-------------------------------------------------------------------
+ * read and decompress */
+
+size_t vtkWrapXMLInput_Read(WrapXMLInput *in, char *buffer, size_t n)
+{
+  size_t m = 0;
+  size_t l;
+#ifdef VTK_WRAP_XML_USE_ZLIB
+  z_stream *zs;
+  int zerr;
+#endif
+#ifdef VTK_WRAP_XML_USE_ZSTD
+  ZSTD_inBuffer zin;
+  ZSTD_outBuffer zout;
+  size_t remaining;
+#endif
+
+  while (m < n && !in->Error)
+  {
+    if (in->PackedPos == in->PackedEnd && !fillPacked(in))
+    {
+      break;
+    }
+
+    switch (in->Compression)
+    {
+#ifdef VTK_WRAP_XML_USE_ZLIB
+      case VTK_WRAP_XML_COMPRESS_GZIP:
+        zs = (z_stream *)in->Stream;
+        zs->next_in = (Bytef *)&in->Packed[in->PackedPos];
+        zs->avail_in = (uInt)(in->PackedEnd - in->PackedPos);
+        zs->next_out = (Bytef *)&buffer[m];
+        zs->avail_out = (uInt)(n - m);
+        zerr = inflate(zs, Z_NO_FLUSH);
+        m = n - zs->avail_out;
+        in->PackedPos = in->PackedEnd - zs->avail_in;
+        if (zerr == Z_STREAM_END)
+        {
+          /* there might be another gzip member after this one */
+          inflateReset(zs);
+        }
+        else if (zerr != Z_OK && zerr != Z_BUF_ERROR)
+        {
+          in->Error = 1;
+        }
+        break;
+#endif
+
+#ifdef VTK_WRAP_XML_USE_ZSTD
+      case VTK_WRAP_XML_COMPRESS_ZSTD:
+        zin.src = &in->Packed[in->PackedPos];
+        zin.size = in->PackedEnd - in->PackedPos;
+        zin.pos = 0;
+        zout.dst = &buffer[m];
+        zout.size = n - m;
+        zout.pos = 0;
+        remaining = ZSTD_decompressStream(
+          (ZSTD_DCtx *)in->Stream, &zout, &zin);
+        m += zout.pos;
+        in->PackedPos += zin.pos;
+        if (ZSTD_isError(remaining))
+        {
+          in->Error = 1;
+        }
+        break;
+#endif
+
+      default:
+        l = in->PackedEnd - in->PackedPos;
+        l = (l < n - m ? l : n - m);
+        memcpy(&buffer[m], &in->Packed[in->PackedPos], l);
+        in->PackedPos += l;
+        m += l;
+        break;
+    }
+  }
+
+  return m;
+}
+
+/*-------------------------------------------------------------------
+ * read a whole file into memory */
+
+char *vtkWrapXMLInput_ReadAll(const char *filename, size_t *length)
+{
+  WrapXMLInput *in;
+  char *text;
+  size_t size = INPUT_BUFFER_SIZE;
+  size_t n = 0;
+
+  in = vtkWrapXMLInput_Open(filename);
+  if (in == NULL)
+  {
+    return NULL;
+  }
+
+  text = (char *)malloc(size + 1);
+  for (;;)
+  {
+    n += vtkWrapXMLInput_Read(in, &text[n], size - n);
+    if (n < size)
+    {
+      break;
+    }
+    size *= 2;
+    text = (char *)realloc(text, size + 1);
+  }
+  text[n] = '\0';
+
+  if (!vtkWrapXMLInput_Close(in))
+  {
+    free(text);
+    return NULL;
+  }
+
+  *length = n;
+  return text;
+}
+
+/*-------------------------------------------------------------------
+ * close the file */
+
+int vtkWrapXMLInput_Close(WrapXMLInput *in)
+{
+  int ok = !in->Error;
+
+  switch (in->Compression)
+  {
+#ifdef VTK_WRAP_XML_USE_ZLIB
+    case VTK_WRAP_XML_COMPRESS_GZIP:
+      inflateEnd((z_stream *)in->Stream);
+      free(in->Stream);
+      break;
+#endif
+
+#ifdef VTK_WRAP_XML_USE_ZSTD
+    case VTK_WRAP_XML_COMPRESS_ZSTD:
+      ZSTD_freeDCtx((ZSTD_DCtx *)in->Stream);
+      break;
+#endif
+  }
+
+  ok &= !ferror(in->File);
+  if (in->File != stdin)
+  {
+    fclose(in->File);
+  }
+
+  free(in->Packed);
+  free(in);
+
+  return ok;
+}
@@ -0,0 +1,81 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLInput.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file provides a reader for the files that are written by
+ * vtkWrapXML.  The compression is detected from the first bytes of
+ * the file, so the same code reads ".xml", ".xml.gz", and ".xml.zst"
+ * files, and the text is decompressed as it is read.  Concatenated
+ * gzip members or zstd frames, such as those written by --batch to
+ * stdout, are read as one stream.
+ */
+
+#ifndef VTK_WRAP_XML_INPUT_H
+#define VTK_WRAP_XML_INPUT_H
+
+#include "vtkWrapXMLOutput.h"
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * An input file
+ */
+typedef struct _WrapXMLInput
+{
+  FILE   *File;         /* the file, which is stdin for "-" */
+  int     Compression;  /* one of the VTK_WRAP_XML_COMPRESS constants */
+  void   *Stream;       /* the state of the decompressor */
+  char   *Packed;       /* data that has been read from the file */
+  size_t  PackedPos;    /* the read position in the packed data */
+  size_t  PackedEnd;    /* the end of the packed data */
+  size_t  PackedSize;   /* the size of the packed buffer */
+  int     Error;        /* set if the data is corrupt */
+} WrapXMLInput;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Open a file for reading, the name "-" is used for stdin.  Returns
+ * NULL if the file could not be opened, or if it is compressed with
+ * a method that is not available.
+ */
+WrapXMLInput *vtkWrapXMLInput_Open(const char *filename);
+
+/**
+ * Read up to "n" bytes of text into "buffer".  Returns the number of
+ * bytes read, which is less than "n" only at the end of the file or
+ * if an error occurred.
+ */
+size_t vtkWrapXMLInput_Read(WrapXMLInput *in, char *buffer, size_t n);
+
+/**
+ * Read the whole file into a null-terminated string that must be
+ * freed with free().  The length is returned in "length".  Returns
+ * NULL if an error occurred.
+ */
+char *vtkWrapXMLInput_ReadAll(const char *filename, size_t *length);
+
+/**
+ * Close the file and free the reader.  Returns zero if the data was
+ * corrupt.
+ */
+int vtkWrapXMLInput_Close(WrapXMLInput *in);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,796 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLJSON.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLJSON.h"
+#include "vtkParseProperties.h"
+#include "vtkParseType.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*-------------------------------------------------------------------
+ * The state of the writer, the records themselves need no context */
+
+typedef struct _wrapjson_state
+{
+  WrapXMLOutput *file; /* the file being written to */
+  const char *fileName; /* the header name, without the path */
+  WrapXMLArena *arena; /* memory that is released after each file */
+  WrapXMLSignatures *signatures; /* signatures that have been rendered */
+  WrapXMLFingerprints *fingerprints; /* the API of each class */
+} wrapjson_state_t;
+
+/*-------------------------------------------------------------------
+ * write a string as a JSON string, or as null if the string is NULL,
+ * the prefix is written inside the quotes */
+
+static void jsonPrefixedString(
+  wrapjson_state_t *w, const char *prefix, const char *text)
+{
+  const char *cp;
+  const char *escape;
+  char temp[8];
+
+  if (text == NULL)
+  {
+    vtkWrapXMLOutput_Puts(w->file, "null");
+    return;
+  }
+
+  /* write unchanged characters in runs, between the escapes */
+  vtkWrapXMLOutput_Putc(w->file, '\"');
+  if (prefix)
+  {
+    vtkWrapXMLOutput_Puts(w->file, prefix);
+  }
+  for (cp = text; *cp != '\0'; cp++)
+  {
+    switch (*cp)
+    {
+      case '\"':
+        escape = "\\\"";
+        break;
+      case '\\':
+        escape = "\\\\";
+        break;
+      case '\n':
+        escape = "\\n";
+        break;
+      case '\r':
+        escape = "\\r";
+        break;
+      case '\t':
+        escape = "\\t";
+        break;
+      default:
+        if ((unsigned char)*cp >= 0x20)
+        {
+          continue;
+        }
+        sprintf(temp, "\\u%04x", (unsigned int)(unsigned char)*cp);
+        escape = temp;
+        break;
+    }
+
+    vtkWrapXMLOutput_Write(w->file, text, cp - text);
+    vtkWrapXMLOutput_Puts(w->file, escape);
+    text = cp + 1;
+  }
+  vtkWrapXMLOutput_Write(w->file, text, cp - text);
+  vtkWrapXMLOutput_Putc(w->file, '\"');
+}
+
+static void jsonString(wrapjson_state_t *w, const char *text)
+{
+  jsonPrefixedString(w, NULL, text);
+}
+
+/*-------------------------------------------------------------------
+ * write a key and a string value, preceded by a comma */
+
+static void jsonStringField(
+  wrapjson_state_t *w, const char *key, const char *value)
+{
+  vtkWrapXMLOutput_Printf(w->file, ",\"%s\":", key);
+  jsonString(w, value);
+}
+
+/*-------------------------------------------------------------------
+ * write a key and a string value only if the value is not NULL */
+
+static void jsonOptionalField(
+  wrapjson_state_t *w, const char *key, const char *value)
+{
+  if (value)
+  {
+    jsonStringField(w, key, value);
+  }
+}
+
+/*-------------------------------------------------------------------
+ * write a boolean that is true, since false values are omitted */
+
+static void jsonFlag(wrapjson_state_t *w, const char *key, int value)
+{
+  if (value)
+  {
+    vtkWrapXMLOutput_Printf(w->file, ",\"%s\":true", key);
+  }
+}
+
+/*-------------------------------------------------------------------
+ * get the access level as a string */
+
+static const char *jsonAccess(parse_access_t access)
+{
+  switch (access)
+  {
+    case VTK_ACCESS_PUBLIC:
+      return "public";
+    case VTK_ACCESS_PROTECTED:
+      return "protected";
+    case VTK_ACCESS_PRIVATE:
+      return "private";
+  }
+
+  return "public";
+}
+
+/*-------------------------------------------------------------------
+ * concatenate a scope and a name, e.g. "vtk::detail" and "Name" */
+
+static const char *jsonScopedName(
+  wrapjson_state_t *w, const char *scope, const char *name)
+{
+  size_t l, m;
+  char *cp;
+
+  if (scope == NULL)
+  {
+    return name;
+  }
+  if (name == NULL)
+  {
+    return scope;
+  }
+
+  l = strlen(scope);
+  m = strlen(name);
+  cp = (char *)vtkWrapXMLArena_Alloc(w->arena, l + m + 3);
+  memcpy(cp, scope, l);
+  memcpy(&cp[l], "::", 2);
+  memcpy(&cp[l + 2], name, m);
+
+  return cp;
+}
+
+/*-------------------------------------------------------------------
+ * start a record, with its kind and the file that it came from */
+
+static void jsonRecordStart(wrapjson_state_t *w, const char *kind)
+{
+  vtkWrapXMLOutput_Printf(w->file, "{\"kind\":\"%s\"", kind);
+  jsonStringField(w, "file", w->fileName);
+}
+
+/*-------------------------------------------------------------------
+ * end a record, each record is on its own line */
+
+static void jsonRecordEnd(wrapjson_state_t *w)
+{
+  vtkWrapXMLOutput_Puts(w->file, "}\n");
+}
+
+/*-------------------------------------------------------------------
+ * write a type as an object with the same information as the
+ * type attributes of the XML elements */
+
+static void jsonType(wrapjson_state_t *w, ValueInfo *val)
+{
+  unsigned int type = val->Type;
+  unsigned int attrs = val->Attributes;
+  unsigned int bits;
+  int ndims = val->NumberOfDimensions;
+  char text[128];
+  int i = 0;
+  int j;
+
+  vtkWrapXMLOutput_Puts(w->file, "{\"type\":");
+  jsonPrefixedString(
+    w, ((type & VTK_PARSE_CONST) != 0 ? "const " : NULL), val->Class);
+
+  if ((type & VTK_PARSE_INDIRECT) == VTK_PARSE_BAD_INDIRECT)
+  {
+    jsonStringField(w, "pointer", "unknown");
+  }
+  else
+  {
+    type = (type & VTK_PARSE_POINTER_MASK);
+    if (ndims > 0)
+    {
+      type = ((type >> 2) & VTK_PARSE_POINTER_MASK);
+    }
+
+    while (type && i < 120)
+    {
+      bits = (type & VTK_PARSE_POINTER_LOWMASK);
+      type = ((type >> 2) & VTK_PARSE_POINTER_MASK);
+
+      if (bits == VTK_PARSE_ARRAY)
+      {
+        memcpy(&text[i], "*array", 6);
+        i += 6;
+      }
+      else if (bits == VTK_PARSE_CONST_POINTER)
+      {
+        memcpy(&text[i], "*const", 6);
+        i += 6;
+      }
+      else
+      {
+        text[i++] = '*';
+      }
+    }
+    text[i] = '\0';
+
+    if (i > 0)
+    {
+      jsonStringField(w, "pointer", text);
+    }
+  }
+
+  type = val->Type;
+  if ((type & VTK_PARSE_RVALUE) != 0)
+  {
+    jsonFlag(w, "rvalue_reference", 1);
+  }
+  else if ((type & VTK_PARSE_REF) != 0)
+  {
+    jsonFlag(w, "reference", 1);
+  }
+
+  if (ndims > 0)
+  {
+    vtkWrapXMLOutput_Puts(w->file, ",\"size\":[");
+    for (j = 0; j < ndims; j++)
+    {
+      if (j > 0)
+      {
+        vtkWrapXMLOutput_Putc(w->file, ',');
+      }
+      jsonString(w, val->Dimensions[j]);
+    }
+    vtkWrapXMLOutput_Putc(w->file, ']');
+  }
+
+  jsonFlag(w, "newinstance", (attrs & VTK_PARSE_NEWINSTANCE) != 0);
+  jsonFlag(w, "zerocopy", (attrs & VTK_PARSE_ZEROCOPY) != 0);
+  jsonFlag(w, "filepath", (attrs & VTK_PARSE_FILEPATH) != 0);
+  jsonFlag(w, "wrapexclude", (attrs & VTK_PARSE_WRAPEXCLUDE) != 0);
+  jsonFlag(w, "deprecated", (attrs & VTK_PARSE_DEPRECATED) != 0);
+
+  vtkWrapXMLOutput_Putc(w->file, '}');
+}
+
+/*-------------------------------------------------------------------
+ * write the file record, with the VTK-style documentation */
+
+static void jsonFile(wrapjson_state_t *w, FileInfo *data)
+{
+  char fingerprint[20];
+
+  vtkWrapXMLFingerprints_ToString(
+    vtkWrapXMLFingerprints_File(w->fingerprints, data), fingerprint);
+
+  jsonRecordStart(w, "file");
+  jsonStringField(w, "fingerprint", fingerprint);
+  jsonOptionalField(w, "name_comment", data->NameComment);
+  jsonOptionalField(w, "description", data->Description);
+  jsonOptionalField(w, "caveats", data->Caveats);
+  jsonOptionalField(w, "see_also", data->SeeAlso);
+  jsonRecordEnd(w);
+}
+
+/*-------------------------------------------------------------------
+ * write a variable, constant, or typedef */
+
+static void jsonValue(
+  wrapjson_state_t *w, ValueInfo *val, const char *kind,
+  const char *scope, const char *classname)
+{
+  jsonRecordStart(w, kind);
+  jsonOptionalField(w, "class", classname);
+  jsonOptionalField(w, "scope", scope);
+  jsonStringField(w, "name", val->Name);
+  if (classname)
+  {
+    jsonStringField(w, "access", jsonAccess(val->Access));
+  }
+  jsonFlag(w, "static", val->IsStatic);
+  jsonOptionalField(w, "value", val->Value);
+  vtkWrapXMLOutput_Puts(w->file, ",\"type\":");
+  jsonType(w, val);
+  jsonOptionalField(w, "comment", val->Comment);
+  jsonRecordEnd(w);
+}
+
+/*-------------------------------------------------------------------
+ * write an enum, with all of its values */
+
+static void jsonEnum(
+  wrapjson_state_t *w, EnumInfo *item, const char *scope,
+  const char *classname)
+{
+  ValueInfo *val;
+  int i;
+
+  jsonRecordStart(w, "enum");
+  jsonOptionalField(w, "class", classname);
+  jsonOptionalField(w, "scope", scope);
+  jsonStringField(w, "name", item->Name);
+  if (classname)
+  {
+    jsonStringField(w, "access", jsonAccess(item->Access));
+  }
+  vtkWrapXMLOutput_Puts(w->file, ",\"values\":[");
+  for (i = 0; i < item->NumberOfConstants; i++)
+  {
+    val = item->Constants[i];
+    vtkWrapXMLOutput_Puts(w->file, (i > 0 ? ",{\"name\":" : "{\"name\":"));
+    jsonString(w, val->Name);
+    jsonOptionalField(w, "value", val->Value);
+    jsonOptionalField(w, "comment", val->Comment);
+    vtkWrapXMLOutput_Putc(w->file, '}');
+  }
+  vtkWrapXMLOutput_Putc(w->file, ']');
+  jsonOptionalField(w, "comment", item->Comment);
+  jsonRecordEnd(w);
+}
+
+/*-------------------------------------------------------------------
+ * write the fields that are common to methods and functions */
+
+static void jsonFunctionCommon(
+  wrapjson_state_t *w, FunctionInfo *func, int printReturn)
+{
+  ValueInfo *arg;
+  const char *signature;
+  size_t l;
+  int i;
+
+  jsonFlag(w, "static", func->IsStatic);
+  jsonFlag(w, "variadic", func->IsVariadic);
+  jsonFlag(w, "legacy", func->IsLegacy);
+  jsonFlag(w, "template", (func->Template != NULL));
+
+  if (func->Signature)
+  {
+    signature = vtkWrapXMLSignatures_Get(w->signatures, func, &l);
+    jsonStringField(w, "signature", signature);
+  }
+
+  if (func->NumberOfPreconds > 0)
+  {
+    vtkWrapXMLOutput_Puts(w->file, ",\"expects\":[");
+    for (i = 0; i < func->NumberOfPreconds; i++)
+    {
+      if (i > 0)
+      {
+        vtkWrapXMLOutput_Putc(w->file, ',');
+      }
+      jsonString(w, func->Preconds[i]);
+    }
+    vtkWrapXMLOutput_Putc(w->file, ']');
+  }
+
+  vtkWrapXMLOutput_Puts(w->file, ",\"params\":[");
+  for (i = 0; i < func->NumberOfParameters; i++)
+  {
+    arg = func->Parameters[i];
+    vtkWrapXMLOutput_Puts(w->file, (i > 0 ? ",{\"name\":" : "{\"name\":"));
+    jsonString(w, arg->Name);
+    jsonOptionalField(w, "value", arg->Value);
+    jsonFlag(w, "pack", arg->IsPack);
+    vtkWrapXMLOutput_Puts(w->file, ",\"type\":");
+    jsonType(w, arg);
+    vtkWrapXMLOutput_Putc(w->file, '}');
+  }
+  vtkWrapXMLOutput_Putc(w->file, ']');
+
+  if (printReturn && func->ReturnValue)
+  {
+    vtkWrapXMLOutput_Puts(w->file, ",\"return\":");
+    jsonType(w, func->ReturnValue);
+  }
+
+  jsonOptionalField(w, "comment", func->Comment);
+}
+
+/*-------------------------------------------------------------------
+ * write a function that is not a class member */
+
+static void jsonFunction(
+  wrapjson_state_t *w, FunctionInfo *func, const char *scope)
+{
+  jsonRecordStart(w, "function");
+  jsonOptionalField(w, "scope", scope);
+  jsonStringField(w, "name", func->Name);
+  jsonFunctionCommon(w, func, 1);
+  jsonRecordEnd(w);
+}
+
+/*-------------------------------------------------------------------
+ * write a class method, with the name of its property if it has one */
+
+static void jsonMethod(
+  wrapjson_state_t *w, ClassInfo *data, FunctionInfo *func,
+  const char *classname, const char *propname)
+{
+  const char *element = "method";
+  const char *name = func->Name;
+  int isCtrOrDtr = 0;
+
+  if (func->IsDeleted)
+  {
+    return;
+  }
+
+  if (strcmp(data->Name, func->Name) == 0)
+  {
+    element = "constructor";
+    isCtrOrDtr = 1;
+  }
+  else if (func->Name[0] == '~' && strcmp(data->Name, &func->Name[1]) == 0)
+  {
+    element = "destructor";
+    isCtrOrDtr = 1;
+  }
+  else if (func->IsOperator)
+  {
+    element = "operator";
+    if (strncmp(name, "operator", 8) == 0)
+    {
+      name = &name[8];
+      while (*name == ' ')
+      {
+        name++;
+      }
+    }
+  }
+
+  /* eliminate macros masquerading as class methods */
+  if (!func->ReturnValue && !isCtrOrDtr)
+  {
+    return;
+  }
+
+  jsonRecordStart(w, element);
+  jsonStringField(w, "class", classname);
+  jsonStringField(w, "name", name);
+  jsonStringField(w, "access", jsonAccess(func->Access));
+  jsonOptionalField(w, "property", propname);
+  jsonFlag(w, "const", func->IsConst);
+  jsonFlag(w, "virtual", func->IsVirtual);
+  jsonFlag(w, "pure", func->IsPureVirtual);
+  jsonFlag(w, "final", func->IsFinal);
+  jsonFlag(w, "explicit", func->IsExplicit);
+  jsonFunctionCommon(w, func, !isCtrOrDtr);
+  jsonRecordEnd(w);
+}
+
+/*-------------------------------------------------------------------
+ * write the method types in a property bitfield as an array */
+
+static void jsonPropertyMethods(
+  wrapjson_state_t *w, const char *key, unsigned int methodBitfield)
+{
+  unsigned int i;
+  unsigned int methodType;
+  int first = 1;
+
+  if (methodBitfield == 0)
+  {
+    return;
+  }
+
+  vtkWrapXMLOutput_Printf(w->file, ",\"%s\":[", key);
+  for (i = 0; i < 32; i++)
+  {
+    methodType = methodBitfield & (1U << i);
+    if (methodType)
+    {
+      if ((methodType & VTK_METHOD_SET_CLAMP) != 0 &&
+          (methodBitfield & VTK_METHOD_SET_CLAMP) == VTK_METHOD_SET_CLAMP)
+      {
+        methodType = VTK_METHOD_SET_CLAMP;
+        methodBitfield &= ~VTK_METHOD_SET_CLAMP;
+      }
+      else if ((methodType & VTK_METHOD_SET_BOOL) != 0 &&
+          (methodBitfield & VTK_METHOD_SET_BOOL) == VTK_METHOD_SET_BOOL)
+      {
+        methodType = VTK_METHOD_SET_BOOL;
+        methodBitfield &= ~VTK_METHOD_SET_BOOL;
+      }
+
+      vtkWrapXMLOutput_Printf(w->file, "%s\"%s\"", (first ? "" : ","),
+              vtkParseProperties_MethodTypeAsString(methodType));
+      first = 0;
+    }
+  }
+  vtkWrapXMLOutput_Putc(w->file, ']');
+}
+
+/*-------------------------------------------------------------------
+ * write a property */
+
+static void jsonProperty(
+  wrapjson_state_t *w, PropertyInfo *property, const char *classname)
+{
+  const char *access = NULL;
+  const char *sizes[1];
+  char temp[32];
+  ValueInfo val;
+  int i;
+
+  jsonRecordStart(w, "property");
+  jsonStringField(w, "class", classname);
+  jsonStringField(w, "name", property->Name);
+
+  if (property->PublicMethods)
+  {
+    access = "public";
+  }
+  else if (property->ProtectedMethods)
+  {
+    access = "protected";
+  }
+  else if (property->PrivateMethods)
+  {
+    access = "private";
+  }
+  jsonOptionalField(w, "access", access);
+
+  jsonFlag(w, "static", property->IsStatic);
+  jsonFlag(w, "legacy",
+    ((property->PublicMethods | property->ProtectedMethods |
+      property->PrivateMethods) & ~property->LegacyMethods) == 0);
+
+  /* the type is written the same way as for a variable */
+  memset(&val, 0, sizeof(ValueInfo));
+  val.ItemType = VTK_VARIABLE_INFO;
+  val.Type = property->Type;
+  val.Class = property->ClassName;
+  if (property->Count > 0)
+  {
+    sprintf(temp, "%d", property->Count);
+    sizes[0] = temp;
+    val.Dimensions = sizes;
+    val.NumberOfDimensions = 1;
+  }
+  vtkWrapXMLOutput_Puts(w->file, ",\"type\":");
+  jsonType(w, &val);
+
+  vtkWrapXMLOutput_Printf(w->file, ",\"methods\":{\"bitfield\":%u",
+    property->PublicMethods | property->ProtectedMethods |
+    property->PrivateMethods);
+  jsonPropertyMethods(w, "public", property->PublicMethods);
+  jsonPropertyMethods(w, "protected", property->ProtectedMethods);
+  jsonPropertyMethods(w, "private", property->PrivateMethods);
+  jsonPropertyMethods(w, "legacy", property->LegacyMethods);
+  vtkWrapXMLOutput_Putc(w->file, '}');
+
+  if (property->EnumConstantNames)
+  {
+    vtkWrapXMLOutput_Puts(w->file, ",\"values\":[");
+    for (i = 0; property->EnumConstantNames[i] != 0; i++)
+    {
+      if (i > 0)
+      {
+        vtkWrapXMLOutput_Putc(w->file, ',');
+      }
+      jsonString(w, property->EnumConstantNames[i]);
+    }
+    vtkWrapXMLOutput_Putc(w->file, ']');
+  }
+
+  jsonOptionalField(w, "comment", property->Comment);
+  jsonRecordEnd(w);
+}
+
+static void jsonBody(
+  wrapjson_state_t *w, NamespaceInfo *data, const char *scope);
+
+/*-------------------------------------------------------------------
+ * write a class, followed by all of its members */
+
+static void jsonClass(
+  wrapjson_state_t *w, ClassInfo *classInfo, const char *scope, int inClass)
+{
+  const char *element = "class";
+  const char *classname;
+  ClassProperties *properties;
+  PropertyInfo *property;
+  const char *propname;
+  char fingerprint[20];
+  int i, j, k;
+
+  if (classInfo->ItemType == VTK_STRUCT_INFO)
+  {
+    element = "struct";
+  }
+  else if (classInfo->ItemType == VTK_UNION_INFO)
+  {
+    element = "union";
+  }
+
+  classname = jsonScopedName(w, scope, classInfo->Name);
+
+  jsonRecordStart(w, "class");
+  jsonStringField(w, "name", classname);
+  jsonStringField(w, "element", element);
+  if (inClass)
+  {
+    jsonStringField(w, "access", jsonAccess(classInfo->Access));
+  }
+  jsonFlag(w, "abstract", classInfo->IsAbstract);
+  jsonFlag(w, "final", classInfo->IsFinal);
+  jsonFlag(w, "template", (classInfo->Template != NULL));
+  vtkWrapXMLFingerprints_ToString(
+    vtkWrapXMLFingerprints_Class(w->fingerprints, classInfo), fingerprint);
+  jsonStringField(w, "fingerprint", fingerprint);
+  vtkWrapXMLOutput_Puts(w->file, ",\"bases\":[");
+  for (i = 0; i < classInfo->NumberOfSuperClasses; i++)
+  {
+    if (i > 0)
+    {
+      vtkWrapXMLOutput_Putc(w->file, ',');
+    }
+    jsonString(w, classInfo->SuperClasses[i]);
+  }
+  vtkWrapXMLOutput_Putc(w->file, ']');
+  jsonOptionalField(w, "comment", classInfo->Comment);
+  jsonRecordEnd(w);
+
+  /* get information about the properties */
+  properties = vtkWrapXMLFingerprints_Properties(w->fingerprints, classInfo);
+
+  /* write all members of the class */
+  for (i = 0; i < classInfo->NumberOfItems; i++)
+  {
+    j = classInfo->Items[i].Index;
+    switch (classInfo->Items[i].Type)
+    {
+      case VTK_VARIABLE_INFO:
+        jsonValue(w, classInfo->Variables[j], "variable", NULL, classname);
+        break;
+      case VTK_CONSTANT_INFO:
+        jsonValue(w, classInfo->Constants[j], "constant", NULL, classname);
+        break;
+      case VTK_TYPEDEF_INFO:
+        jsonValue(w, classInfo->Typedefs[j], "typedef", NULL, classname);
+        break;
+      case VTK_ENUM_INFO:
+        jsonEnum(w, classInfo->Enums[j], NULL, classname);
+        break;
+      case VTK_FUNCTION_INFO:
+      {
+        /* write the property before its first method */
+        property = NULL;
+        propname = NULL;
+        if (properties->MethodHasProperty[j])
+        {
+          property = properties->Properties[properties->MethodProperties[j]];
+          propname = property->Name;
+          for (k = 0; k < j; k++)
+          {
+            if (properties->MethodHasProperty[k] &&
+                property ==
+                properties->Properties[properties->MethodProperties[k]])
+            {
+              property = NULL;
+              break;
+            }
+          }
+        }
+        if (property)
+        {
+          jsonProperty(w, property, classname);
+        }
+        jsonMethod(w, classInfo, classInfo->Functions[j], classname, propname);
+        break;
+      }
+      case VTK_CLASS_INFO:
+      case VTK_STRUCT_INFO:
+      case VTK_UNION_INFO:
+        jsonClass(w, classInfo->Classes[j], classname, 1);
+        break;
+      case VTK_USING_INFO:
+      case VTK_NAMESPACE_INFO:
+        break;
+    }
+  }
+}
+
+/*-------------------------------------------------------------------
+ * write the contents of a file or namespace */
+
+static void jsonBody(
+  wrapjson_state_t *w, NamespaceInfo *data, const char *scope)
+{
+  int i, j;
+
+  for (i = 0; i < data->NumberOfItems; i++)
+  {
+    j = data->Items[i].Index;
+    switch (data->Items[i].Type)
+    {
+      case VTK_VARIABLE_INFO:
+        jsonValue(w, data->Variables[j], "variable", scope, NULL);
+        break;
+      case VTK_CONSTANT_INFO:
+        jsonValue(w, data->Constants[j], "constant", scope, NULL);
+        break;
+      case VTK_TYPEDEF_INFO:
+        jsonValue(w, data->Typedefs[j], "typedef", scope, NULL);
+        break;
+      case VTK_ENUM_INFO:
+        jsonEnum(w, data->Enums[j], scope, NULL);
+        break;
+      case VTK_CLASS_INFO:
+      case VTK_STRUCT_INFO:
+      case VTK_UNION_INFO:
+        jsonClass(w, data->Classes[j], scope, 0);
+        break;
+      case VTK_FUNCTION_INFO:
+        jsonFunction(w, data->Functions[j], scope);
+        break;
+      case VTK_NAMESPACE_INFO:
+        jsonBody(w, data->Namespaces[j],
+                 jsonScopedName(w, scope, data->Namespaces[j]->Name));
+        break;
+      case VTK_USING_INFO:
+        break;
+    }
+  }
+}
+
+/*-------------------------------------------------------------------
+ * write all records for a file */
+
+void vtkWrapXMLJSON_WriteFile(
+  WrapXMLOutput *fp, FileInfo *data, WrapXMLFingerprints *fingerprints)
+{
+  wrapjson_state_t w;
+  const char *cp = data->FileName;
+  size_t i;
+
+  w.file = fp;
+  w.fileName = NULL;
+  w.arena = fingerprints->Arena;
+  w.signatures = fingerprints->Signatures;
+  w.fingerprints = fingerprints;
+
+  if (cp)
+  {
+    i = strlen(cp);
+    while (i > 0 && cp[i-1] != '/' && cp[i-1] != '\\' && cp[i-1] != ':')
+    {
+      i--;
+    }
+    w.fileName = &cp[i];
+  }
+
+  jsonFile(&w, data);
+  jsonBody(&w, data->Contents, NULL);
+}
@@ -0,0 +1,49 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLJSON.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file contains the JSON Lines (NDJSON) backend for vtkWrapXML.
+ * Instead of one XML document, it writes one self-contained JSON object
+ * per line for the file, and for each class, property, method, function,
+ * enum, constant, variable, and typedef as they are reached.  Each record
+ * has a "kind" and the name of the file, and members of classes also have
+ * the name of the class, so that consumers can process the records as a
+ * stream without keeping any context.
+ */
+
+#ifndef VTK_WRAP_XML_JSON_H
+#define VTK_WRAP_XML_JSON_H
+
+#include "vtkParseData.h"
+#include "vtkWrapXMLArena.h"
+#include "vtkWrapXMLFingerprints.h"
+#include "vtkWrapXMLOutput.h"
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Write the records for a parsed file.  The fingerprint table provides
+ * the signatures, the class properties, and the arena that all memory
+ * is allocated from.
+ */
+void vtkWrapXMLJSON_WriteFile(
+  WrapXMLOutput *fp, FileInfo *data, WrapXMLFingerprints *fingerprints);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
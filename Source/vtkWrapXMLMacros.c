@@ -0,0 +1,338 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLMacros.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLMacros.h"
+#include "vtkWrapXMLSystem.h"
+#include "vtkParse.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <ctype.h>
+
+#include "vtkWrapXMLAlloc.h"
+
+/*-------------------------------------------------------------------
+ * The snapshot file is laid out as follows, with all integers stored
+ * as native 32-bit unsigned ints:
+ *
+ *   char magic[8]          "vtkxmacs"
+ *   unsigned int byteorder  0x01020304, to reject foreign snapshots
+ *   unsigned int count      the number of macros
+ *   unsigned int strsize    the size of the string block
+ *   unsigned int offsets[2*count]  name and definition of each macro
+ *   char strings[strsize]  nul-terminated names and definitions
+ */
+
+#define SNAPSHOT_MAGIC "vtkxmacs"
+#define SNAPSHOT_BYTEORDER 0x01020304u
+#define SNAPSHOT_HEADER_SIZE (8 + 3*sizeof(unsigned int))
+
+/* the macros that have been read from the macros file */
+typedef struct _MacroList
+{
+  int NumberOfMacros;
+  int MaxMacros;
+  char **Names;
+  char **Definitions;
+} MacroList;
+
+/*-------------------------------------------------------------------
+ * remove a macro from the list, for "#undef" or for redefinitions */
+
+static void removeMacro(MacroList *macros, const char *name, size_t n)
+{
+  int i;
+
+  for (i = 0; i < macros->NumberOfMacros; i++)
+  {
+    if (strncmp(macros->Names[i], name, n) == 0 &&
+        macros->Names[i][n] == '\0')
+    {
+      free(macros->Names[i]);
+      free(macros->Definitions[i]);
+      macros->NumberOfMacros--;
+      memmove(&macros->Names[i], &macros->Names[i+1],
+              sizeof(char *)*(macros->NumberOfMacros - i));
+      memmove(&macros->Definitions[i], &macros->Definitions[i+1],
+              sizeof(char *)*(macros->NumberOfMacros - i));
+      return;
+    }
+  }
+}
+
+/*-------------------------------------------------------------------
+ * add a macro to the list */
+
+static void addMacro(
+  MacroList *macros, const char *name, size_t n,
+  const char *definition, size_t m)
+{
+  removeMacro(macros, name, n);
+
+  if (macros->NumberOfMacros == macros->MaxMacros)
+  {
+    macros->MaxMacros = (macros->MaxMacros == 0 ? 256 : 2*macros->MaxMacros);
+    macros->Names = (char **)realloc(
+      macros->Names, sizeof(char *)*macros->MaxMacros);
+    macros->Definitions = (char **)realloc(
+      macros->Definitions, sizeof(char *)*macros->MaxMacros);
+  }
+
+  macros->Names[macros->NumberOfMacros] = (char *)malloc(n + 1);
+  memcpy(macros->Names[macros->NumberOfMacros], name, n);
+  macros->Names[macros->NumberOfMacros][n] = '\0';
+
+  macros->Definitions[macros->NumberOfMacros] = (char *)malloc(m + 1);
+  memcpy(macros->Definitions[macros->NumberOfMacros], definition, m);
+  macros->Definitions[macros->NumberOfMacros][m] = '\0';
+
+  macros->NumberOfMacros++;
+}
+
+/*-------------------------------------------------------------------
+ * free the list of macros */
+
+static void freeMacros(MacroList *macros)
+{
+  int i;
+
+  for (i = 0; i < macros->NumberOfMacros; i++)
+  {
+    free(macros->Names[i]);
+    free(macros->Definitions[i]);
+  }
+
+  free(macros->Names);
+  free(macros->Definitions);
+}
+
+/*-------------------------------------------------------------------
+ * handle one logical line of the macros file, returns 1 if the line
+ * was a function-like macro that had to be skipped */
+
+static int parseDirective(MacroList *macros, const char *cp, size_t l)
+{
+  size_t i = 0;
+  size_t j, n;
+
+  while (i < l && (cp[i] == ' ' || cp[i] == '\t')) { i++; }
+  if (i == l || cp[i] != '#') { return 0; }
+  i++;
+  while (i < l && (cp[i] == ' ' || cp[i] == '\t')) { i++; }
+
+  if (l - i > 6 && strncmp(&cp[i], "define", 6) == 0 &&
+      (cp[i+6] == ' ' || cp[i+6] == '\t'))
+  {
+    i += 6;
+    while (i < l && (cp[i] == ' ' || cp[i] == '\t')) { i++; }
+    for (n = 0; i + n < l && (isalnum(cp[i+n]) || cp[i+n] == '_'); n++) { }
+    if (n == 0)
+    {
+      return 0;
+    }
+
+    /* function-like macros cannot be given to vtkParse_DefineMacro() */
+    if (i + n < l && cp[i+n] == '(')
+    {
+      return 1;
+    }
+
+    j = i + n;
+    while (j < l && (cp[j] == ' ' || cp[j] == '\t')) { j++; }
+    while (l > j && isspace(cp[l-1])) { l--; }
+    addMacro(macros, &cp[i], n, &cp[j], l - j);
+  }
+  else if (l - i > 5 && strncmp(&cp[i], "undef", 5) == 0 &&
+           (cp[i+5] == ' ' || cp[i+5] == '\t'))
+  {
+    i += 5;
+    while (i < l && (cp[i] == ' ' || cp[i] == '\t')) { i++; }
+    for (n = 0; i + n < l && (isalnum(cp[i+n]) || cp[i+n] == '_'); n++) { }
+    removeMacro(macros, &cp[i], n);
+  }
+
+  return 0;
+}
+
+/*-------------------------------------------------------------------
+ * read a macros file and write it as a snapshot */
+
+int vtkWrapXMLMacros_WriteSnapshot(
+  const char *macrosFile, const char *snapshotFile)
+{
+  MacroList macros = { 0, 0, NULL, NULL };
+  const char *text;
+  size_t size, i, j;
+  char *line = NULL;
+  size_t linelen = 0;
+  size_t linemax = 0;
+  int skipped = 0;
+  unsigned int header[3];
+  unsigned int *offsets;
+  unsigned int pos;
+  FILE *fp;
+  int k;
+  int ok = 1;
+
+  text = vtkWrapXMLSystem_MapFile(macrosFile, &size);
+  if (text == NULL)
+  {
+    fprintf(stderr, "Error opening macros file %s\n", macrosFile);
+    return 0;
+  }
+
+  /* join continued lines, then handle each directive */
+  i = 0;
+  while (i < size)
+  {
+    for (j = i; j < size && text[j] != '\n'; j++) { }
+
+    if (linelen + (j - i) + 1 > linemax)
+    {
+      linemax = 2*(linelen + (j - i) + 1);
+      line = (char *)realloc(line, linemax);
+    }
+    memcpy(&line[linelen], &text[i], j - i);
+    linelen += j - i;
+
+    if (linelen > 0 && line[linelen-1] == '\r')
+    {
+      linelen--;
+    }
+    if (linelen > 0 && line[linelen-1] == '\\' && j < size)
+    {
+      linelen--;
+    }
+    else
+    {
+      skipped += parseDirective(&macros, line, linelen);
+      linelen = 0;
+    }
+
+    i = j + 1;
+  }
+
+  free(line);
+  vtkWrapXMLSystem_UnmapFile(text, size);
+
+  if (skipped)
+  {
+    fprintf(stderr,
+            "Warning: %d function-like macros in %s were not saved\n",
+            skipped, macrosFile);
+  }
+
+  /* compute the offsets into the string block */
+  offsets = (unsigned int *)malloc(
+    sizeof(unsigned int)*(2*macros.NumberOfMacros + 1));
+  pos = 0;
+  for (k = 0; k < macros.NumberOfMacros; k++)
+  {
+    offsets[2*k] = pos;
+    pos += (unsigned int)strlen(macros.Names[k]) + 1;
+    offsets[2*k+1] = pos;
+    pos += (unsigned int)strlen(macros.Definitions[k]) + 1;
+  }
+
+  header[0] = SNAPSHOT_BYTEORDER;
+  header[1] = (unsigned int)macros.NumberOfMacros;
+  header[2] = pos;
+
+  fp = fopen(snapshotFile, "wb");
+  if (!fp)
+  {
+    fprintf(stderr, "Error opening output file %s\n", snapshotFile);
+    free(offsets);
+    freeMacros(&macros);
+    return 0;
+  }
+
+  fwrite(SNAPSHOT_MAGIC, 1, 8, fp);
+  fwrite(header, sizeof(unsigned int), 3, fp);
+  fwrite(offsets, sizeof(unsigned int), 2*macros.NumberOfMacros, fp);
+  for (k = 0; k < macros.NumberOfMacros; k++)
+  {
+    fwrite(macros.Names[k], 1, strlen(macros.Names[k]) + 1, fp);
+    fwrite(macros.Definitions[k], 1, strlen(macros.Definitions[k]) + 1, fp);
+  }
+
+  if (ferror(fp))
+  {
+    fprintf(stderr, "Error writing output file %s\n", snapshotFile);
+    ok = 0;
+  }
+
+  fclose(fp);
+  free(offsets);
+  freeMacros(&macros);
+
+  return ok;
+}
+
+/*-------------------------------------------------------------------
+ * define all the macros that are stored in a snapshot */
+
+int vtkWrapXMLMacros_LoadSnapshot(const char *snapshotFile)
+{
+  const char *data;
+  const char *strings;
+  size_t size;
+  unsigned int header[3];
+  const unsigned int *offsets;
+  unsigned int i, n, strsize;
+
+  data = vtkWrapXMLSystem_MapFile(snapshotFile, &size);
+  if (data == NULL)
+  {
+    return -1;
+  }
+
+  if (size < SNAPSHOT_HEADER_SIZE ||
+      strncmp(data, SNAPSHOT_MAGIC, 8) != 0)
+  {
+    vtkWrapXMLSystem_UnmapFile(data, size);
+    return -1;
+  }
+
+  memcpy(header, &data[8], sizeof(header));
+  n = header[1];
+  strsize = header[2];
+  if (header[0] != SNAPSHOT_BYTEORDER ||
+      (size - SNAPSHOT_HEADER_SIZE)/sizeof(unsigned int) < 2*(size_t)n ||
+      size - SNAPSHOT_HEADER_SIZE - 2*(size_t)n*sizeof(unsigned int) !=
+        strsize ||
+      (strsize > 0 && data[size-1] != '\0'))
+  {
+    vtkWrapXMLSystem_UnmapFile(data, size);
+    return -1;
+  }
+
+  /* the offsets follow the header, and are suitably aligned */
+  offsets = (const unsigned int *)&data[SNAPSHOT_HEADER_SIZE];
+  strings = &data[SNAPSHOT_HEADER_SIZE + 2*n*sizeof(unsigned int)];
+
+  for (i = 0; i < n; i++)
+  {
+    if (offsets[2*i] >= strsize || offsets[2*i+1] >= strsize)
+    {
+      vtkWrapXMLSystem_UnmapFile(data, size);
+      return -1;
+    }
+    vtkParse_DefineMacro(&strings[offsets[2*i]], &strings[offsets[2*i+1]]);
+  }
+
+  vtkWrapXMLSystem_UnmapFile(data, size);
+
+  return (int)n;
+}
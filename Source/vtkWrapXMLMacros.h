@@ -0,0 +1,52 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLMacros.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file contains methods for saving a set of preprocessor macros
+ * into a compact snapshot file, and for defining those macros again
+ * from the snapshot.  A snapshot replaces "-imacros <file>", which
+ * would otherwise require the macros file to be preprocessed for
+ * every header that is wrapped.
+ *
+ * Only object-like macros are stored, since vtkParse_DefineMacro()
+ * does not support function-like macros.
+ */
+
+#ifndef VTK_WRAP_XML_MACROS_H
+#define VTK_WRAP_XML_MACROS_H
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Read a file of "#define" directives, such as the output of
+ * "cc -dM -E", and write its object-like macros to a snapshot file.
+ * Returns zero if an error occurred.
+ */
+int vtkWrapXMLMacros_WriteSnapshot(
+  const char *macrosFile, const char *snapshotFile);
+
+/**
+ * Map a snapshot file into memory and define each of its macros with
+ * vtkParse_DefineMacro().  Returns the number of macros that were
+ * defined, or -1 if the snapshot could not be read.
+ */
+int vtkWrapXMLMacros_LoadSnapshot(const char *snapshotFile);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
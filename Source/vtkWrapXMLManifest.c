@@ -0,0 +1,518 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLManifest.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLManifest.h"
+#include "vtkWrapXMLInput.h"
+#include "vtkWrapXMLOutput.h"
+#include <stdlib.h>
+#include <string.h>
+
+#include "vtkWrapXMLAlloc.h"
+
+/* the first line of every manifest */
+#define MANIFEST_MAGIC "# WrapVTK manifest 1\n"
+
+/* the number of fields on each line, the last is optional */
+#define MANIFEST_FIELDS 9
+
+/*-------------------------------------------------------------------
+ * create and free */
+
+WrapXMLManifest *vtkWrapXMLManifest_New(void)
+{
+  WrapXMLManifest *manifest;
+
+  manifest = (WrapXMLManifest *)calloc(1, sizeof(WrapXMLManifest));
+  manifest->Arena = vtkWrapXMLArena_New();
+
+  return manifest;
+}
+
+void vtkWrapXMLManifest_Free(WrapXMLManifest *manifest)
+{
+  vtkWrapXMLArena_Delete(manifest->Arena);
+  free(manifest->Entries);
+  free(manifest->Segments);
+  free(manifest);
+}
+
+/*-------------------------------------------------------------------
+ * add a class, the array grows in powers of two */
+
+static WrapXMLManifestEntry *newEntry(WrapXMLManifest *manifest)
+{
+  int n = manifest->NumberOfEntries;
+
+  if (n == 0 || (n >= 16 && (n & (n - 1)) == 0))
+  {
+    manifest->Entries = (WrapXMLManifestEntry *)realloc(
+      manifest->Entries, sizeof(WrapXMLManifestEntry)*(n == 0 ? 16 : 2*n));
+  }
+
+  manifest->NumberOfEntries = n + 1;
+
+  return &manifest->Entries[n];
+}
+
+void vtkWrapXMLManifest_AddEntry(
+  WrapXMLManifest *manifest, const WrapXMLManifestEntry *entry)
+{
+  WrapXMLManifestEntry *e = newEntry(manifest);
+
+  *e = *entry;
+  e->Module = vtkWrapXMLArena_StringCopy(manifest->Arena, entry->Module);
+  e->Name = vtkWrapXMLArena_StringCopy(manifest->Arena, entry->Name);
+  e->Base = vtkWrapXMLArena_StringCopy(manifest->Arena, entry->Base);
+  e->File = vtkWrapXMLArena_StringCopy(manifest->Arena, entry->File);
+}
+
+/*-------------------------------------------------------------------
+ * add a segment, the array grows in powers of two */
+
+static WrapXMLManifestSegment *newSegment(WrapXMLManifest *manifest, int id)
+{
+  WrapXMLManifestSegment *s;
+  int n = manifest->NumberOfSegments;
+
+  if (n == 0 || (n >= 16 && (n & (n - 1)) == 0))
+  {
+    manifest->Segments = (WrapXMLManifestSegment *)realloc(
+      manifest->Segments,
+      sizeof(WrapXMLManifestSegment)*(n == 0 ? 16 : 2*n));
+  }
+
+  manifest->NumberOfSegments = n + 1;
+
+  s = &manifest->Segments[n];
+  s->Id = id;
+  s->State = VTK_WRAP_XML_SEGMENT_SAVED;
+  s->MTime = 0;
+  s->Size = 0;
+  s->Source = NULL;
+
+  return s;
+}
+
+static WrapXMLManifestSegment *findSegment(WrapXMLManifest *manifest, int id)
+{
+  int i;
+
+  for (i = 0; i < manifest->NumberOfSegments; i++)
+  {
+    if (manifest->Segments[i].Id == id)
+    {
+      return &manifest->Segments[i];
+    }
+  }
+
+  return NULL;
+}
+
+static int isLive(const WrapXMLManifestSegment *s)
+{
+  return (s->State == VTK_WRAP_XML_SEGMENT_SAVED ||
+          s->State == VTK_WRAP_XML_SEGMENT_NEW);
+}
+
+int vtkWrapXMLManifest_AddSegment(
+  WrapXMLManifest *manifest, const char *source,
+  long long mtime, long long size)
+{
+  WrapXMLManifestSegment *s;
+  int id = 0;
+  int i;
+
+  /* ids are never reused, so that a tombstone cannot bury a new segment */
+  for (i = 0; i < manifest->NumberOfSegments; i++)
+  {
+    if (manifest->Segments[i].Id > id)
+    {
+      id = manifest->Segments[i].Id;
+    }
+  }
+
+  s = newSegment(manifest, id + 1);
+  s->State = VTK_WRAP_XML_SEGMENT_NEW;
+  s->MTime = mtime;
+  s->Size = size;
+  s->Source = vtkWrapXMLArena_StringCopy(manifest->Arena, source);
+
+  return s->Id;
+}
+
+WrapXMLManifestSegment *vtkWrapXMLManifest_FindSegment(
+  WrapXMLManifest *manifest, const char *source)
+{
+  WrapXMLManifestSegment *s;
+  int i;
+
+  for (i = 0; i < manifest->NumberOfSegments; i++)
+  {
+    s = &manifest->Segments[i];
+    if (isLive(s) && s->Source && strcmp(s->Source, source) == 0)
+    {
+      return s;
+    }
+  }
+
+  return NULL;
+}
+
+/* remove the classes in the segments that are not live */
+static void removeDeadEntries(WrapXMLManifest *manifest)
+{
+  WrapXMLManifestEntry *e;
+  WrapXMLManifestSegment *s = NULL;
+  int i, j;
+
+  j = 0;
+  for (i = 0; i < manifest->NumberOfEntries; i++)
+  {
+    e = &manifest->Entries[i];
+    if (e->Segment != 0 && (s == NULL || s->Id != e->Segment))
+    {
+      s = findSegment(manifest, e->Segment);
+    }
+    if (e->Segment == 0 || s == NULL || isLive(s))
+    {
+      manifest->Entries[j++] = *e;
+    }
+  }
+
+  manifest->NumberOfEntries = j;
+}
+
+void vtkWrapXMLManifest_RemoveSegment(WrapXMLManifest *manifest, int id)
+{
+  WrapXMLManifestSegment *s;
+
+  s = findSegment(manifest, id);
+  if (s && isLive(s))
+  {
+    /* a segment that was never written does not need a tombstone */
+    s->State = (s->State == VTK_WRAP_XML_SEGMENT_NEW ?
+                VTK_WRAP_XML_SEGMENT_BURIED : VTK_WRAP_XML_SEGMENT_DEAD);
+    removeDeadEntries(manifest);
+  }
+}
+
+/*-------------------------------------------------------------------
+ * write the manifest */
+
+static void writeField(WrapXMLOutput *out, const char *text, int sep)
+{
+  vtkWrapXMLOutput_Puts(out, (text ? text : "-"));
+  vtkWrapXMLOutput_Putc(out, sep);
+}
+
+static void writeEntry(WrapXMLOutput *out, const WrapXMLManifestEntry *e)
+{
+  writeField(out, e->Module, '\t');
+  writeField(out, e->Name, '\t');
+  writeField(out, e->Base, '\t');
+  vtkWrapXMLOutput_Printf(out, "%d\t%d\t",
+                          e->IsAbstract, e->NumberOfProperties);
+  writeField(out, e->File, '\t');
+  vtkWrapXMLOutput_Printf(out, "%lu\t%lu\t",
+                          (unsigned long)e->Start, (unsigned long)e->End);
+  if (e->Fingerprint)
+  {
+    vtkWrapXMLOutput_Printf(out, "%08lx%08lx\n",
+                            (unsigned long)(e->Fingerprint >> 32),
+                            (unsigned long)(e->Fingerprint & 0xffffffffu));
+  }
+  else
+  {
+    vtkWrapXMLOutput_Puts(out, "-\n");
+  }
+}
+
+/* write a segment and its classes, searching from entry "j", and
+ * return the entry after its classes, or "j" if it has no classes */
+static int writeSegment(
+  WrapXMLOutput *out, WrapXMLManifest *manifest,
+  const WrapXMLManifestSegment *s, int j)
+{
+  int k = j;
+
+  vtkWrapXMLOutput_Printf(out, "@segment\t%d\t%lld\t%lld\t",
+                          s->Id, s->MTime, s->Size);
+  writeField(out, s->Source, '\n');
+
+  /* a segment can be empty, e.g. for a header without classes, and
+   * then the search must not move past the classes of later segments */
+  while (k < manifest->NumberOfEntries &&
+         manifest->Entries[k].Segment != s->Id)
+  {
+    k++;
+  }
+  if (k == manifest->NumberOfEntries)
+  {
+    return j;
+  }
+  while (k < manifest->NumberOfEntries &&
+         manifest->Entries[k].Segment == s->Id)
+  {
+    writeEntry(out, &manifest->Entries[k++]);
+  }
+
+  return k;
+}
+
+int vtkWrapXMLManifest_Write(WrapXMLManifest *manifest, const char *filename)
+{
+  WrapXMLOutput *out;
+  WrapXMLManifestSegment *s;
+  int i, j, n;
+
+  out = vtkWrapXMLOutput_Open(filename, VTK_WRAP_XML_COMPRESS_NONE);
+  if (out == NULL)
+  {
+    return 0;
+  }
+
+  vtkWrapXMLOutput_Puts(out, MANIFEST_MAGIC);
+  vtkWrapXMLOutput_Puts(out,
+    "# module\tclass\tbase\tabstract\tproperties\tfile\tstart\tend"
+    "\tfingerprint\n");
+
+  /* the classes that are not in any segment come first */
+  for (j = 0; j < manifest->NumberOfEntries; j++)
+  {
+    if (manifest->Entries[j].Segment == 0)
+    {
+      writeEntry(out, &manifest->Entries[j]);
+    }
+  }
+
+  /* only the live segments are written, so no tombstones are needed */
+  j = 0;
+  n = 0;
+  for (i = 0; i < manifest->NumberOfSegments; i++)
+  {
+    s = &manifest->Segments[i];
+    if (isLive(s))
+    {
+      j = writeSegment(out, manifest, s, j);
+      s->State = VTK_WRAP_XML_SEGMENT_SAVED;
+      manifest->Segments[n++] = *s;
+    }
+  }
+  manifest->NumberOfSegments = n;
+
+  return vtkWrapXMLOutput_Close(out);
+}
+
+int vtkWrapXMLManifest_Append(WrapXMLManifest *manifest, const char *filename)
+{
+  WrapXMLOutput *out;
+  WrapXMLManifestSegment *s;
+  int i, j;
+
+  out = vtkWrapXMLOutput_Append(filename, VTK_WRAP_XML_COMPRESS_NONE);
+  if (out == NULL)
+  {
+    return 0;
+  }
+
+  /* the new segments must precede the tombstones for the segments
+     that they replace, so that a reader never sees a gap */
+  j = 0;
+  for (i = 0; i < manifest->NumberOfSegments; i++)
+  {
+    s = &manifest->Segments[i];
+    if (s->State == VTK_WRAP_XML_SEGMENT_NEW)
+    {
+      j = writeSegment(out, manifest, s, j);
+      s->State = VTK_WRAP_XML_SEGMENT_SAVED;
+    }
+  }
+
+  for (i = 0; i < manifest->NumberOfSegments; i++)
+  {
+    s = &manifest->Segments[i];
+    if (s->State == VTK_WRAP_XML_SEGMENT_DEAD)
+    {
+      vtkWrapXMLOutput_Printf(out, "@tombstone\t%d\n", s->Id);
+      s->State = VTK_WRAP_XML_SEGMENT_BURIED;
+    }
+  }
+
+  return vtkWrapXMLOutput_Close(out);
+}
+
+/*-------------------------------------------------------------------
+ * split a line at the tabs, and replace "-" with NULL */
+
+static int splitFields(char *line, char *fields[], int n, int required)
+{
+  int i;
+
+  fields[0] = line;
+  for (i = 1; i < n; i++)
+  {
+    fields[i] = (fields[i - 1] ? strchr(fields[i - 1], '\t') : NULL);
+    if (fields[i] == NULL)
+    {
+      if (i < required)
+      {
+        return 0;
+      }
+      continue;
+    }
+    *fields[i]++ = '\0';
+  }
+
+  for (i = 0; i < n; i++)
+  {
+    if (fields[i] && strcmp(fields[i], "-") == 0)
+    {
+      fields[i] = NULL;
+    }
+  }
+
+  return 1;
+}
+
+/*-------------------------------------------------------------------
+ * read a fingerprint, which is 16 hexadecimal digits */
+
+static uint64_t readFingerprint(const char *text)
+{
+  uint64_t value = 0;
+  int i, d;
+
+  for (i = 0; i < 16; i++)
+  {
+    d = text[i];
+    if (d >= '0' && d <= '9')
+    {
+      d -= '0';
+    }
+    else if (d >= 'a' && d <= 'f')
+    {
+      d -= 'a' - 10;
+    }
+    else
+    {
+      return 0;
+    }
+    value = (value << 4) | (unsigned int)d;
+  }
+
+  return value;
+}
+
+/*-------------------------------------------------------------------
+ * read the manifest, the text is kept in the arena and the fields
+ * are split in place */
+
+int vtkWrapXMLManifest_Read(WrapXMLManifest *manifest, const char *filename)
+{
+  WrapXMLManifestEntry *e;
+  WrapXMLManifestSegment *s;
+  char *fields[MANIFEST_FIELDS];
+  char *text;
+  char *cp;
+  char *line;
+  size_t n;
+  int segment = 0;
+  int buried = 0;
+
+  text = vtkWrapXMLInput_ReadAll(filename, &n);
+  if (text == NULL)
+  {
+    return 0;
+  }
+
+  if (strncmp(text, MANIFEST_MAGIC, strlen(MANIFEST_MAGIC)) != 0)
+  {
+    free(text);
+    return 0;
+  }
+
+  cp = (char *)vtkWrapXMLArena_Alloc(manifest->Arena, n + 1);
+  memcpy(cp, text, n);
+  free(text);
+
+  while (*cp != '\0')
+  {
+    line = cp;
+    while (*cp != '\n' && *cp != '\0')
+    {
+      cp++;
+    }
+    if (*cp == '\n')
+    {
+      *cp++ = '\0';
+    }
+
+    if (line[0] == '#' || line[0] == '\0')
+    {
+      continue;
+    }
+
+    if (line[0] == '@')
+    {
+      if (strncmp(line, "@segment\t", 9) == 0 &&
+          splitFields(&line[9], fields, 4, 4) && fields[0])
+      {
+        segment = atoi(fields[0]);
+        s = newSegment(manifest, segment);
+        s->MTime = (fields[1] ? strtoll(fields[1], NULL, 10) : 0);
+        s->Size = (fields[2] ? strtoll(fields[2], NULL, 10) : 0);
+        s->Source = fields[3];
+      }
+      else if (strncmp(line, "@tombstone\t", 11) == 0)
+      {
+        s = findSegment(manifest, atoi(&line[11]));
+        if (s)
+        {
+          s->State = VTK_WRAP_XML_SEGMENT_BURIED;
+          buried = 1;
+        }
+      }
+      else
+      {
+        return 0;
+      }
+      continue;
+    }
+
+    if (!splitFields(line, fields, MANIFEST_FIELDS, MANIFEST_FIELDS - 1))
+    {
+      return 0;
+    }
+
+    /* the strings are already in the arena, so they are not copied */
+    e = newEntry(manifest);
+    e->Module = fields[0];
+    e->Name = fields[1];
+    e->Base = fields[2];
+    e->IsAbstract = (fields[3] ? atoi(fields[3]) : 0);
+    e->NumberOfProperties = (fields[4] ? atoi(fields[4]) : 0);
+    e->File = fields[5];
+    e->Start = (fields[6] ? (size_t)strtoul(fields[6], NULL, 10) : 0);
+    e->End = (fields[7] ? (size_t)strtoul(fields[7], NULL, 10) : 0);
+    e->Fingerprint = (fields[8] ? readFingerprint(fields[8]) : 0);
+    e->Segment = segment;
+  }
+
+  if (buried)
+  {
+    removeDeadEntries(manifest);
+  }
+
+  return 1;
+}
@@ -0,0 +1,171 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLManifest.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file provides the manifest, which lists the classes that are
+ * in a set of XML files.  For each class, it gives the module, the
+ * first base class, whether it is abstract, the number of properties,
+ * and the file and byte range of the class element.  This is enough
+ * to answer many questions about a module, e.g. "which classes are
+ * subclasses of vtkAlgorithm", without reading any of the XML.
+ *
+ * The manifest is a text file with one class per line, and with the
+ * fields separated by tabs:
+ *
+ *   module class base abstract properties file start end fingerprint
+ *
+ * Fields that are not known are written as "-".  Lines that start
+ * with "#" are comments.  The byte range is for the uncompressed text,
+ * and "end" is the offset just after the end tag of the element.  The
+ * fingerprint is the API fingerprint of the class, as hexadecimal, and
+ * it is optional so that older manifests can still be read.
+ *
+ * A manifest that is made by merging other manifests, i.e. an index,
+ * is divided into segments, where each segment holds the classes from
+ * one of the merged manifests:
+ *
+ *   @segment id mtime size source
+ *
+ * The index is updated by appending new segments for the sources that
+ * have changed, followed by tombstones for the segments that they
+ * replace:
+ *
+ *   @tombstone id
+ *
+ * so that the index never has to be rewritten for a small change.
+ * When there are more dead segments than live ones, the index is
+ * compacted by rewriting it with only the live segments.
+ */
+
+#ifndef VTK_WRAP_XML_MANIFEST_H
+#define VTK_WRAP_XML_MANIFEST_H
+
+#include "vtkWrapXMLArena.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/**
+ * A class in the manifest
+ */
+typedef struct _WrapXMLManifestEntry
+{
+  const char *Module;              /* the module, or NULL */
+  const char *Name;                /* the class name */
+  const char *Base;                /* the first base class, or NULL */
+  int         IsAbstract;          /* true if the class is abstract */
+  int         NumberOfProperties;  /* the number of properties */
+  const char *File;                /* the XML file that has the class */
+  size_t      Start;               /* the offset of the class element */
+  size_t      End;                 /* the offset after the element */
+  uint64_t    Fingerprint;         /* the API fingerprint, or zero */
+  int         Segment;             /* the segment id, or zero */
+} WrapXMLManifestEntry;
+
+/**
+ * The state of a segment, relative to the file it was read from
+ */
+#define VTK_WRAP_XML_SEGMENT_SAVED 0  /* live, and in the file */
+#define VTK_WRAP_XML_SEGMENT_NEW 1    /* live, and not in the file yet */
+#define VTK_WRAP_XML_SEGMENT_DEAD 2   /* dead, but not marked in the file */
+#define VTK_WRAP_XML_SEGMENT_BURIED 3 /* dead, with a tombstone in the file */
+
+/**
+ * A segment, which holds the classes from one merged manifest
+ */
+typedef struct _WrapXMLManifestSegment
+{
+  int         Id;      /* the id, which is never reused */
+  int         State;   /* one of the VTK_WRAP_XML_SEGMENT constants */
+  long long   MTime;   /* the modification time of the source */
+  long long   Size;    /* the size of the source */
+  const char *Source;  /* the manifest that the classes came from */
+} WrapXMLManifestSegment;
+
+/**
+ * A list of classes
+ */
+typedef struct _WrapXMLManifest
+{
+  int                     NumberOfEntries;
+  WrapXMLManifestEntry   *Entries;
+  int                     NumberOfSegments;
+  WrapXMLManifestSegment *Segments;
+  WrapXMLArena           *Arena;  /* the memory for the strings */
+} WrapXMLManifest;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Create an empty manifest
+ */
+WrapXMLManifest *vtkWrapXMLManifest_New(void);
+
+/**
+ * Add a class to the manifest.  The strings are copied.
+ */
+void vtkWrapXMLManifest_AddEntry(
+  WrapXMLManifest *manifest, const WrapXMLManifestEntry *entry);
+
+/**
+ * Add a new segment and return its id.  The classes in the segment
+ * must be added after the segment, and before any other segments.
+ */
+int vtkWrapXMLManifest_AddSegment(
+  WrapXMLManifest *manifest, const char *source,
+  long long mtime, long long size);
+
+/**
+ * Find the live segment for a source, or return NULL
+ */
+WrapXMLManifestSegment *vtkWrapXMLManifest_FindSegment(
+  WrapXMLManifest *manifest, const char *source);
+
+/**
+ * Mark a segment as dead, and remove its classes
+ */
+void vtkWrapXMLManifest_RemoveSegment(WrapXMLManifest *manifest, int id);
+
+/**
+ * Read a manifest file and add its classes to the manifest.  Segments
+ * that have tombstones are not added.  Returns zero if the file could
+ * not be read or is not a manifest.
+ */
+int vtkWrapXMLManifest_Read(WrapXMLManifest *manifest, const char *filename);
+
+/**
+ * Write the manifest to a file, the name "-" is used for stdout.  Only
+ * the live segments are written.  Returns zero if the file could not
+ * be written.
+ */
+int vtkWrapXMLManifest_Write(WrapXMLManifest *manifest, const char *filename);
+
+/**
+ * Append the new segments and the new tombstones to the file that the
+ * manifest was read from.  Returns zero if the file could not be
+ * written.
+ */
+int vtkWrapXMLManifest_Append(WrapXMLManifest *manifest, const char *filename);
+
+/**
+ * Free the manifest
+ */
+void vtkWrapXMLManifest_Free(WrapXMLManifest *manifest);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
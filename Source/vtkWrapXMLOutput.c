@@ -0,0 +1,429 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLOutput.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLOutput.h"
+#include <stdarg.h>
+#include <stdlib.h>
+#include <string.h>
+
+#ifdef VTK_WRAP_XML_USE_ZLIB
+#include <zlib.h>
+#endif
+
+#ifdef VTK_WRAP_XML_USE_ZSTD
+#include <zstd.h>
+#endif
+
+#include "vtkWrapXMLAlloc.h"
+
+/* the size of the text buffer, which is the unit of compression */
+#define OUTPUT_BUFFER_SIZE 65536
+
+/* the initial size of a memory output, which grows as needed */
+#define MEMORY_BUFFER_SIZE 4096
+
+/*-------------------------------------------------------------------
+ * information about the compression methods */
+
+int vtkWrapXMLOutput_CompressionFromString(const char *name)
+{
+  if (strcmp(name, "none") == 0)
+  {
+    return VTK_WRAP_XML_COMPRESS_NONE;
+  }
+  else if (strcmp(name, "gzip") == 0)
+  {
+    return VTK_WRAP_XML_COMPRESS_GZIP;
+  }
+  else if (strcmp(name, "zstd") == 0)
+  {
+    return VTK_WRAP_XML_COMPRESS_ZSTD;
+  }
+
+  return -1;
+}
+
+int vtkWrapXMLOutput_IsAvailable(int compression)
+{
+  switch (compression)
+  {
+    case VTK_WRAP_XML_COMPRESS_NONE:
+      return 1;
+#ifdef VTK_WRAP_XML_USE_ZLIB
+    case VTK_WRAP_XML_COMPRESS_GZIP:
+      return 1;
+#endif
+#ifdef VTK_WRAP_XML_USE_ZSTD
+    case VTK_WRAP_XML_COMPRESS_ZSTD:
+      return 1;
+#endif
+  }
+
+  return 0;
+}
+
+const char *vtkWrapXMLOutput_Suffix(int compression)
+{
+  switch (compression)
+  {
+    case VTK_WRAP_XML_COMPRESS_GZIP:
+      return ".gz";
+    case VTK_WRAP_XML_COMPRESS_ZSTD:
+      return ".zst";
+  }
+
+  return "";
+}
+
+/*-------------------------------------------------------------------
+ * write data to the file through the compressor, if "finish" is set
+ * then the compressor writes everything that it is holding */
+
+static void writePacked(
+  WrapXMLOutput *out, const char *data, size_t n, int finish)
+{
+#ifdef VTK_WRAP_XML_USE_ZLIB
+  z_stream *zs;
+  int zflush;
+  int zerr;
+#endif
+#ifdef VTK_WRAP_XML_USE_ZSTD
+  ZSTD_inBuffer zin;
+  ZSTD_outBuffer zout;
+  size_t remaining;
+#endif
+#if !defined(VTK_WRAP_XML_USE_ZLIB) && !defined(VTK_WRAP_XML_USE_ZSTD)
+  (void)finish;
+#endif
+
+  switch (out->Compression)
+  {
+#ifdef VTK_WRAP_XML_USE_ZLIB
+    case VTK_WRAP_XML_COMPRESS_GZIP:
+      zs = (z_stream *)out->Stream;
+      zs->next_in = (Bytef *)data;
+      zs->avail_in = (uInt)n;
+      zflush = (finish ? Z_FINISH : Z_NO_FLUSH);
+      do
+      {
+        zs->next_out = (Bytef *)out->Packed;
+        zs->avail_out = (uInt)out->PackedSize;
+        zerr = deflate(zs, zflush);
+        if (zerr == Z_STREAM_ERROR)
+        {
+          out->Error = 1;
+          return;
+        }
+        fwrite(out->Packed, 1, out->PackedSize - zs->avail_out, out->File);
+      }
+      while (zs->avail_out == 0 || (finish && zerr != Z_STREAM_END));
+      break;
+#endif
+
+#ifdef VTK_WRAP_XML_USE_ZSTD
+    case VTK_WRAP_XML_COMPRESS_ZSTD:
+      zin.src = data;
+      zin.size = n;
+      zin.pos = 0;
+      do
+      {
+        zout.dst = out->Packed;
+        zout.size = out->PackedSize;
+        zout.pos = 0;
+        remaining = ZSTD_compressStream2((ZSTD_CCtx *)out->Stream,
+          &zout, &zin, (finish ? ZSTD_e_end : ZSTD_e_continue));
+        if (ZSTD_isError(remaining))
+        {
+          out->Error = 1;
+          return;
+        }
+        fwrite(out->Packed, 1, zout.pos, out->File);
+      }
+      while (zin.pos < zin.size || (finish && remaining != 0));
+      break;
+#endif
+
+    default:
+      fwrite(data, 1, n, out->File);
+      break;
+  }
+}
+
+/*-------------------------------------------------------------------
+ * open and close the output */
+
+static WrapXMLOutput *openOutput(
+  const char *filename, const char *mode, int compression)
+{
+  WrapXMLOutput *out;
+  FILE *fp;
+
+  if (!vtkWrapXMLOutput_IsAvailable(compression))
+  {
+    return NULL;
+  }
+
+  if (strcmp(filename, "-") == 0)
+  {
+    fp = stdout;
+  }
+  else
+  {
+    /* binary mode, the text is written exactly as it is given */
+    fp = fopen(filename, mode);
+    if (!fp)
+    {
+      return NULL;
+    }
+  }
+
+  out = (WrapXMLOutput *)calloc(1, sizeof(WrapXMLOutput));
+  out->File = fp;
+  out->Compression = compression;
+  out->Size = OUTPUT_BUFFER_SIZE;
+  out->Buffer = (char *)malloc(out->Size);
+
+  switch (compression)
+  {
+#ifdef VTK_WRAP_XML_USE_ZLIB
+    case VTK_WRAP_XML_COMPRESS_GZIP:
+      /* the 16 in the window bits selects a gzip header */
+      out->Stream = calloc(1, sizeof(z_stream));
+      if (deflateInit2((z_stream *)out->Stream, Z_DEFAULT_COMPRESSION,
+                       Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) != Z_OK)
+      {
+        out->Error = 1;
+      }
+      out->PackedSize = OUTPUT_BUFFER_SIZE;
+      break;
+#endif
+
+#ifdef VTK_WRAP_XML_USE_ZSTD
+    case VTK_WRAP_XML_COMPRESS_ZSTD:
+      out->Stream = ZSTD_createCCtx();
+      if (out->Stream == NULL)
+      {
+        out->Error = 1;
+      }
+      out->PackedSize = ZSTD_CStreamOutSize();
+      break;
+#endif
+  }
+
+  if (out->PackedSize)
+  {
+    out->Packed = (char *)malloc(out->PackedSize);
+  }
+
+  return out;
+}
+
+WrapXMLOutput *vtkWrapXMLOutput_Open(const char *filename, int compression)
+{
+  return openOutput(filename, "wb", compression);
+}
+
+WrapXMLOutput *vtkWrapXMLOutput_Append(const char *filename, int compression)
+{
+  return openOutput(filename, "ab", compression);
+}
+
+WrapXMLOutput *vtkWrapXMLOutput_OpenMemory(void)
+{
+  WrapXMLOutput *out;
+
+  out = (WrapXMLOutput *)calloc(1, sizeof(WrapXMLOutput));
+  out->Size = MEMORY_BUFFER_SIZE;
+  out->Buffer = (char *)malloc(out->Size);
+
+  return out;
+}
+
+int vtkWrapXMLOutput_Close(WrapXMLOutput *out)
+{
+  int ok;
+
+  if (!out->Error && out->File)
+  {
+    writePacked(out, out->Buffer, out->Used, 1);
+  }
+
+  switch (out->Compression)
+  {
+#ifdef VTK_WRAP_XML_USE_ZLIB
+    case VTK_WRAP_XML_COMPRESS_GZIP:
+      deflateEnd((z_stream *)out->Stream);
+      free(out->Stream);
+      break;
+#endif
+
+#ifdef VTK_WRAP_XML_USE_ZSTD
+    case VTK_WRAP_XML_COMPRESS_ZSTD:
+      ZSTD_freeCCtx((ZSTD_CCtx *)out->Stream);
+      break;
+#endif
+  }
+
+  ok = (!out->Error && (out->File == NULL || !ferror(out->File)));
+  if (out->File == NULL)
+  {
+    /* a memory output */
+  }
+  else if (out->File == stdout)
+  {
+    ok &= (fflush(out->File) == 0);
+  }
+  else
+  {
+    ok &= (fclose(out->File) == 0);
+  }
+
+  free(out->Packed);
+  free(out->Buffer);
+  free(out);
+
+  return ok;
+}
+
+/*-------------------------------------------------------------------
+ * pass the buffered text to the file */
+
+static void flushBuffer(WrapXMLOutput *out)
+{
+  if (out->File == NULL)
+  {
+    return;
+  }
+  if (out->Used && !out->Error)
+  {
+    writePacked(out, out->Buffer, out->Used, 0);
+  }
+  out->Offset += out->Used;
+  out->Used = 0;
+}
+
+/*-------------------------------------------------------------------
+ * in memory, the buffer grows instead of being written, so that there
+ * is room for "n" more bytes and a terminating null */
+
+static void growBuffer(WrapXMLOutput *out, size_t n)
+{
+  while (n >= out->Size - out->Used)
+  {
+    out->Size *= 2;
+  }
+  out->Buffer = (char *)realloc(out->Buffer, out->Size);
+}
+
+void vtkWrapXMLOutput_Copy(WrapXMLOutput *out, WrapXMLOutput *memory)
+{
+  vtkWrapXMLOutput_Write(out, memory->Buffer, memory->Used);
+  out->Error |= memory->Error;
+  memory->Used = 0;
+  memory->Error = 0;
+}
+
+/*-------------------------------------------------------------------
+ * write text */
+
+void vtkWrapXMLOutput_Write(WrapXMLOutput *out, const char *text, size_t n)
+{
+  if (n > out->Size - out->Used && out->File == NULL)
+  {
+    growBuffer(out, n);
+  }
+  else if (n > out->Size - out->Used)
+  {
+    flushBuffer(out);
+    if (n >= out->Size)
+    {
+      /* too large to buffer, so write it directly */
+      if (!out->Error)
+      {
+        writePacked(out, text, n, 0);
+      }
+      out->Offset += n;
+      return;
+    }
+  }
+
+  memcpy(&out->Buffer[out->Used], text, n);
+  out->Used += n;
+}
+
+size_t vtkWrapXMLOutput_Tell(WrapXMLOutput *out)
+{
+  return out->Offset + out->Used;
+}
+
+void vtkWrapXMLOutput_Puts(WrapXMLOutput *out, const char *text)
+{
+  vtkWrapXMLOutput_Write(out, text, strlen(text));
+}
+
+void vtkWrapXMLOutput_Putc(WrapXMLOutput *out, int c)
+{
+  if (out->Used == out->Size)
+  {
+    if (out->File == NULL)
+    {
+      growBuffer(out, 1);
+    }
+    flushBuffer(out);
+  }
+  out->Buffer[out->Used++] = (char)c;
+}
+
+void vtkWrapXMLOutput_Printf(WrapXMLOutput *out, const char *format, ...)
+{
+  va_list ap;
+  size_t m;
+  int n;
+
+  /* format directly into the buffer */
+  va_start(ap, format);
+  m = out->Size - out->Used;
+  n = vsnprintf(&out->Buffer[out->Used], m, format, ap);
+  va_end(ap);
+
+  if (n < 0)
+  {
+    out->Error = 1;
+    return;
+  }
+
+  /* if it did not fit, make room and format it again */
+  if ((size_t)n >= m)
+  {
+    if (out->File == NULL)
+    {
+      growBuffer(out, n);
+    }
+    else
+    {
+      flushBuffer(out);
+      if ((size_t)n >= out->Size)
+      {
+        out->Size = n + 1;
+        free(out->Buffer);
+        out->Buffer = (char *)malloc(out->Size);
+      }
+    }
+    va_start(ap, format);
+    vsnprintf(&out->Buffer[out->Used], out->Size - out->Used, format, ap);
+    va_end(ap);
+  }
+
+  out->Used += n;
+}
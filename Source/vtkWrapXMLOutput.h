@@ -0,0 +1,144 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLOutput.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file provides the output sink for vtkWrapXML.  The text is
+ * collected in a buffer, and each time the buffer fills it is either
+ * written to the file as-is, or passed through a streaming compressor
+ * whose output is written to the file.  The whole document is never
+ * held in memory, and it is never compressed in a second pass.
+ *
+ * Compression with gzip requires zlib, and compression with zstd
+ * requires libzstd.  These are used if they were found at configure
+ * time, which is indicated by VTK_WRAP_XML_USE_ZLIB and
+ * VTK_WRAP_XML_USE_ZSTD.  See vtkWrapXMLInput.h for the reader.
+ *
+ * An output can also be kept in memory, in which case the buffer grows
+ * to hold all of the text.  This is used to write parts of a document
+ * concurrently, and then copy them to the file in order.
+ */
+
+#ifndef VTK_WRAP_XML_OUTPUT_H
+#define VTK_WRAP_XML_OUTPUT_H
+
+#include <stddef.h>
+#include <stdio.h>
+
+/**
+ * The compression methods
+ */
+#define VTK_WRAP_XML_COMPRESS_NONE 0
+#define VTK_WRAP_XML_COMPRESS_GZIP 1
+#define VTK_WRAP_XML_COMPRESS_ZSTD 2
+
+/**
+ * An output file
+ */
+typedef struct _WrapXMLOutput
+{
+  FILE   *File;         /* the file, stdout for "-", or NULL for memory */
+  int     Compression;  /* one of the VTK_WRAP_XML_COMPRESS constants */
+  void   *Stream;       /* the state of the compressor */
+  char   *Buffer;       /* text that has not been written yet */
+  size_t  Used;         /* the number of bytes in the buffer */
+  size_t  Offset;       /* the number of bytes before the buffer */
+  size_t  Size;         /* the size of the buffer */
+  char   *Packed;       /* the compressor output */
+  size_t  PackedSize;   /* the size of the compressor output buffer */
+  int     Error;        /* set if a write or compression failed */
+} WrapXMLOutput;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Get the compression method for "none", "gzip", or "zstd".  Returns
+ * -1 if the name is not recognized.
+ */
+int vtkWrapXMLOutput_CompressionFromString(const char *name);
+
+/**
+ * Check whether a compression method was enabled at configure time
+ */
+int vtkWrapXMLOutput_IsAvailable(int compression);
+
+/**
+ * Get the file suffix for a compression method, e.g. ".gz"
+ */
+const char *vtkWrapXMLOutput_Suffix(int compression);
+
+/**
+ * Open a file for writing, the name "-" is used for stdout.  Returns
+ * NULL if the file could not be opened, or if the compression method
+ * is not available.
+ */
+WrapXMLOutput *vtkWrapXMLOutput_Open(const char *filename, int compression);
+
+/**
+ * Open a file for appending.  If the output is compressed, then a new
+ * gzip member or zstd frame is started, which vtkWrapXMLInput reads as
+ * if it were part of the previous one.  The offsets that are given by
+ * vtkWrapXMLOutput_Tell() start at zero, not at the end of the file.
+ */
+WrapXMLOutput *vtkWrapXMLOutput_Append(const char *filename, int compression);
+
+/**
+ * Create an output that is kept in memory, it is freed by Close
+ */
+WrapXMLOutput *vtkWrapXMLOutput_OpenMemory(void);
+
+/**
+ * Copy the text of a memory output to another output, and empty the
+ * memory output so that it can be used again
+ */
+void vtkWrapXMLOutput_Copy(WrapXMLOutput *out, WrapXMLOutput *memory);
+
+/**
+ * Write "n" bytes of text
+ */
+void vtkWrapXMLOutput_Write(WrapXMLOutput *out, const char *text, size_t n);
+
+/**
+ * Write a null-terminated string
+ */
+void vtkWrapXMLOutput_Puts(WrapXMLOutput *out, const char *text);
+
+/**
+ * Write a single character
+ */
+void vtkWrapXMLOutput_Putc(WrapXMLOutput *out, int c);
+
+/**
+ * Write formatted text, like fprintf()
+ */
+void vtkWrapXMLOutput_Printf(WrapXMLOutput *out, const char *format, ...);
+
+/**
+ * Get the number of bytes of text that have been written so far.  For
+ * compressed output, this is the offset in the uncompressed text.
+ */
+size_t vtkWrapXMLOutput_Tell(WrapXMLOutput *out);
+
+/**
+ * Flush the compressor, close the file, and free the sink.  Returns
+ * zero if any of the data could not be written.
+ */
+int vtkWrapXMLOutput_Close(WrapXMLOutput *out);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,349 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLOverloads.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLOverloads.h"
+#include "vtkParseProperties.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* a method, for sorting the methods by name */
+typedef struct _overload_method
+{
+  FunctionInfo *func;
+  int order; /* the position in the class */
+} overload_method_t;
+
+/*-------------------------------------------------------------------
+ * check for the functions that are written as methods */
+
+int vtkWrapXMLOverloads_IsMethod(ClassInfo *classInfo, FunctionInfo *func)
+{
+  return (func->Name && !func->IsDeleted && !func->IsOperator &&
+          func->ReturnValue &&
+          strcmp(func->Name, classInfo->Name) != 0 &&
+          !(func->Name[0] == '~' &&
+            strcmp(&func->Name[1], classInfo->Name) == 0));
+}
+
+/*-------------------------------------------------------------------
+ * check for the methods that a wrapper could call */
+
+static int isCallable(FunctionInfo *func)
+{
+  int i;
+
+  if (func->Access != VTK_ACCESS_PUBLIC || func->Template ||
+      func->IsVariadic)
+  {
+    return 0;
+  }
+
+  for (i = 0; i < func->NumberOfParameters; i++)
+  {
+    if (func->Parameters[i]->IsPack)
+    {
+      return 0;
+    }
+  }
+
+  return 1;
+}
+
+/*-------------------------------------------------------------------
+ * get the type class of an argument */
+
+char vtkWrapXMLOverloads_TypeClass(ValueInfo *val)
+{
+  unsigned int baseType = (val->Type & VTK_PARSE_BASE_TYPE);
+  unsigned int pointers = (val->Type & VTK_PARSE_POINTER_MASK);
+  int isArray = 0;
+  char c = 'x';
+
+  if (val->Function)
+  {
+    return 'x';
+  }
+
+  if (baseType == VTK_PARSE_OBJECT)
+  {
+    return (pointers == 0 ? 'v' :
+            (pointers == VTK_PARSE_POINTER ? 'o' : 'x'));
+  }
+
+  if (baseType == VTK_PARSE_STRING)
+  {
+    return (pointers == 0 ? 's' : 'x');
+  }
+
+  if (baseType == VTK_PARSE_CHAR && pointers == VTK_PARSE_POINTER &&
+      val->Count == 0)
+  {
+    return 's';
+  }
+
+  /* one level of pointer or array */
+  if (pointers != 0)
+  {
+    if ((pointers & ~VTK_PARSE_POINTER_LOWMASK) != 0)
+    {
+      return 'x';
+    }
+    isArray = 1;
+  }
+
+  switch (baseType)
+  {
+    case VTK_PARSE_BOOL:
+      c = 'q';
+      break;
+    case VTK_PARSE_CHAR:
+      c = 'c';
+      break;
+    case VTK_PARSE_FLOAT:
+      c = 'f';
+      break;
+    case VTK_PARSE_DOUBLE:
+      c = 'd';
+      break;
+    case VTK_PARSE_SIGNED_CHAR:
+    case VTK_PARSE_UNSIGNED_CHAR:
+    case VTK_PARSE_SHORT:
+    case VTK_PARSE_UNSIGNED_SHORT:
+    case VTK_PARSE_INT:
+    case VTK_PARSE_UNSIGNED_INT:
+    case VTK_PARSE_LONG:
+    case VTK_PARSE_UNSIGNED_LONG:
+    case VTK_PARSE_LONG_LONG:
+    case VTK_PARSE_UNSIGNED_LONG_LONG:
+    case VTK_PARSE_ID_TYPE:
+    case VTK_PARSE_SIZE_T:
+    case VTK_PARSE_SSIZE_T:
+      c = 'i';
+      break;
+    default:
+      return 'x';
+  }
+
+  return (isArray ? (char)(c - 'a' + 'A') : c);
+}
+
+/*-------------------------------------------------------------------
+ * sort the methods by name, and keep the declaration order */
+
+static int compareMethods(const void *a, const void *b)
+{
+  const overload_method_t *m1 = (const overload_method_t *)a;
+  const overload_method_t *m2 = (const overload_method_t *)b;
+  int r = strcmp(m1->func->Name, m2->func->Name);
+
+  if (r == 0)
+  {
+    r = (m1->order < m2->order ? -1 : (m1->order > m2->order));
+  }
+
+  return r;
+}
+
+/*-------------------------------------------------------------------
+ * compare two overloads with the same arity, returns a negative value
+ * if the first should be tried first */
+
+static int compareOverloads(
+  const WrapXMLOverload *o1, const WrapXMLOverload *o2)
+{
+  FunctionInfo *f1 = o1->Function;
+  FunctionInfo *f2 = o2->Function;
+  ValueInfo *a1;
+  ValueInfo *a2;
+  int i, r;
+
+  /* the first argument where one type is preferred decides */
+  for (i = 0; i < o1->Arity; i++)
+  {
+    a1 = f1->Parameters[i];
+    a2 = f2->Parameters[i];
+    if ((a1->Type & VTK_PARSE_POINTER_MASK) ==
+        (a2->Type & VTK_PARSE_POINTER_MASK))
+    {
+      r = vtkParseProperties_ComparePreference(
+        a1->Type, a1->Count, 0, a2->Type, a2->Count, 0);
+      if (r != 0)
+      {
+        return r;
+      }
+    }
+  }
+
+  r = vtkParseProperties_ComparePreference(
+    0, 0, f1->IsLegacy, 0, 0, f2->IsLegacy);
+  if (r != 0)
+  {
+    return r;
+  }
+
+  /* methods that need no default arguments */
+  r = ((f1->NumberOfParameters != o1->Arity) -
+       (f2->NumberOfParameters != o2->Arity));
+  if (r != 0)
+  {
+    return r;
+  }
+
+  return (o1->Index < o2->Index ? -1 : (o1->Index > o2->Index));
+}
+
+/*-------------------------------------------------------------------
+ * add the entries for one method, one for each arity it accepts */
+
+static void addEntries(
+  WrapXMLOverloadSet *set, FunctionInfo *func, int index,
+  WrapXMLArena *arena)
+{
+  WrapXMLOverload *entry;
+  char *key;
+  int minArity, arity, i;
+  int n = func->NumberOfParameters;
+
+  minArity = n;
+  while (minArity > 0 && func->Parameters[minArity - 1]->Value)
+  {
+    minArity--;
+  }
+
+  key = (char *)vtkWrapXMLArena_Alloc(arena, n + 1);
+  for (i = 0; i < n; i++)
+  {
+    key[i] = vtkWrapXMLOverloads_TypeClass(func->Parameters[i]);
+  }
+
+  for (arity = minArity; arity <= n; arity++)
+  {
+    entry = &set->Entries[set->NumberOfEntries++];
+    entry->Function = func;
+    entry->Index = index;
+    entry->Arity = arity;
+    if (arity == n)
+    {
+      entry->Key = key;
+    }
+    else
+    {
+      entry->Key = vtkWrapXMLArena_Alloc(arena, arity + 1);
+      memcpy((char *)entry->Key, key, arity);
+    }
+  }
+}
+
+/*-------------------------------------------------------------------
+ * sort the entries by arity, and then into dispatch order, the sets
+ * are small so an insertion sort is used */
+
+static void sortEntries(WrapXMLOverloadSet *set)
+{
+  WrapXMLOverload entry;
+  int i, j;
+
+  for (i = 1; i < set->NumberOfEntries; i++)
+  {
+    entry = set->Entries[i];
+    for (j = i; j > 0; j--)
+    {
+      if (set->Entries[j - 1].Arity < entry.Arity ||
+          (set->Entries[j - 1].Arity == entry.Arity &&
+           compareOverloads(&set->Entries[j - 1], &entry) <= 0))
+      {
+        break;
+      }
+      set->Entries[j] = set->Entries[j - 1];
+    }
+    set->Entries[j] = entry;
+  }
+}
+
+/*-------------------------------------------------------------------
+ * find the overload sets of a class */
+
+void vtkWrapXMLOverloads_Find(
+  WrapXMLOverloads *overloads, ClassInfo *classInfo, WrapXMLArena *arena)
+{
+  overload_method_t *methods;
+  WrapXMLOverloadSet *set;
+  FunctionInfo *func;
+  int n, i, j, k, m, callable, entries;
+
+  memset(overloads, 0, sizeof(WrapXMLOverloads));
+
+  /* sort the methods by name, so that each name is a run */
+  methods = (overload_method_t *)vtkWrapXMLArena_Alloc(
+    arena, sizeof(overload_method_t)*(classInfo->NumberOfFunctions + 1));
+  n = 0;
+  for (i = 0; i < classInfo->NumberOfFunctions; i++)
+  {
+    func = classInfo->Functions[i];
+    if (vtkWrapXMLOverloads_IsMethod(classInfo, func))
+    {
+      methods[n].func = func;
+      methods[n].order = i;
+      n++;
+    }
+  }
+  qsort(methods, n, sizeof(overload_method_t), compareMethods);
+
+  /* there are at most n/2 sets */
+  overloads->Sets = (WrapXMLOverloadSet *)vtkWrapXMLArena_Alloc(
+    arena, sizeof(WrapXMLOverloadSet)*(n/2 + 1));
+
+  for (i = 0; i < n; i = j)
+  {
+    /* find the run, and count the methods that can be called */
+    callable = 0;
+    entries = 0;
+    for (j = i; j < n &&
+         strcmp(methods[j].func->Name, methods[i].func->Name) == 0; j++)
+    {
+      if (isCallable(methods[j].func))
+      {
+        callable++;
+        func = methods[j].func;
+        m = func->NumberOfParameters;
+        while (m > 0 && func->Parameters[m - 1]->Value)
+        {
+          m--;
+        }
+        entries += func->NumberOfParameters - m + 1;
+      }
+    }
+
+    if (callable < 2)
+    {
+      continue;
+    }
+
+    set = &overloads->Sets[overloads->NumberOfSets++];
+    set->Name = methods[i].func->Name;
+    set->NumberOfMethods = callable;
+    set->Entries = (WrapXMLOverload *)vtkWrapXMLArena_Alloc(
+      arena, sizeof(WrapXMLOverload)*entries);
+
+    for (k = i; k < j; k++)
+    {
+      if (isCallable(methods[k].func))
+      {
+        addEntries(set, methods[k].func, k - i, arena);
+      }
+    }
+
+    sortEntries(set);
+  }
+}
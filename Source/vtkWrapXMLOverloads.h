@@ -0,0 +1,110 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLOverloads.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file groups the overloaded methods of a class into sets, and
+ * puts each set into the order in which a wrapper should try them when
+ * it is called with a given number of arguments.  Within an arity, the
+ * methods are ordered by the rules that vtkParseProperties uses for
+ * repeated methods ("double" before "float", larger arrays first, and
+ * non-legacy methods first), then methods that take exactly that many
+ * arguments come before methods that need their default arguments, and
+ * otherwise the declaration order is kept.
+ *
+ * Each argument is given a type class, as one character:
+ *
+ *   q  bool           Q  bool array
+ *   c  char           C  char array, other than a string
+ *   i  integer        I  integer array
+ *   f  float          F  float array
+ *   d  double         D  double array
+ *   s  string, either "char *" or a std::string
+ *   o  pointer to an object
+ *   v  object or struct, by value or by reference
+ *   x  anything else
+ *
+ * Only the public methods that a wrapper could call are put in the
+ * sets: not templates, not variadic, not operators, and not the
+ * constructors or destructor.
+ */
+
+#ifndef VTK_WRAP_XML_OVERLOADS_H
+#define VTK_WRAP_XML_OVERLOADS_H
+
+#include "vtkParseData.h"
+#include "vtkWrapXMLArena.h"
+
+/**
+ * A method in the dispatch order for one arity
+ */
+typedef struct _WrapXMLOverload
+{
+  FunctionInfo  *Function;  /* the method */
+  int            Index;     /* its position among the methods of the name */
+  int            Arity;     /* the number of arguments */
+  const char    *Key;       /* the type class of each argument */
+} WrapXMLOverload;
+
+/**
+ * The overloads of one method name, sorted by arity and then in the
+ * order of dispatch, a method with default arguments is there once
+ * for each arity that it accepts
+ */
+typedef struct _WrapXMLOverloadSet
+{
+  const char       *Name;              /* the method name */
+  int               NumberOfMethods;   /* the methods in the set */
+  int               NumberOfEntries;   /* the methods for all arities */
+  WrapXMLOverload  *Entries;
+} WrapXMLOverloadSet;
+
+/**
+ * The overload sets of a class, in order of name
+ */
+typedef struct _WrapXMLOverloads
+{
+  int                  NumberOfSets;
+  WrapXMLOverloadSet  *Sets;
+} WrapXMLOverloads;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Find the overload sets of a class, that is, the names that are used
+ * by more than one public method.  The "Index" of each method counts
+ * all the methods of the same name in declaration order, including
+ * the ones that are not in the set.  All memory is from the arena.
+ */
+void vtkWrapXMLOverloads_Find(
+  WrapXMLOverloads *overloads, ClassInfo *classInfo, WrapXMLArena *arena);
+
+/**
+ * Check whether a function of a class is written as a method, rather
+ * than as a constructor, destructor, or operator.  These are the
+ * methods that the "Index" counts.
+ */
+int vtkWrapXMLOverloads_IsMethod(ClassInfo *classInfo, FunctionInfo *func);
+
+/**
+ * Get the type class of an argument
+ */
+char vtkWrapXMLOverloads_TypeClass(ValueInfo *val);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,237 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLPerfectHash.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLPerfectHash.h"
+#include "vtkWrapXMLHash.h"
+#include <string.h>
+
+/* the multiplier for the words of a key */
+#define WRAPXML_KEY_MULTIPLIER 0x9e3779b97f4a7c15ull
+
+/* the largest displacement that is tried for a bucket */
+#define WRAPXML_MAX_DISPLACEMENT 0x01000000u
+
+/*-------------------------------------------------------------------
+ * hashing */
+
+/* read a little-endian word, compilers turn this into a single load */
+static uint64_t loadWord(const unsigned char *cp)
+{
+  return ((uint64_t)cp[0] | ((uint64_t)cp[1] << 8) |
+          ((uint64_t)cp[2] << 16) | ((uint64_t)cp[3] << 24) |
+          ((uint64_t)cp[4] << 32) | ((uint64_t)cp[5] << 40) |
+          ((uint64_t)cp[6] << 48) | ((uint64_t)cp[7] << 56));
+}
+
+uint64_t vtkWrapXMLPerfectHash_Key(const char *key)
+{
+  const unsigned char *cp = (const unsigned char *)key;
+  size_t n = strlen(key);
+  uint64_t h = VTK_WRAP_XML_HASH_INIT;
+  uint64_t w;
+  int i;
+
+  /* the words are read as little-endian on every platform */
+  for (; n >= 8; n -= 8, cp += 8)
+  {
+    h = (h ^ loadWord(cp))*WRAPXML_KEY_MULTIPLIER;
+  }
+  w = 0;
+  for (i = (int)n - 1; i >= 0; i--)
+  {
+    w = (w << 8) | cp[i];
+  }
+  h = (h ^ w)*WRAPXML_KEY_MULTIPLIER;
+
+  /* mix the high bits into the low bits, which select the bucket */
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  return h;
+}
+
+/* the bucket for a hash, a multiply and shift is used instead of
+   a modulus because it is much faster than a division */
+static int bucketOf(uint64_t h, int nb)
+{
+  return (int)(((h & 0xffffffffu) * (uint64_t)nb) >> 32);
+}
+
+/* the slot for a hash with the given displacement */
+static int displacedSlot(uint64_t h, unsigned int d, int size)
+{
+  uint64_t x = h ^ ((uint64_t)d * 0x9e3779b97f4a7c15ull);
+  x *= 0xff51afd7ed558ccdull;
+  return (int)(((x >> 32) * (uint64_t)size) >> 32);
+}
+
+int vtkWrapXMLPerfectHash_Slot(const WrapXMLPerfectHash *table, uint64_t h)
+{
+  unsigned int d;
+
+  d = table->Displacements[bucketOf(h, table->NumberOfBuckets)];
+  return displacedSlot(h, d, table->Size);
+}
+
+/*-------------------------------------------------------------------
+ * building the table */
+
+int vtkWrapXMLPerfectHash_Build(
+  WrapXMLPerfectHash *table, const char *const *keys, int n,
+  WrapXMLArena *arena)
+{
+  uint64_t *hashes;
+  int *counts;
+  int *starts;
+  int *members;
+  int *slots;
+  int nb, b, i, j, k, m, size, maxCount;
+  unsigned int d;
+
+  memset(table, 0, sizeof(WrapXMLPerfectHash));
+  if (n <= 0)
+  {
+    return 1;
+  }
+
+  /* about four keys per bucket, which keeps the displacements small */
+  nb = n/4 + 1;
+  table->Size = n;
+  table->NumberOfBuckets = nb;
+  table->Displacements = (unsigned int *)vtkWrapXMLArena_Alloc(
+    arena, nb*sizeof(unsigned int));
+  table->Slots = (int *)vtkWrapXMLArena_Alloc(arena, n*sizeof(int));
+  for (i = 0; i < n; i++)
+  {
+    table->Slots[i] = -1;
+  }
+
+  hashes = (uint64_t *)vtkWrapXMLArena_Alloc(arena, n*sizeof(uint64_t));
+  counts = (int *)vtkWrapXMLArena_Alloc(arena, nb*sizeof(int));
+  starts = (int *)vtkWrapXMLArena_Alloc(arena, (nb + 1)*sizeof(int));
+  members = (int *)vtkWrapXMLArena_Alloc(arena, n*sizeof(int));
+  slots = (int *)vtkWrapXMLArena_Alloc(arena, n*sizeof(int));
+
+  /* sort the keys into buckets, dropping the repeated keys */
+  for (i = 0; i < n; i++)
+  {
+    hashes[i] = vtkWrapXMLPerfectHash_Key(keys[i]);
+    counts[bucketOf(hashes[i], nb)]++;
+  }
+  for (b = 0; b < nb; b++)
+  {
+    starts[b + 1] = starts[b] + counts[b];
+    counts[b] = 0;
+  }
+  for (i = 0; i < n; i++)
+  {
+    b = bucketOf(hashes[i], nb);
+    for (j = 0; j < counts[b]; j++)
+    {
+      k = members[starts[b] + j];
+      if (hashes[k] == hashes[i])
+      {
+        if (strcmp(keys[k], keys[i]) != 0)
+        {
+          /* two keys that no displacement can separate */
+          return 0;
+        }
+        break;
+      }
+    }
+    if (j == counts[b])
+    {
+      members[starts[b] + counts[b]++] = i;
+    }
+  }
+
+  maxCount = 0;
+  for (b = 0; b < nb; b++)
+  {
+    maxCount = (counts[b] > maxCount ? counts[b] : maxCount);
+  }
+
+  /* place the largest buckets first, while the table is empty */
+  for (size = maxCount; size > 0; size--)
+  {
+    for (b = 0; b < nb; b++)
+    {
+      if (counts[b] != size)
+      {
+        continue;
+      }
+      for (d = 0; d < WRAPXML_MAX_DISPLACEMENT; d++)
+      {
+        for (j = 0; j < size; j++)
+        {
+          slots[j] = displacedSlot(hashes[members[starts[b] + j]], d, n);
+          if (table->Slots[slots[j]] >= 0)
+          {
+            break;
+          }
+          for (m = 0; m < j && slots[m] != slots[j]; m++) { ; }
+          if (m < j)
+          {
+            break;
+          }
+        }
+        if (j == size)
+        {
+          break;
+        }
+      }
+      if (d == WRAPXML_MAX_DISPLACEMENT)
+      {
+        return 0;
+      }
+      table->Displacements[b] = d;
+      for (j = 0; j < size; j++)
+      {
+        table->Slots[slots[j]] = members[starts[b] + j];
+      }
+    }
+  }
+
+  return 1;
+}
+
+/*-------------------------------------------------------------------
+ * writing the table */
+
+void vtkWrapXMLPerfectHash_Write(
+  WrapXMLOutput *out, const WrapXMLPerfectHash *table, const char *prefix)
+{
+  int i;
+
+  if (table->Size == 0)
+  {
+    return;
+  }
+
+  vtkWrapXMLOutput_Printf(out,
+    "static constexpr unsigned int %sDisplacements[] = {", prefix);
+  for (i = 0; i < table->NumberOfBuckets; i++)
+  {
+    vtkWrapXMLOutput_Printf(out, "%s%u,", (i % 8 == 0 ? "\n  " : " "),
+                            table->Displacements[i]);
+  }
+  vtkWrapXMLOutput_Printf(out,
+    "\n};\n\nstatic constexpr int %sSlots[] = {", prefix);
+  for (i = 0; i < table->Size; i++)
+  {
+    vtkWrapXMLOutput_Printf(out, "%s%d,", (i % 8 == 0 ? "\n  " : " "),
+                            table->Slots[i]);
+  }
+  vtkWrapXMLOutput_Puts(out, "\n};\n\n");
+}
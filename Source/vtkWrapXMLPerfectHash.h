@@ -0,0 +1,99 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLPerfectHash.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file builds minimal perfect hash tables over sets of names, so
+ * that the generated reflection tables can be searched with one hash
+ * and one string compare.  The method is "hash and displace": the keys
+ * are hashed once, the hash selects a bucket, and each bucket has a
+ * displacement that was chosen so that the keys of all the buckets go
+ * to distinct slots.  The table has one slot per key.
+ *
+ * The hash reads the name as little-endian 64-bit words, where the last
+ * word holds the remaining 0 to 7 characters and is zero-padded.  Each
+ * word "w" is combined as "h = (h ^ w) * 0x9e3779b97f4a7c15", starting
+ * from the FNV offset basis 0xcbf29ce484222325, and then the hash gets
+ * a final mix:
+ *
+ *   h ^= h >> 33;  h *= 0xff51afd7ed558ccd;  h ^= h >> 33;
+ *
+ * One multiply per word instead of one per character is what makes the
+ * lookups fast.  The slot for a hash "h" is computed as follows with
+ * 64-bit unsigned arithmetic, where "d" is the displacement of the bucket:
+ *
+ *   bucket = ((h & 0xffffffff) * buckets) >> 32
+ *   x = (h ^ (d * 0x9e3779b97f4a7c15)) * 0xff51afd7ed558ccd
+ *   slot = ((x >> 32) * size) >> 32
+ *
+ * The multiplies and shifts map the hash onto the range of buckets or
+ * slots without the cost of a division.
+ * The same computation is done by the lookup functions that are in
+ * vtkWrapXMLReflection.h, so the two must be kept in agreement.
+ */
+
+#ifndef VTK_WRAP_XML_PERFECT_HASH_H
+#define VTK_WRAP_XML_PERFECT_HASH_H
+
+#include "vtkWrapXMLArena.h"
+#include "vtkWrapXMLOutput.h"
+#include <stdint.h>
+
+/**
+ * A perfect hash table over a list of keys
+ */
+typedef struct _WrapXMLPerfectHash
+{
+  int           Size;             /* the number of slots */
+  int           NumberOfBuckets;  /* the number of displacements */
+  unsigned int *Displacements;    /* the displacement of each bucket */
+  int          *Slots;            /* the key in each slot, or -1 */
+} WrapXMLPerfectHash;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Get the hash of a key
+ */
+uint64_t vtkWrapXMLPerfectHash_Key(const char *key);
+
+/**
+ * Get the slot for a hash
+ */
+int vtkWrapXMLPerfectHash_Slot(const WrapXMLPerfectHash *table, uint64_t h);
+
+/**
+ * Build the table for a list of keys, with all memory from the arena.
+ * If a key is repeated, only its first occurrence is put in the table.
+ * Returns zero if no table could be found, which only happens if two
+ * distinct keys have the same 64-bit hash.
+ */
+int vtkWrapXMLPerfectHash_Build(
+  WrapXMLPerfectHash *table, const char *const *keys, int n,
+  WrapXMLArena *arena);
+
+/**
+ * Write the table as two constexpr C++ arrays, named by appending
+ * "Displacements" and "Slots" to the prefix.  Nothing is written if
+ * the table is empty.
+ */
+void vtkWrapXMLPerfectHash_Write(
+  WrapXMLOutput *out, const WrapXMLPerfectHash *table, const char *prefix);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,465 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLProperties.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ The vtkWrapXMLProperties program merges and queries the property tables
+ that are written by "vtkWrapXML --property-table".  With "-o", the
+ tables are merged into a single table, which is how a table is made for
+ each module from the tables of its headers, and then a table for all of
+ the modules.
+
+ Without "-o", the tables are queried, and the matching properties are
+ printed with one property per line, and with the class, the property,
+ the type, and the public methods separated by tabs:
+
+   vtkWrapXMLProperties --public SET_CLAMP --type "double[3]" all.properties
+   vtkWrapXMLProperties --public SET_VALUE_TO --classes all.properties
+
+ The methods are given by the names that are used for the "bitfield"
+ attribute in the XML, e.g. "SET|GET_MULTI", and every method that is
+ given must be present.  The type is the type name, as written in the
+ "type" attribute, optionally followed by the count in brackets.
+*/
+
+#include "vtkParseProperties.h"
+#include "vtkWrapXMLInput.h"
+#include "vtkWrapXMLPropertyTable.h"
+#include "vtkWrapXMLSystem.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Print the usage and exit
+ */
+static void vtkWrapXMLProperties_Usage(void)
+{
+  fprintf(stderr,
+    "Usage: vtkWrapXMLProperties -o <table> <table>...\n"
+    "       vtkWrapXMLProperties [query options] <table>...\n"
+    "  -o <table>          merge the tables, \"-\" for stdout\n"
+    "  --public <methods>  the public methods, e.g. \"SET|GET\"\n"
+    "  --protected <methods>  the protected methods\n"
+    "  --legacy <methods>  the legacy methods\n"
+    "  --class <name>      the class\n"
+    "  --name <name>       the property\n"
+    "  --type <type>       the type, e.g. \"double\" or \"double[3]\"\n"
+    "  --classes           print the classes, instead of the properties\n"
+    "  --count             print the number of properties that match\n"
+    "  --time              print the time taken by the query\n"
+    "  @<file>             read the table names from a file\n");
+  exit(1);
+}
+
+/**
+ * Convert a list of method names, separated by "|", to a bitfield
+ */
+static unsigned int vtkWrapXMLProperties_Methods(const char *text)
+{
+  static const unsigned int groups[2] = {
+    VTK_METHOD_SET_CLAMP, VTK_METHOD_SET_BOOL };
+  const char *name;
+  unsigned int methods = 0;
+  unsigned int bit;
+  size_t n;
+  int i;
+
+  while (*text != '\0')
+  {
+    n = strcspn(text, "|");
+    bit = 0;
+
+    for (i = 0; i < 2 && bit == 0; i++)
+    {
+      name = vtkParseProperties_MethodTypeAsString(groups[i]);
+      if (strlen(name) == n && strncmp(name, text, n) == 0)
+      {
+        bit = groups[i];
+      }
+    }
+
+    for (i = 0; i < 32 && bit == 0; i++)
+    {
+      name = vtkParseProperties_MethodTypeAsString(1u << i);
+      if (strlen(name) == n && strncmp(name, text, n) == 0 &&
+          strcmp(name, "UNKNOWN") != 0)
+      {
+        bit = (1u << i);
+      }
+    }
+
+    if (bit == 0)
+    {
+      fprintf(stderr, "vtkWrapXMLProperties: unknown method %.*s\n",
+              (int)n, text);
+      exit(1);
+    }
+
+    methods |= bit;
+    text += n;
+    if (*text == '|')
+    {
+      text++;
+    }
+  }
+
+  return methods;
+}
+
+/**
+ * Print a bitfield of methods, in the same way as the XML
+ */
+static void vtkWrapXMLProperties_PrintMethods(unsigned int methods)
+{
+  unsigned int methodType;
+  unsigned int i;
+  int first = 1;
+
+  for (i = 0; i < 32; i++)
+  {
+    methodType = methods & (1u << i);
+    if (methodType)
+    {
+      if ((methodType & VTK_METHOD_SET_CLAMP) != 0 &&
+          (methods & VTK_METHOD_SET_CLAMP) == VTK_METHOD_SET_CLAMP)
+      {
+        methodType = VTK_METHOD_SET_CLAMP;
+        methods &= ~VTK_METHOD_SET_CLAMP;
+      }
+      else if ((methodType & VTK_METHOD_SET_BOOL) != 0 &&
+          (methods & VTK_METHOD_SET_BOOL) == VTK_METHOD_SET_BOOL)
+      {
+        methodType = VTK_METHOD_SET_BOOL;
+        methods &= ~VTK_METHOD_SET_BOOL;
+      }
+
+      printf("%s%s", (first ? "" : "|"),
+             vtkParseProperties_MethodTypeAsString(methodType));
+      first = 0;
+    }
+  }
+
+  if (first)
+  {
+    printf("-");
+  }
+}
+
+/**
+ * Read a table and merge it into the output
+ */
+static void vtkWrapXMLProperties_Merge(
+  WrapXMLPropertyTable *output, const char *filename)
+{
+  WrapXMLPropertyTable *input;
+
+  input = vtkWrapXMLPropertyTable_Read(filename);
+  if (input == NULL)
+  {
+    fprintf(stderr, "vtkWrapXMLProperties: cannot read table %s\n",
+            filename);
+    exit(1);
+  }
+
+  vtkWrapXMLPropertyTable_Merge(output, input);
+  vtkWrapXMLPropertyTable_Free(input);
+}
+
+/**
+ * Merge all the tables that are listed in a file
+ */
+static void vtkWrapXMLProperties_MergeList(
+  WrapXMLPropertyTable *output, const char *listfile)
+{
+  char *text;
+  char *cp;
+  char *line;
+  size_t n;
+
+  text = vtkWrapXMLInput_ReadAll(listfile, &n);
+  if (text == NULL)
+  {
+    fprintf(stderr, "vtkWrapXMLProperties: cannot read %s\n", listfile);
+    exit(1);
+  }
+
+  for (cp = text; *cp != '\0';)
+  {
+    line = cp;
+    while (*cp != '\n' && *cp != '\r' && *cp != '\0')
+    {
+      cp++;
+    }
+    if (*cp != '\0')
+    {
+      *cp++ = '\0';
+    }
+    if (line[0] != '\0')
+    {
+      vtkWrapXMLProperties_Merge(output, line);
+    }
+  }
+
+  free(text);
+}
+
+/**
+ * Get a string from the table, or "-" for a missing string
+ */
+static const char *vtkWrapXMLProperties_String(
+  WrapXMLPropertyTable *table, unsigned int id)
+{
+  return (id < table->NumberOfStrings ? table->Strings[id] : "-");
+}
+
+/**
+ * Print the rows that matched, or the distinct classes of those rows
+ */
+static void vtkWrapXMLProperties_Print(
+  WrapXMLPropertyTable *table, const unsigned int *matches, int classes)
+{
+  const unsigned int *classIds = table->Columns[VTK_WRAP_XML_COLUMN_CLASS];
+  const unsigned int *typeNames = table->Columns[VTK_WRAP_XML_COLUMN_TYPENAME];
+  const unsigned int *counts = table->Columns[VTK_WRAP_XML_COLUMN_COUNT];
+  const unsigned int *names = table->Columns[VTK_WRAP_XML_COLUMN_NAME];
+  const unsigned int *methods = table->Columns[VTK_WRAP_XML_COLUMN_PUBLIC];
+  char *seen = NULL;
+  unsigned int i;
+
+  if (classes)
+  {
+    seen = (char *)calloc(table->NumberOfStrings + 1, 1);
+  }
+
+  for (i = 0; i < table->NumberOfRows; i++)
+  {
+    if ((matches[i >> 5] & (1u << (i & 31))) == 0)
+    {
+      continue;
+    }
+
+    if (classes)
+    {
+      if (classIds[i] < table->NumberOfStrings && !seen[classIds[i]])
+      {
+        seen[classIds[i]] = 1;
+        printf("%s\n", table->Strings[classIds[i]]);
+      }
+      continue;
+    }
+
+    printf("%s\t%s\t", vtkWrapXMLProperties_String(table, classIds[i]),
+           vtkWrapXMLProperties_String(table, names[i]));
+    if (typeNames[i] == VTK_WRAP_XML_NO_STRING)
+    {
+      printf("-");
+    }
+    else if (counts[i] > 0)
+    {
+      printf("%s[%u]", table->Strings[typeNames[i]], counts[i]);
+    }
+    else
+    {
+      printf("%s", table->Strings[typeNames[i]]);
+    }
+    printf("\t");
+    vtkWrapXMLProperties_PrintMethods(methods[i]);
+    printf("\n");
+  }
+
+  free(seen);
+}
+
+/**
+ * Set a string in the query, a string that is not in the table cannot
+ * match, so it is given an id that no row has
+ */
+static unsigned int vtkWrapXMLProperties_Id(
+  WrapXMLPropertyTable *table, const char *text)
+{
+  unsigned int id = vtkWrapXMLPropertyTable_FindString(table, text);
+
+  return (id == VTK_WRAP_XML_NO_STRING ? table->NumberOfStrings : id);
+}
+
+int main(int argc, char *argv[])
+{
+  WrapXMLPropertyTable *table;
+  WrapXMLPropertyQuery query;
+  const char *outputFile = NULL;
+  const char *className = NULL;
+  const char *name = NULL;
+  const char *type = NULL;
+  char *typeName = NULL;
+  const char *cp;
+  unsigned int *matches;
+  unsigned int count;
+  int classes = 0;
+  int countOnly = 0;
+  int timing = 0;
+  double start, elapsed;
+  size_t n;
+  int i;
+
+  vtkWrapXMLPropertyTable_InitQuery(&query);
+
+  /* get the options, they must precede the tables */
+  for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++)
+  {
+    if (strcmp(argv[i], "--classes") == 0)
+    {
+      classes = 1;
+    }
+    else if (strcmp(argv[i], "--count") == 0)
+    {
+      countOnly = 1;
+    }
+    else if (strcmp(argv[i], "--time") == 0)
+    {
+      timing = 1;
+    }
+    else if (i + 1 >= argc)
+    {
+      vtkWrapXMLProperties_Usage();
+    }
+    else if (strcmp(argv[i], "-o") == 0)
+    {
+      outputFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "--public") == 0)
+    {
+      query.PublicMethods |= vtkWrapXMLProperties_Methods(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--protected") == 0)
+    {
+      query.ProtectedMethods |= vtkWrapXMLProperties_Methods(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--legacy") == 0)
+    {
+      query.LegacyMethods |= vtkWrapXMLProperties_Methods(argv[++i]);
+    }
+    else if (strcmp(argv[i], "--class") == 0)
+    {
+      className = argv[++i];
+    }
+    else if (strcmp(argv[i], "--name") == 0)
+    {
+      name = argv[++i];
+    }
+    else if (strcmp(argv[i], "--type") == 0)
+    {
+      type = argv[++i];
+    }
+    else
+    {
+      vtkWrapXMLProperties_Usage();
+    }
+  }
+
+  if (i == argc)
+  {
+    vtkWrapXMLProperties_Usage();
+  }
+
+  /* a single table is queried in place, several are merged first */
+  if (outputFile == NULL && i + 1 == argc && argv[i][0] != '@')
+  {
+    table = vtkWrapXMLPropertyTable_Read(argv[i]);
+    if (table == NULL)
+    {
+      fprintf(stderr, "vtkWrapXMLProperties: cannot read table %s\n",
+              argv[i]);
+      exit(1);
+    }
+    i++;
+  }
+  else
+  {
+    table = vtkWrapXMLPropertyTable_New();
+  }
+
+  for (; i < argc; i++)
+  {
+    if (argv[i][0] == '@')
+    {
+      vtkWrapXMLProperties_MergeList(table, &argv[i][1]);
+    }
+    else
+    {
+      vtkWrapXMLProperties_Merge(table, argv[i]);
+    }
+  }
+
+  if (outputFile)
+  {
+    if (!vtkWrapXMLPropertyTable_Write(table, outputFile))
+    {
+      fprintf(stderr, "vtkWrapXMLProperties: cannot write %s\n", outputFile);
+      exit(1);
+    }
+    vtkWrapXMLPropertyTable_Free(table);
+    return 0;
+  }
+
+  /* the type is a name, optionally followed by a count in brackets */
+  if (type)
+  {
+    cp = strchr(type, '[');
+    n = (cp ? (size_t)(cp - type) : strlen(type));
+    typeName = (char *)malloc(n + 1);
+    memcpy(typeName, type, n);
+    typeName[n] = '\0';
+    query.TypeNameId = vtkWrapXMLProperties_Id(table, typeName);
+    if (cp)
+    {
+      query.Count = (unsigned int)strtoul(&cp[1], NULL, 10);
+    }
+    free(typeName);
+  }
+  if (className)
+  {
+    query.ClassId = vtkWrapXMLProperties_Id(table, className);
+  }
+  if (name)
+  {
+    query.NameId = vtkWrapXMLProperties_Id(table, name);
+  }
+
+  matches = (unsigned int *)malloc(
+    sizeof(unsigned int)*((table->NumberOfRows + 31)/32 + 1));
+
+  start = vtkWrapXMLSystem_Clock();
+  count = vtkWrapXMLPropertyTable_Select(table, &query, matches);
+  elapsed = vtkWrapXMLSystem_Clock() - start;
+
+  if (countOnly)
+  {
+    printf("%u\n", count);
+  }
+  else
+  {
+    vtkWrapXMLProperties_Print(table, matches, classes);
+  }
+
+  if (timing)
+  {
+    fprintf(stderr, "%u of %u properties matched in %.3f ms\n",
+            count, table->NumberOfRows, 1e3*elapsed);
+  }
+
+  free(matches);
+  vtkWrapXMLPropertyTable_Free(table);
+
+  return 0;
+}
@@ -0,0 +1,549 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLPropertyTable.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLPropertyTable.h"
+#include "vtkWrapXMLHash.h"
+#include "vtkWrapXMLSystem.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#if defined(__SSE2__) || defined(_M_X64) || \
+    (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define PROPERTY_TABLE_SSE2
+#endif
+
+#include "vtkWrapXMLAlloc.h"
+
+#define TABLE_MAGIC "vtkxprop"
+#define TABLE_BYTEORDER 0x01020304u
+#define TABLE_VERSION 1u
+#define TABLE_HEADER_SIZE (8 + 6*sizeof(unsigned int))
+
+/*-------------------------------------------------------------------
+ * create and free */
+
+WrapXMLPropertyTable *vtkWrapXMLPropertyTable_New(void)
+{
+  WrapXMLPropertyTable *table;
+
+  table = (WrapXMLPropertyTable *)calloc(1, sizeof(WrapXMLPropertyTable));
+  table->Arena = vtkWrapXMLArena_New();
+
+  return table;
+}
+
+void vtkWrapXMLPropertyTable_Free(WrapXMLPropertyTable *table)
+{
+  int j;
+
+  if (table->Map)
+  {
+    vtkWrapXMLSystem_UnmapFile(table->Map, table->MapSize);
+  }
+  else
+  {
+    for (j = 0; j < VTK_WRAP_XML_NUMBER_OF_COLUMNS; j++)
+    {
+      free(table->Columns[j]);
+    }
+  }
+  vtkWrapXMLArena_Delete(table->Arena);
+  free(table->Strings);
+  free(table->HashSlots);
+  free(table);
+}
+
+/*-------------------------------------------------------------------
+ * the string pool, with an open-addressed hash table for lookups */
+
+static void rehashStrings(WrapXMLPropertyTable *table, unsigned int size)
+{
+  unsigned int i, k;
+
+  free(table->HashSlots);
+  table->HashSize = size;
+  table->HashSlots = (unsigned int *)calloc(size, sizeof(unsigned int));
+
+  for (i = 0; i < table->NumberOfStrings; i++)
+  {
+    k = (unsigned int)vtkWrapXMLHash_String(
+      VTK_WRAP_XML_HASH_INIT, table->Strings[i]) & (size - 1);
+    while (table->HashSlots[k] != 0)
+    {
+      k = (k + 1) & (size - 1);
+    }
+    table->HashSlots[k] = i + 1;
+  }
+}
+
+/* find the slot for a string, which holds zero if it is not there */
+static unsigned int *findSlot(WrapXMLPropertyTable *table, const char *text)
+{
+  unsigned int k, id, size;
+
+  /* keep the table at most half full */
+  if (table->HashSize < 2*table->NumberOfStrings + 2)
+  {
+    size = (table->HashSize == 0 ? 256 : 2*table->HashSize);
+    while (size < 2*table->NumberOfStrings + 2)
+    {
+      size *= 2;
+    }
+    rehashStrings(table, size);
+  }
+
+  k = (unsigned int)vtkWrapXMLHash_String(VTK_WRAP_XML_HASH_INIT, text) &
+    (table->HashSize - 1);
+  while ((id = table->HashSlots[k]) != 0 &&
+         strcmp(table->Strings[id - 1], text) != 0)
+  {
+    k = (k + 1) & (table->HashSize - 1);
+  }
+
+  return &table->HashSlots[k];
+}
+
+unsigned int vtkWrapXMLPropertyTable_FindString(
+  WrapXMLPropertyTable *table, const char *text)
+{
+  unsigned int id;
+
+  if (text == NULL)
+  {
+    return VTK_WRAP_XML_NO_STRING;
+  }
+
+  id = *findSlot(table, text);
+
+  return (id == 0 ? VTK_WRAP_XML_NO_STRING : id - 1);
+}
+
+unsigned int vtkWrapXMLPropertyTable_AddString(
+  WrapXMLPropertyTable *table, const char *text)
+{
+  unsigned int *slot;
+  unsigned int n = table->NumberOfStrings;
+
+  if (text == NULL)
+  {
+    return VTK_WRAP_XML_NO_STRING;
+  }
+
+  slot = findSlot(table, text);
+  if (*slot != 0)
+  {
+    return *slot - 1;
+  }
+
+  /* the array grows in powers of two */
+  if (n == 0 || (n >= 16 && (n & (n - 1)) == 0))
+  {
+    table->Strings = (const char **)realloc(
+      (char **)table->Strings, sizeof(char *)*(n == 0 ? 16 : 2*n));
+  }
+
+  table->Strings[n] = vtkWrapXMLArena_StringCopy(table->Arena, text);
+  table->NumberOfStrings = n + 1;
+  *slot = n + 1;
+
+  return n;
+}
+
+/*-------------------------------------------------------------------
+ * add a row, the columns grow in powers of two */
+
+static unsigned int newRow(WrapXMLPropertyTable *table)
+{
+  unsigned int n = table->NumberOfRows;
+  int j;
+
+  if (n == table->MaxRows)
+  {
+    table->MaxRows = (n == 0 ? 64 : 2*n);
+    for (j = 0; j < VTK_WRAP_XML_NUMBER_OF_COLUMNS; j++)
+    {
+      table->Columns[j] = (unsigned int *)realloc(
+        table->Columns[j], sizeof(unsigned int)*table->MaxRows);
+    }
+  }
+
+  table->NumberOfRows = n + 1;
+
+  return n;
+}
+
+void vtkWrapXMLPropertyTable_AddRow(
+  WrapXMLPropertyTable *table, const char *className, const char *name,
+  const char *typeName, unsigned int type, int count,
+  unsigned int publicMethods, unsigned int protectedMethods,
+  unsigned int legacyMethods)
+{
+  unsigned int values[VTK_WRAP_XML_NUMBER_OF_COLUMNS];
+  unsigned int i;
+  int j;
+
+  /* get the strings first, they might be in the table already */
+  values[VTK_WRAP_XML_COLUMN_CLASS] =
+    vtkWrapXMLPropertyTable_AddString(table, className);
+  values[VTK_WRAP_XML_COLUMN_NAME] =
+    vtkWrapXMLPropertyTable_AddString(table, name);
+  values[VTK_WRAP_XML_COLUMN_TYPENAME] =
+    vtkWrapXMLPropertyTable_AddString(table, typeName);
+  values[VTK_WRAP_XML_COLUMN_TYPE] = type;
+  values[VTK_WRAP_XML_COLUMN_COUNT] = (unsigned int)(count > 0 ? count : 0);
+  values[VTK_WRAP_XML_COLUMN_PUBLIC] = publicMethods;
+  values[VTK_WRAP_XML_COLUMN_PROTECTED] = protectedMethods;
+  values[VTK_WRAP_XML_COLUMN_LEGACY] = legacyMethods;
+
+  i = newRow(table);
+  for (j = 0; j < VTK_WRAP_XML_NUMBER_OF_COLUMNS; j++)
+  {
+    table->Columns[j][i] = values[j];
+  }
+}
+
+/*-------------------------------------------------------------------
+ * add the rows of another table, with its strings given new ids */
+
+void vtkWrapXMLPropertyTable_Merge(
+  WrapXMLPropertyTable *table, const WrapXMLPropertyTable *other)
+{
+  unsigned int *ids;
+  unsigned int i, k, id;
+  int j;
+
+  ids = (unsigned int *)malloc(
+    sizeof(unsigned int)*(other->NumberOfStrings + 1));
+  for (k = 0; k < other->NumberOfStrings; k++)
+  {
+    ids[k] = vtkWrapXMLPropertyTable_AddString(table, other->Strings[k]);
+  }
+
+  for (i = 0; i < other->NumberOfRows; i++)
+  {
+    k = newRow(table);
+    for (j = 0; j < VTK_WRAP_XML_NUMBER_OF_COLUMNS; j++)
+    {
+      table->Columns[j][k] = other->Columns[j][i];
+    }
+    for (j = VTK_WRAP_XML_COLUMN_CLASS; j <= VTK_WRAP_XML_COLUMN_TYPENAME; j++)
+    {
+      id = other->Columns[j][i];
+      table->Columns[j][k] = (id < other->NumberOfStrings ? ids[id] : id);
+    }
+  }
+
+  free(ids);
+}
+
+/*-------------------------------------------------------------------
+ * queries */
+
+void vtkWrapXMLPropertyTable_InitQuery(WrapXMLPropertyQuery *query)
+{
+  query->PublicMethods = 0;
+  query->ProtectedMethods = 0;
+  query->LegacyMethods = 0;
+  query->ClassId = VTK_WRAP_XML_NO_STRING;
+  query->NameId = VTK_WRAP_XML_NO_STRING;
+  query->TypeNameId = VTK_WRAP_XML_NO_STRING;
+  query->Count = VTK_WRAP_XML_NO_STRING;
+}
+
+/* a condition on one column */
+typedef struct _property_test
+{
+  const unsigned int *column;
+  unsigned int mask;  /* the bits that are tested */
+  unsigned int value; /* the value of those bits */
+} property_test_t;
+
+/* turn the query into a list of tests, and return how many there are */
+static int makeTests(
+  const WrapXMLPropertyTable *table, const WrapXMLPropertyQuery *query,
+  property_test_t tests[VTK_WRAP_XML_NUMBER_OF_COLUMNS])
+{
+  static const int bitfields[3] = {
+    VTK_WRAP_XML_COLUMN_PUBLIC,
+    VTK_WRAP_XML_COLUMN_PROTECTED,
+    VTK_WRAP_XML_COLUMN_LEGACY
+  };
+  static const int values[4] = {
+    VTK_WRAP_XML_COLUMN_CLASS,
+    VTK_WRAP_XML_COLUMN_NAME,
+    VTK_WRAP_XML_COLUMN_TYPENAME,
+    VTK_WRAP_XML_COLUMN_COUNT
+  };
+  unsigned int masks[3];
+  unsigned int ids[4];
+  int n = 0;
+  int j;
+
+  masks[0] = query->PublicMethods;
+  masks[1] = query->ProtectedMethods;
+  masks[2] = query->LegacyMethods;
+  ids[0] = query->ClassId;
+  ids[1] = query->NameId;
+  ids[2] = query->TypeNameId;
+  ids[3] = query->Count;
+
+  /* the ids are usually the most selective, so they go first */
+  for (j = 0; j < 4; j++)
+  {
+    if (ids[j] != VTK_WRAP_XML_NO_STRING)
+    {
+      tests[n].column = table->Columns[values[j]];
+      tests[n].mask = 0xffffffffu;
+      tests[n].value = ids[j];
+      n++;
+    }
+  }
+
+  for (j = 0; j < 3; j++)
+  {
+    if (masks[j] != 0)
+    {
+      tests[n].column = table->Columns[bitfields[j]];
+      tests[n].mask = masks[j];
+      tests[n].value = masks[j];
+      n++;
+    }
+  }
+
+  return n;
+}
+
+unsigned int vtkWrapXMLPropertyTable_Select(
+  const WrapXMLPropertyTable *table, const WrapXMLPropertyQuery *query,
+  unsigned int *matches)
+{
+  property_test_t tests[VTK_WRAP_XML_NUMBER_OF_COLUMNS];
+  unsigned int rows = table->NumberOfRows;
+  unsigned int count = 0;
+  unsigned int i;
+  int n, j;
+#ifdef PROPERTY_TABLE_SSE2
+  unsigned int bits;
+  __m128i masks[VTK_WRAP_XML_NUMBER_OF_COLUMNS];
+  __m128i values[VTK_WRAP_XML_NUMBER_OF_COLUMNS];
+  __m128i m, v;
+#endif
+
+  n = makeTests(table, query, tests);
+  memset(matches, 0, sizeof(unsigned int)*((rows + 31)/32));
+  i = 0;
+
+#ifdef PROPERTY_TABLE_SSE2
+  for (j = 0; j < n; j++)
+  {
+    masks[j] = _mm_set1_epi32((int)tests[j].mask);
+    values[j] = _mm_set1_epi32((int)tests[j].value);
+  }
+
+  /* four rows at a time, each test clears the lanes that fail */
+  for (; i + 4 <= rows; i += 4)
+  {
+    m = _mm_set1_epi32(-1);
+    for (j = 0; j < n; j++)
+    {
+      v = _mm_loadu_si128((const __m128i *)&tests[j].column[i]);
+      v = _mm_cmpeq_epi32(_mm_and_si128(v, masks[j]), values[j]);
+      m = _mm_and_si128(m, v);
+    }
+    bits = (unsigned int)_mm_movemask_ps(_mm_castsi128_ps(m));
+    if (bits)
+    {
+      /* i is a multiple of four, so the bits stay within one word */
+      matches[i >> 5] |= bits << (i & 31);
+      count += (bits & 1) + ((bits >> 1) & 1) + ((bits >> 2) & 1) +
+        (bits >> 3);
+    }
+  }
+#endif
+
+  /* the remaining rows, or all of them without SSE2 */
+  for (; i < rows; i++)
+  {
+    for (j = 0; j < n; j++)
+    {
+      if ((tests[j].column[i] & tests[j].mask) != tests[j].value)
+      {
+        break;
+      }
+    }
+    if (j == n)
+    {
+      matches[i >> 5] |= 1u << (i & 31);
+      count++;
+    }
+  }
+
+  return count;
+}
+
+/*-------------------------------------------------------------------
+ * read a table, the columns are used in place */
+
+WrapXMLPropertyTable *vtkWrapXMLPropertyTable_Read(const char *filename)
+{
+  WrapXMLPropertyTable *table;
+  const char *data;
+  const char *text;
+  const unsigned int *columns;
+  const unsigned int *offsets;
+  unsigned int header[6];
+  unsigned int rows, n, strsize, i;
+  size_t size;
+  int j;
+
+  data = vtkWrapXMLSystem_MapFile(filename, &size);
+  if (data == NULL)
+  {
+    return NULL;
+  }
+
+  if (size < TABLE_HEADER_SIZE || strncmp(data, TABLE_MAGIC, 8) != 0)
+  {
+    vtkWrapXMLSystem_UnmapFile(data, size);
+    return NULL;
+  }
+
+  memcpy(header, &data[8], sizeof(header));
+  rows = header[2];
+  n = header[3];
+  strsize = header[4];
+  if (header[0] != TABLE_BYTEORDER || header[1] != TABLE_VERSION ||
+      (size - TABLE_HEADER_SIZE)/sizeof(unsigned int) <
+        VTK_WRAP_XML_NUMBER_OF_COLUMNS*(size_t)rows + n ||
+      size - TABLE_HEADER_SIZE -
+        (VTK_WRAP_XML_NUMBER_OF_COLUMNS*(size_t)rows + n)*
+          sizeof(unsigned int) != strsize ||
+      (strsize > 0 && data[size-1] != '\0'))
+  {
+    vtkWrapXMLSystem_UnmapFile(data, size);
+    return NULL;
+  }
+
+  /* the columns follow the header, and are suitably aligned */
+  columns = (const unsigned int *)&data[TABLE_HEADER_SIZE];
+  offsets = &columns[VTK_WRAP_XML_NUMBER_OF_COLUMNS*(size_t)rows];
+  text = (const char *)&offsets[n];
+
+  table = vtkWrapXMLPropertyTable_New();
+  table->Map = data;
+  table->MapSize = size;
+  table->NumberOfRows = rows;
+  for (j = 0; j < VTK_WRAP_XML_NUMBER_OF_COLUMNS; j++)
+  {
+    table->Columns[j] = (unsigned int *)&columns[j*(size_t)rows];
+  }
+
+  table->NumberOfStrings = n;
+  table->Strings = (const char **)malloc(sizeof(char *)*(n + 1));
+  for (i = 0; i < n; i++)
+  {
+    if (offsets[i] >= strsize)
+    {
+      vtkWrapXMLPropertyTable_Free(table);
+      return NULL;
+    }
+    table->Strings[i] = &text[offsets[i]];
+  }
+
+  /* the string ids must be valid, so that they can be used unchecked */
+  for (j = VTK_WRAP_XML_COLUMN_CLASS; j <= VTK_WRAP_XML_COLUMN_TYPENAME; j++)
+  {
+    for (i = 0; i < rows; i++)
+    {
+      if (table->Columns[j][i] >= n &&
+          table->Columns[j][i] != VTK_WRAP_XML_NO_STRING)
+      {
+        vtkWrapXMLPropertyTable_Free(table);
+        return NULL;
+      }
+    }
+  }
+
+  return table;
+}
+
+/*-------------------------------------------------------------------
+ * write a table */
+
+int vtkWrapXMLPropertyTable_Write(
+  WrapXMLPropertyTable *table, const char *filename)
+{
+  unsigned int header[6];
+  unsigned int *offsets;
+  unsigned int i, pos;
+  int j, ok;
+  FILE *fp;
+
+  offsets = (unsigned int *)malloc(
+    sizeof(unsigned int)*(table->NumberOfStrings + 1));
+  pos = 0;
+  for (i = 0; i < table->NumberOfStrings; i++)
+  {
+    offsets[i] = pos;
+    pos += (unsigned int)strlen(table->Strings[i]) + 1;
+  }
+
+  header[0] = TABLE_BYTEORDER;
+  header[1] = TABLE_VERSION;
+  header[2] = table->NumberOfRows;
+  header[3] = table->NumberOfStrings;
+  header[4] = pos;
+  header[5] = 0;
+
+  if (strcmp(filename, "-") == 0)
+  {
+    fp = stdout;
+  }
+  else
+  {
+    fp = fopen(filename, "wb");
+  }
+  if (!fp)
+  {
+    free(offsets);
+    return 0;
+  }
+
+  fwrite(TABLE_MAGIC, 1, 8, fp);
+  fwrite(header, sizeof(unsigned int), 6, fp);
+  for (j = 0; j < VTK_WRAP_XML_NUMBER_OF_COLUMNS; j++)
+  {
+    fwrite(table->Columns[j], sizeof(unsigned int), table->NumberOfRows, fp);
+  }
+  fwrite(offsets, sizeof(unsigned int), table->NumberOfStrings, fp);
+  for (i = 0; i < table->NumberOfStrings; i++)
+  {
+    fwrite(table->Strings[i], 1, strlen(table->Strings[i]) + 1, fp);
+  }
+
+  ok = !ferror(fp);
+  if (fp == stdout)
+  {
+    ok &= (fflush(fp) == 0);
+  }
+  else
+  {
+    ok &= (fclose(fp) == 0);
+  }
+  free(offsets);
+
+  return ok;
+}
@@ -0,0 +1,179 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLPropertyTable.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file provides the property table, which holds the properties of
+ * all the classes in a set of headers, so that questions such as "which
+ * public properties are double[3] and have SET_CLAMP" can be answered
+ * without reading any of the XML.
+ *
+ * The table is stored as columns, with one row per property: the class,
+ * the property name, the type name, the VTK_PARSE type, the count, and
+ * the bitfields of the public, protected, and legacy methods.  Strings
+ * are stored once, in a pool, and the columns hold their ids.  A query
+ * only reads the columns that it tests, and it tests four rows at once
+ * if SSE2 is available.
+ *
+ * The file is laid out as follows, with all integers stored as native
+ * 32-bit unsigned ints:
+ *
+ *   char magic[8]          "vtkxprop"
+ *   unsigned int byteorder  0x01020304, to reject foreign tables
+ *   unsigned int version    the version of the layout
+ *   unsigned int rows       the number of properties
+ *   unsigned int strings    the number of strings
+ *   unsigned int strsize    the size of the string block
+ *   unsigned int reserved   zero, to keep the columns 8-byte aligned
+ *   unsigned int columns[8*rows]   the columns, one after another
+ *   unsigned int offsets[strings]  the offset of each string
+ *   char text[strsize]     nul-terminated strings
+ *
+ * When a table is read, the columns point into the mapped file, so a
+ * table can be queried without being copied.
+ */
+
+#ifndef VTK_WRAP_XML_PROPERTY_TABLE_H
+#define VTK_WRAP_XML_PROPERTY_TABLE_H
+
+#include "vtkWrapXMLArena.h"
+#include <stddef.h>
+
+/**
+ * The id that is used for a missing string, e.g. for a property
+ * that has no type name
+ */
+#define VTK_WRAP_XML_NO_STRING 0xffffffffu
+
+/**
+ * The columns of the table, in the order that they are stored
+ */
+#define VTK_WRAP_XML_COLUMN_CLASS 0      /* string id of the class */
+#define VTK_WRAP_XML_COLUMN_NAME 1       /* string id of the property */
+#define VTK_WRAP_XML_COLUMN_TYPENAME 2   /* string id of the type name */
+#define VTK_WRAP_XML_COLUMN_TYPE 3       /* the VTK_PARSE type */
+#define VTK_WRAP_XML_COLUMN_COUNT 4      /* the count, or zero */
+#define VTK_WRAP_XML_COLUMN_PUBLIC 5     /* the public methods */
+#define VTK_WRAP_XML_COLUMN_PROTECTED 6  /* the protected methods */
+#define VTK_WRAP_XML_COLUMN_LEGACY 7     /* the legacy methods */
+#define VTK_WRAP_XML_NUMBER_OF_COLUMNS 8
+
+/**
+ * A table of properties, stored as columns
+ */
+typedef struct _WrapXMLPropertyTable
+{
+  unsigned int   NumberOfRows;
+  unsigned int  *Columns[VTK_WRAP_XML_NUMBER_OF_COLUMNS];
+  unsigned int   NumberOfStrings;
+  const char   **Strings;     /* the string for each id */
+  unsigned int   MaxRows;     /* the allocated rows, or zero if mapped */
+  unsigned int   HashSize;    /* the slots for finding strings */
+  unsigned int  *HashSlots;   /* one plus the id for each slot, or zero */
+  WrapXMLArena  *Arena;       /* the memory for the strings */
+  const char    *Map;         /* the file that the table was read from */
+  size_t         MapSize;
+} WrapXMLPropertyTable;
+
+/**
+ * A query, where each row must match every condition.  For the method
+ * bitfields, all of the bits in the mask must be set.  For the others,
+ * the value must be equal, unless it is VTK_WRAP_XML_NO_STRING.
+ */
+typedef struct _WrapXMLPropertyQuery
+{
+  unsigned int PublicMethods;     /* required public methods, or zero */
+  unsigned int ProtectedMethods;  /* required protected methods, or zero */
+  unsigned int LegacyMethods;     /* required legacy methods, or zero */
+  unsigned int ClassId;           /* the class, or NO_STRING for any */
+  unsigned int NameId;            /* the property, or NO_STRING for any */
+  unsigned int TypeNameId;        /* the type name, or NO_STRING for any */
+  unsigned int Count;             /* the count, or NO_STRING for any */
+} WrapXMLPropertyQuery;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Create an empty table
+ */
+WrapXMLPropertyTable *vtkWrapXMLPropertyTable_New(void);
+
+/**
+ * Get the id of a string, adding it to the table if it is not there.
+ * The string is copied.  A NULL string has the id NO_STRING.
+ */
+unsigned int vtkWrapXMLPropertyTable_AddString(
+  WrapXMLPropertyTable *table, const char *text);
+
+/**
+ * Get the id of a string, or NO_STRING if it is not in the table
+ */
+unsigned int vtkWrapXMLPropertyTable_FindString(
+  WrapXMLPropertyTable *table, const char *text);
+
+/**
+ * Add a row, the strings are copied.  This cannot be done for a table
+ * that was read from a file.
+ */
+void vtkWrapXMLPropertyTable_AddRow(
+  WrapXMLPropertyTable *table, const char *className, const char *name,
+  const char *typeName, unsigned int type, int count,
+  unsigned int publicMethods, unsigned int protectedMethods,
+  unsigned int legacyMethods);
+
+/**
+ * Add all the rows of another table
+ */
+void vtkWrapXMLPropertyTable_Merge(
+  WrapXMLPropertyTable *table, const WrapXMLPropertyTable *other);
+
+/**
+ * Initialize a query that matches every row
+ */
+void vtkWrapXMLPropertyTable_InitQuery(WrapXMLPropertyQuery *query);
+
+/**
+ * Find the rows that match a query.  The matches are returned as a
+ * bitset, where bit (i & 31) of matches[i >> 5] is set for row i, so
+ * "matches" must have room for (NumberOfRows + 31)/32 words.  Returns
+ * the number of rows that match.
+ */
+unsigned int vtkWrapXMLPropertyTable_Select(
+  const WrapXMLPropertyTable *table, const WrapXMLPropertyQuery *query,
+  unsigned int *matches);
+
+/**
+ * Read a table from a file.  Returns NULL if the file could not be
+ * read or is not a property table.
+ */
+WrapXMLPropertyTable *vtkWrapXMLPropertyTable_Read(const char *filename);
+
+/**
+ * Write the table to a file, the name "-" is used for stdout.  Returns
+ * zero if the file could not be written.
+ */
+int vtkWrapXMLPropertyTable_Write(
+  WrapXMLPropertyTable *table, const char *filename);
+
+/**
+ * Free the table
+ */
+void vtkWrapXMLPropertyTable_Free(WrapXMLPropertyTable *table);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,503 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLReflect.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ The vtkWrapXMLReflect program writes the C++ source file that holds the
+ reflection tables for a module.  It is given the fragments that were
+ written by "vtkWrapXML --reflection" for the headers of the module, and
+ the source file that it writes includes all of the fragments, followed
+ by a table of the classes in the module:
+
+   extern "C" const WrapXMLReflectionModule VTK_CommonCore_Reflection;
+
+ The name of the table is the module name, with every run of characters
+ that are not letters or digits replaced by "_".  All of the tables are
+ constexpr, so the compiler places them in read-only data and nothing
+ has to be done at run time before they are used.  The module table has
+ a perfect hash table for looking up its classes by name.
+
+ With "--registry <name>", the program instead writes a registry of
+ several modules, which has a perfect hash table over the classes of
+ all the modules.  Each module is given with "--module" followed by its
+ fragments, and the registry refers to the module tables, which must be
+ linked with it:
+
+   extern "C" const WrapXMLReflectionRegistry vtkWrapXML_Registry;
+*/
+
+#include "vtkWrapXMLArena.h"
+#include "vtkWrapXMLInput.h"
+#include "vtkWrapXMLOutput.h"
+#include "vtkWrapXMLPerfectHash.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/**
+ * Print the usage and exit
+ */
+static void vtkWrapXMLReflect_Usage(void)
+{
+  fprintf(stderr,
+    "Usage: vtkWrapXMLReflect -o <source> --module <name> <fragment>...\n"
+    "       vtkWrapXMLReflect -o <source> --registry <name>\n"
+    "         --module <name> <fragment>... [--module <name> ...]\n"
+    "  -o <source>       the C++ source file, or \"-\" for stdout\n"
+    "  --module <name>   the name of the module\n"
+    "  --registry <name> write a registry of the modules\n"
+    "  @<file>           read the fragment names from a file\n");
+  exit(1);
+}
+
+/**
+ * The fragments and their classes, in the order they were given
+ */
+typedef struct _ReflectInfo
+{
+  int NumberOfFragments;
+  const char **Fragments;  /* the fragment files */
+  int NumberOfClasses;
+  const char **Classes;    /* the classes in all the fragments */
+  int NumberOfModules;
+  const char **Modules;    /* the module names */
+  int *FirstClass;         /* the first class of each module */
+  WrapXMLArena *Arena;     /* the memory for the strings */
+} ReflectInfo;
+
+/*-------------------------------------------------------------------
+ * add a string to a list, the list grows in powers of two */
+
+static void addString(
+  ReflectInfo *info, int *n, const char ***list, const char *text, size_t l)
+{
+  char *cp;
+
+  if (*n == 0 || (*n >= 16 && (*n & (*n - 1)) == 0))
+  {
+    *list = (const char **)realloc(
+      (void *)*list, sizeof(char *)*(*n == 0 ? 16 : 2*(*n)));
+  }
+
+  cp = (char *)vtkWrapXMLArena_Alloc(info->Arena, l + 1);
+  memcpy(cp, text, l);
+  cp[l] = '\0';
+  (*list)[(*n)++] = cp;
+}
+
+/*-------------------------------------------------------------------
+ * read a fragment, and get its classes from its "classes" lines */
+
+static void readFragment(ReflectInfo *info, const char *filename)
+{
+  static const char marker[] = "// classes:";
+  const char *cp;
+  const char *sp;
+  char *text;
+  size_t n;
+
+  text = vtkWrapXMLInput_ReadAll(filename, &n);
+  if (text == NULL)
+  {
+    fprintf(stderr, "vtkWrapXMLReflect: cannot read %s\n", filename);
+    exit(1);
+  }
+
+  addString(info, &info->NumberOfFragments, &info->Fragments,
+            filename, strlen(filename));
+
+  /* in batch mode, one file holds the fragments of many headers */
+  for (cp = text; *cp != '\0';)
+  {
+    if (strncmp(cp, marker, sizeof(marker) - 1) == 0)
+    {
+      cp += sizeof(marker) - 1;
+      while (*cp != '\n' && *cp != '\0')
+      {
+        while (*cp == ' ' || *cp == '\t' || *cp == '\r')
+        {
+          cp++;
+        }
+        sp = cp;
+        while (*cp != ' ' && *cp != '\t' && *cp != '\r' &&
+               *cp != '\n' && *cp != '\0')
+        {
+          cp++;
+        }
+        if (cp != sp)
+        {
+          addString(info, &info->NumberOfClasses, &info->Classes,
+                    sp, cp - sp);
+        }
+      }
+    }
+    while (*cp != '\n' && *cp != '\0')
+    {
+      cp++;
+    }
+    if (*cp == '\n')
+    {
+      cp++;
+    }
+  }
+
+  free(text);
+}
+
+/*-------------------------------------------------------------------
+ * read all the fragments that are listed in a file */
+
+static void readList(ReflectInfo *info, const char *listfile)
+{
+  char *text;
+  char *cp;
+  char *line;
+  size_t n;
+
+  text = vtkWrapXMLInput_ReadAll(listfile, &n);
+  if (text == NULL)
+  {
+    fprintf(stderr, "vtkWrapXMLReflect: cannot read %s\n", listfile);
+    exit(1);
+  }
+
+  for (cp = text; *cp != '\0';)
+  {
+    line = cp;
+    while (*cp != '\n' && *cp != '\r' && *cp != '\0')
+    {
+      cp++;
+    }
+    if (*cp != '\0')
+    {
+      *cp++ = '\0';
+    }
+    if (line[0] != '\0')
+    {
+      readFragment(info, line);
+    }
+  }
+
+  free(text);
+}
+
+/*-------------------------------------------------------------------
+ * write the source file */
+
+/* write the include path for a fragment, with forward slashes */
+static void writeInclude(WrapXMLOutput *out, const char *filename)
+{
+  const char *cp;
+
+  vtkWrapXMLOutput_Puts(out, "#include \"");
+  for (cp = filename; *cp != '\0'; cp++)
+  {
+    vtkWrapXMLOutput_Putc(out, (*cp == '\\' ? '/' : *cp));
+  }
+  vtkWrapXMLOutput_Puts(out, "\"\n");
+}
+
+/* write the module name as an identifier, the separators at the ends
+   are dropped so that there are no reserved names like "__" or "_9" */
+static void writeIdentifier(WrapXMLOutput *out, const char *name)
+{
+  const char *cp;
+  int started = 0;
+  int sep = 0;
+
+  for (cp = name; *cp != '\0'; cp++)
+  {
+    if (!isalnum((unsigned char)*cp))
+    {
+      sep = 1;
+      continue;
+    }
+    if (!started && isdigit((unsigned char)*cp))
+    {
+      vtkWrapXMLOutput_Putc(out, 'M');
+    }
+    else if (started && sep)
+    {
+      vtkWrapXMLOutput_Putc(out, '_');
+    }
+    vtkWrapXMLOutput_Putc(out, *cp);
+    started = 1;
+    sep = 0;
+  }
+}
+
+/* build the hash table for the classes */
+static void buildHash(ReflectInfo *info, WrapXMLPerfectHash *hash)
+{
+  if (!vtkWrapXMLPerfectHash_Build(
+        hash, info->Classes, info->NumberOfClasses, info->Arena))
+  {
+    fprintf(stderr, "vtkWrapXMLReflect: cannot build the class hash\n");
+    exit(1);
+  }
+}
+
+static int writeSource(
+  ReflectInfo *info, const char *module, const char *outputFile)
+{
+  WrapXMLOutput *out;
+  WrapXMLPerfectHash hash;
+  int i;
+
+  out = vtkWrapXMLOutput_Open(outputFile, VTK_WRAP_XML_COMPRESS_NONE);
+  if (out == NULL)
+  {
+    return 0;
+  }
+
+  vtkWrapXMLOutput_Printf(out,
+    "// reflection tables for %s, generated by vtkWrapXMLReflect\n\n"
+    "#include \"vtkWrapXMLReflection.h\"\n\n", module);
+
+  for (i = 0; i < info->NumberOfFragments; i++)
+  {
+    writeInclude(out, info->Fragments[i]);
+  }
+
+  if (info->NumberOfClasses)
+  {
+    vtkWrapXMLOutput_Puts(out,
+      "\nstatic constexpr const WrapXMLReflectionClass *const"
+      " ModuleClasses[] = {\n");
+    for (i = 0; i < info->NumberOfClasses; i++)
+    {
+      vtkWrapXMLOutput_Printf(out, "  &%s_Reflection,\n", info->Classes[i]);
+    }
+    vtkWrapXMLOutput_Puts(out, "};\n\n");
+    buildHash(info, &hash);
+    vtkWrapXMLPerfectHash_Write(out, &hash, "ModuleClass");
+  }
+
+  else
+  {
+    vtkWrapXMLOutput_Putc(out, '\n');
+  }
+
+  vtkWrapXMLOutput_Puts(out, "extern \"C\" const WrapXMLReflectionModule ");
+  writeIdentifier(out, module);
+  vtkWrapXMLOutput_Puts(out, "_Reflection;\n\n");
+  vtkWrapXMLOutput_Puts(out, "const WrapXMLReflectionModule ");
+  writeIdentifier(out, module);
+  vtkWrapXMLOutput_Printf(out, "_Reflection = {\n  \"%s\",\n", module);
+  if (info->NumberOfClasses)
+  {
+    vtkWrapXMLOutput_Printf(out,
+      "  %d, ModuleClasses,\n"
+      "  { %d, ModuleClassDisplacements, ModuleClassSlots }\n};\n",
+      info->NumberOfClasses, hash.NumberOfBuckets);
+  }
+  else
+  {
+    vtkWrapXMLOutput_Puts(out,
+      "  0, nullptr,\n  { 0, nullptr, nullptr }\n};\n");
+  }
+
+  return vtkWrapXMLOutput_Close(out);
+}
+
+/* write the registry of all the modules */
+static int writeRegistry(
+  ReflectInfo *info, const char *registry, const char *outputFile)
+{
+  WrapXMLOutput *out;
+  WrapXMLPerfectHash hash;
+  int *indices;
+  int i, k, m;
+
+  out = vtkWrapXMLOutput_Open(outputFile, VTK_WRAP_XML_COMPRESS_NONE);
+  if (out == NULL)
+  {
+    return 0;
+  }
+
+  vtkWrapXMLOutput_Printf(out,
+    "// class registry for %d modules, generated by vtkWrapXMLReflect\n\n"
+    "#include \"vtkWrapXMLReflection.h\"\n\n", info->NumberOfModules);
+
+  for (m = 0; m < info->NumberOfModules; m++)
+  {
+    vtkWrapXMLOutput_Puts(out, "extern \"C\" const WrapXMLReflectionModule ");
+    writeIdentifier(out, info->Modules[m]);
+    vtkWrapXMLOutput_Puts(out, "_Reflection;\n");
+  }
+
+  vtkWrapXMLOutput_Puts(out,
+    "\nstatic const WrapXMLReflectionModule *const RegistryModules[] = {\n");
+  for (m = 0; m < info->NumberOfModules; m++)
+  {
+    vtkWrapXMLOutput_Puts(out, "  &");
+    writeIdentifier(out, info->Modules[m]);
+    vtkWrapXMLOutput_Puts(out, "_Reflection,\n");
+  }
+  vtkWrapXMLOutput_Puts(out, "};\n\n");
+
+  /* the slots hold the module, the indices give the class in the module */
+  buildHash(info, &hash);
+  indices = (int *)vtkWrapXMLArena_Alloc(
+    info->Arena, sizeof(int)*(hash.Size + 1));
+  for (i = 0; i < hash.Size; i++)
+  {
+    indices[i] = -1;
+    k = hash.Slots[i];
+    if (k >= 0)
+    {
+      for (m = info->NumberOfModules - 1; info->FirstClass[m] > k; m--) { ; }
+      hash.Slots[i] = m;
+      indices[i] = k - info->FirstClass[m];
+    }
+  }
+
+  if (hash.Size)
+  {
+    vtkWrapXMLPerfectHash_Write(out, &hash, "RegistryClass");
+    vtkWrapXMLOutput_Puts(out,
+      "static constexpr int RegistryClassIndices[] = {");
+    for (i = 0; i < hash.Size; i++)
+    {
+      vtkWrapXMLOutput_Printf(out, "%s%d,", (i % 8 == 0 ? "\n  " : " "),
+                              indices[i]);
+    }
+    vtkWrapXMLOutput_Puts(out, "\n};\n\n");
+  }
+
+  vtkWrapXMLOutput_Puts(out, "extern \"C\" const WrapXMLReflectionRegistry ");
+  writeIdentifier(out, registry);
+  vtkWrapXMLOutput_Puts(out, "_Registry;\n\nconst WrapXMLReflectionRegistry ");
+  writeIdentifier(out, registry);
+  vtkWrapXMLOutput_Printf(out, "_Registry = {\n  %d, RegistryModules,\n",
+                          info->NumberOfModules);
+  if (hash.Size)
+  {
+    vtkWrapXMLOutput_Printf(out,
+      "  %d,\n  { %d, RegistryClassDisplacements, RegistryClassSlots },\n"
+      "  RegistryClassIndices\n};\n",
+      hash.Size, hash.NumberOfBuckets);
+  }
+  else
+  {
+    vtkWrapXMLOutput_Puts(out,
+      "  0,\n  { 0, nullptr, nullptr },\n  nullptr\n};\n");
+  }
+
+  return vtkWrapXMLOutput_Close(out);
+}
+
+/* check a module name, it goes into a string literal */
+static void checkName(const char *name)
+{
+  const char *cp;
+
+  for (cp = name; *cp != '\0'; cp++)
+  {
+    if (*cp == '\"' || *cp == '\\' || !isprint((unsigned char)*cp))
+    {
+      fprintf(stderr, "vtkWrapXMLReflect: bad module name %s\n", name);
+      exit(1);
+    }
+  }
+}
+
+/* start a new module */
+static void addModule(ReflectInfo *info, const char *name)
+{
+  checkName(name);
+  info->FirstClass[info->NumberOfModules] = info->NumberOfClasses;
+  addString(info, &info->NumberOfModules, &info->Modules, name, strlen(name));
+}
+
+int main(int argc, char *argv[])
+{
+  ReflectInfo info;
+  const char *outputFile = NULL;
+  const char *module = NULL;
+  const char *registry = NULL;
+  int i;
+
+  memset(&info, 0, sizeof(info));
+
+  /* get the options, they must precede the fragments */
+  for (i = 1; i < argc && argv[i][0] == '-' && argv[i][1] != '\0'; i++)
+  {
+    if (i + 1 >= argc)
+    {
+      vtkWrapXMLReflect_Usage();
+    }
+    else if (strcmp(argv[i], "-o") == 0)
+    {
+      outputFile = argv[++i];
+    }
+    else if (strcmp(argv[i], "--module") == 0)
+    {
+      module = argv[++i];
+    }
+    else if (strcmp(argv[i], "--registry") == 0)
+    {
+      registry = argv[++i];
+    }
+    else
+    {
+      vtkWrapXMLReflect_Usage();
+    }
+  }
+
+  if (outputFile == NULL || module == NULL)
+  {
+    vtkWrapXMLReflect_Usage();
+  }
+
+  info.Arena = vtkWrapXMLArena_New();
+  info.FirstClass = (int *)calloc(argc, sizeof(int));
+  addModule(&info, module);
+
+  /* in a registry, "--module" starts the fragments of the next module */
+  for (; i < argc; i++)
+  {
+    if (strcmp(argv[i], "--module") == 0 && registry != NULL)
+    {
+      if (++i >= argc)
+      {
+        vtkWrapXMLReflect_Usage();
+      }
+      addModule(&info, argv[i]);
+    }
+    else if (argv[i][0] == '@')
+    {
+      readList(&info, &argv[i][1]);
+    }
+    else
+    {
+      readFragment(&info, argv[i]);
+    }
+  }
+
+  if (registry ? !writeRegistry(&info, registry, outputFile)
+               : !writeSource(&info, module, outputFile))
+  {
+    fprintf(stderr, "vtkWrapXMLReflect: cannot write %s\n", outputFile);
+    exit(1);
+  }
+
+  free((void *)info.Fragments);
+  free((void *)info.Classes);
+  free((void *)info.Modules);
+  free(info.FirstClass);
+  vtkWrapXMLArena_Delete(info.Arena);
+
+  return 0;
+}
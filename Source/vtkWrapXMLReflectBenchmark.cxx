@@ -0,0 +1,218 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLReflectBenchmark.cxx
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ The vtkWrapXMLReflectBenchmark program measures the lookup of classes
+ and properties by name in the reflection registry.  The perfect hash
+ lookups of vtkWrapXMLReflection.h are compared with a std::unordered_map
+ that is keyed by std::string, and with a binary search over the names
+ in sorted order.  Every class and every property is looked up, in a
+ shuffled order, along with an equal number of names that are not in
+ the tables.  The three methods must find the same entries.
+
+ Usage: vtkWrapXMLReflectBenchmark [rounds]
+*/
+
+#include "vtkWrapXMLReflection.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+extern "C" const WrapXMLReflectionRegistry vtkWrapXML_Registry;
+
+namespace
+{
+
+/* the property tables of one class, for the other methods */
+struct PropertyTables
+{
+  std::unordered_map<std::string, const WrapXMLReflectionProperty *> Map;
+  std::vector<const WrapXMLReflectionProperty *> Sorted;
+};
+
+/* a property lookup, the class and the name of the property */
+struct PropertyQuery
+{
+  const WrapXMLReflectionClass *Class;
+  const PropertyTables *Tables;
+  std::string Name;
+};
+
+bool lessName(const char *a, const char *b)
+{
+  return (std::strcmp(a, b) < 0);
+}
+
+template <class T>
+const T *binarySearch(const std::vector<const T *> &sorted, const char *name)
+{
+  auto it = std::lower_bound(sorted.begin(), sorted.end(), name,
+    [](const T *a, const char *b) { return lessName(a->Name, b); });
+  if (it != sorted.end() && std::strcmp((*it)->Name, name) == 0)
+  {
+    return *it;
+  }
+  return nullptr;
+}
+
+/* time a lookup function over the queries, in nanoseconds per lookup */
+template <class Q, class F>
+double timeLookups(const std::vector<Q> &queries, int rounds,
+                   std::vector<const void *> &results, F lookup)
+{
+  auto start = std::chrono::steady_clock::now();
+  for (int r = 0; r < rounds; r++)
+  {
+    for (size_t i = 0; i < queries.size(); i++)
+    {
+      results[i] = lookup(queries[i]);
+    }
+  }
+  auto stop = std::chrono::steady_clock::now();
+  double ns = std::chrono::duration<double, std::nano>(stop - start).count();
+  return ns/(static_cast<double>(queries.size())*rounds);
+}
+
+void report(const char *what, double hash, double map, double search)
+{
+  std::printf("%-12s perfect hash %7.1f ns, unordered_map %7.1f ns, "
+              "binary search %7.1f ns\n", what, hash, map, search);
+}
+
+} // end anonymous namespace
+
+int main(int argc, char *argv[])
+{
+  const WrapXMLReflectionRegistry *registry = &vtkWrapXML_Registry;
+  int rounds = (argc > 1 ? std::atoi(argv[1]) : 100);
+  if (rounds <= 0)
+  {
+    std::fprintf(stderr, "Usage: vtkWrapXMLReflectBenchmark [rounds]\n");
+    return 1;
+  }
+
+  /* the tables for the other methods */
+  std::unordered_map<std::string, const WrapXMLReflectionClass *> classMap;
+  std::vector<const WrapXMLReflectionClass *> sortedClasses;
+  std::unordered_map<const WrapXMLReflectionClass *, PropertyTables>
+    propertyTables;
+  std::vector<std::string> classQueries;
+  std::vector<PropertyQuery> propertyQueries;
+
+  for (int m = 0; m < registry->NumberOfModules; m++)
+  {
+    const WrapXMLReflectionModule *module = registry->Modules[m];
+    for (int i = 0; i < module->NumberOfClasses; i++)
+    {
+      const WrapXMLReflectionClass *cls = module->Classes[i];
+      if (!classMap.emplace(cls->Name, cls).second)
+      {
+        continue;
+      }
+      sortedClasses.push_back(cls);
+      classQueries.push_back(cls->Name);
+      classQueries.push_back(std::string(cls->Name) + "X");
+
+      PropertyTables &tables = propertyTables[cls];
+      for (int j = 0; j < cls->NumberOfProperties; j++)
+      {
+        const WrapXMLReflectionProperty *property = &cls->Properties[j];
+        if (tables.Map.emplace(property->Name, property).second)
+        {
+          tables.Sorted.push_back(property);
+          propertyQueries.push_back({ cls, &tables, property->Name });
+          propertyQueries.push_back(
+            { cls, &tables, std::string(property->Name) + "X" });
+        }
+      }
+      std::sort(tables.Sorted.begin(), tables.Sorted.end(),
+        [](const WrapXMLReflectionProperty *a,
+           const WrapXMLReflectionProperty *b)
+        { return lessName(a->Name, b->Name); });
+    }
+  }
+  std::sort(sortedClasses.begin(), sortedClasses.end(),
+    [](const WrapXMLReflectionClass *a, const WrapXMLReflectionClass *b)
+    { return lessName(a->Name, b->Name); });
+
+  std::mt19937 generator(12345);
+  std::shuffle(classQueries.begin(), classQueries.end(), generator);
+  std::shuffle(propertyQueries.begin(), propertyQueries.end(), generator);
+
+  std::printf("%d modules, %d classes, %d properties, %d rounds\n",
+              registry->NumberOfModules,
+              static_cast<int>(sortedClasses.size()),
+              static_cast<int>(propertyQueries.size()/2), rounds);
+
+  /* the class lookups */
+  std::vector<const void *> hashResults(classQueries.size());
+  std::vector<const void *> mapResults(classQueries.size());
+  std::vector<const void *> searchResults(classQueries.size());
+
+  double hashTime = timeLookups(classQueries, rounds, hashResults,
+    [registry](const std::string &name) -> const void *
+    { return vtkWrapXMLReflection_FindClass(registry, name.c_str()); });
+  double mapTime = timeLookups(classQueries, rounds, mapResults,
+    [&classMap](const std::string &name) -> const void *
+    {
+      auto it = classMap.find(name);
+      return (it != classMap.end() ? it->second : nullptr);
+    });
+  double searchTime = timeLookups(classQueries, rounds, searchResults,
+    [&sortedClasses](const std::string &name) -> const void *
+    { return binarySearch(sortedClasses, name.c_str()); });
+
+  if (hashResults != mapResults || hashResults != searchResults)
+  {
+    std::fprintf(stderr,
+      "vtkWrapXMLReflectBenchmark: class lookups differ\n");
+    return 1;
+  }
+  report("classes:", hashTime, mapTime, searchTime);
+
+  /* the property lookups */
+  hashResults.resize(propertyQueries.size());
+  mapResults.resize(propertyQueries.size());
+  searchResults.resize(propertyQueries.size());
+
+  hashTime = timeLookups(propertyQueries, rounds, hashResults,
+    [](const PropertyQuery &q) -> const void *
+    { return vtkWrapXMLReflection_FindProperty(q.Class, q.Name.c_str()); });
+  mapTime = timeLookups(propertyQueries, rounds, mapResults,
+    [](const PropertyQuery &q) -> const void *
+    {
+      auto it = q.Tables->Map.find(q.Name);
+      return (it != q.Tables->Map.end() ? it->second : nullptr);
+    });
+  searchTime = timeLookups(propertyQueries, rounds, searchResults,
+    [](const PropertyQuery &q) -> const void *
+    { return binarySearch(q.Tables->Sorted, q.Name.c_str()); });
+
+  if (hashResults != mapResults || hashResults != searchResults)
+  {
+    std::fprintf(stderr,
+      "vtkWrapXMLReflectBenchmark: property lookups differ\n");
+    return 1;
+  }
+  report("properties:", hashTime, mapTime, searchTime);
+
+  return 0;
+}
@@ -0,0 +1,293 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLReflection.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file declares the static reflection tables that are generated
+ * by "vtkWrapXML --reflection" and "vtkWrapXMLReflect".  It is not
+ * used by the wrapper tools themselves, it is included by the
+ * generated code and by the applications that use the tables.
+ *
+ * The tables are read-only data that are complete at compile time, so
+ * there is nothing to load or parse at run time.  For each module, the
+ * generated source file defines a module table with external linkage,
+ * whose name is the module name with every run of characters that are
+ * not letters or digits replaced by "_", followed by "_Reflection",
+ * e.g. "VTK_CommonCore_Reflection" for the module "VTK::CommonCore":
+ *
+ *   extern "C" const WrapXMLReflectionModule VTK_CommonCore_Reflection;
+ *
+ * The types of the properties are the VTK_PARSE constants from
+ * vtkParseType.h, and the method bitfields are the VTK_METHOD constants
+ * from vtkParseProperties.h.
+ *
+ * If the tables were generated with "vtkWrapXML --thunks", then each
+ * property also has a getter and a setter, which call the methods of
+ * the property on an object of the class.  The value is passed through
+ * a buffer whose contents depend on the property:
+ *
+ *   numbers:  one value, of the type given by "ClassName"
+ *   arrays:   "Count" values, of the type given by "ClassName"
+ *   strings:  a "const char *"
+ *   objects:  a "vtkObjectBase *", the setter only sets the property if
+ *             the object is NULL or is of the type given by "ClassName"
+ *
+ * except that if a property can only be set with its SetValueTo
+ * methods, the setter takes an "int" index into "EnumValueNames".
+ * The getter or the setter is NULL if the methods that it would call
+ * are not public.
+ *
+ * The classes of each module, and the properties of each class, can be
+ * looked up by name through minimal perfect hash tables that were built
+ * when the tables were generated.  A lookup computes the hash of the
+ * name, uses the hash to choose a bucket and the displacement of the
+ * bucket to choose a slot, and then compares the name that is in the
+ * slot.  Lookups over all the modules of a build can be done with the
+ * registry that is written by "vtkWrapXMLReflect --registry":
+ *
+ *   extern "C" const WrapXMLReflectionRegistry vtkWrapXML_Registry;
+ *
+ * The lookup functions are inline C++ functions, and C code can do the
+ * same computation, which is described in vtkWrapXMLPerfectHash.h.
+ */
+
+#ifndef VTK_WRAP_XML_REFLECTION_H
+#define VTK_WRAP_XML_REFLECTION_H
+
+#ifdef __cplusplus
+class vtkObjectBase;
+#else
+typedef struct vtkObjectBase vtkObjectBase;
+#endif
+
+/**
+ * The accessor thunks for a property
+ */
+typedef void (*WrapXMLReflectionGetter)(vtkObjectBase *object, void *value);
+typedef void (*WrapXMLReflectionSetter)(
+  vtkObjectBase *object, const void *value);
+
+/**
+ * A perfect hash table, with one slot per entry of the table that it
+ * indexes, the hash selects one of the buckets and the displacement of
+ * the bucket selects the slot
+ */
+typedef struct _WrapXMLReflectionHash
+{
+  int                 NumberOfBuckets;
+  const unsigned int *Displacements;  /* the displacement of each bucket */
+  const int          *Slots;          /* the index in each slot, or -1 */
+} WrapXMLReflectionHash;
+
+/**
+ * A property of a class
+ */
+typedef struct _WrapXMLReflectionProperty
+{
+  const char         *Name;           /* the property name */
+  unsigned int        Type;           /* a VTK_PARSE type constant */
+  int                 Count;          /* the size for array properties */
+  const char         *ClassName;      /* the class for object properties */
+  const char *const  *EnumValueNames; /* names for SetValueTo methods */
+  int                 NumberOfEnumValues;
+  unsigned int        PublicMethods;  /* a VTK_METHOD bitfield */
+  WrapXMLReflectionGetter Get;        /* get the value, or NULL */
+  WrapXMLReflectionSetter Set;        /* set the value, or NULL */
+} WrapXMLReflectionProperty;
+
+/**
+ * A public method of a class
+ */
+typedef struct _WrapXMLReflectionMethod
+{
+  const char *Name;       /* the method name */
+  const char *Signature;  /* the declaration, as in the XML */
+  int         Property;   /* the index of the property, or -1 */
+  int         IsStatic;   /* set for static methods */
+} WrapXMLReflectionMethod;
+
+/**
+ * A class, with its public properties and methods
+ */
+typedef struct _WrapXMLReflectionClass
+{
+  const char                      *Name;        /* the class name */
+  const char                      *SuperClass;  /* the base, or NULL */
+  int                              IsAbstract;
+  int                              NumberOfProperties;
+  const WrapXMLReflectionProperty *Properties;
+  WrapXMLReflectionHash            PropertyHash;
+  int                              NumberOfMethods;
+  const WrapXMLReflectionMethod   *Methods;
+  unsigned long long               Fingerprint; /* the API fingerprint */
+} WrapXMLReflectionClass;
+
+/**
+ * A module, with its classes in the order of its headers
+ */
+typedef struct _WrapXMLReflectionModule
+{
+  const char                          *Name;     /* e.g. "VTK::CommonCore" */
+  int                                  NumberOfClasses;
+  const WrapXMLReflectionClass *const *Classes;
+  WrapXMLReflectionHash                ClassHash;
+} WrapXMLReflectionModule;
+
+/**
+ * All the modules of a build, with a table of the classes of all the
+ * modules, where the slots of the hash hold the module indices
+ */
+typedef struct _WrapXMLReflectionRegistry
+{
+  int                                   NumberOfModules;
+  const WrapXMLReflectionModule *const *Modules;
+  int                                   NumberOfClasses;
+  WrapXMLReflectionHash                 ClassHash;
+  const int                            *ClassIndices; /* index in module */
+} WrapXMLReflectionRegistry;
+
+#ifdef __cplusplus
+
+#include <cstring>
+
+/**
+ * Read a little-endian word, compilers turn this into a single load
+ */
+inline unsigned long long vtkWrapXMLReflection_Word(const unsigned char *cp)
+{
+  typedef unsigned long long word;
+  return (static_cast<word>(cp[0]) | (static_cast<word>(cp[1]) << 8) |
+          (static_cast<word>(cp[2]) << 16) | (static_cast<word>(cp[3]) << 24) |
+          (static_cast<word>(cp[4]) << 32) | (static_cast<word>(cp[5]) << 40) |
+          (static_cast<word>(cp[6]) << 48) | (static_cast<word>(cp[7]) << 56));
+}
+
+/**
+ * Compute the hash of a name, as described in vtkWrapXMLPerfectHash.h
+ */
+inline unsigned long long vtkWrapXMLReflection_Hash(const char *name)
+{
+  const unsigned char *cp = reinterpret_cast<const unsigned char *>(name);
+  std::size_t n = std::strlen(name);
+  unsigned long long h = 0xcbf29ce484222325ull;
+  unsigned long long w;
+  int i;
+
+  for (; n >= 8; n -= 8, cp += 8)
+  {
+    h = (h ^ vtkWrapXMLReflection_Word(cp))*0x9e3779b97f4a7c15ull;
+  }
+  w = 0;
+  for (i = static_cast<int>(n) - 1; i >= 0; i--)
+  {
+    w = (w << 8) | cp[i];
+  }
+  h = (h ^ w)*0x9e3779b97f4a7c15ull;
+
+  h ^= h >> 33;
+  h *= 0xff51afd7ed558ccdull;
+  h ^= h >> 33;
+  return h;
+}
+
+/**
+ * Get the slot for a hash, in a table with "size" slots
+ */
+inline int vtkWrapXMLReflection_Slot(
+  const WrapXMLReflectionHash *hash, int size, unsigned long long h)
+{
+  unsigned long long b = ((h & 0xffffffffu) *
+    static_cast<unsigned long long>(hash->NumberOfBuckets)) >> 32;
+  unsigned long long d = hash->Displacements[b];
+  unsigned long long x = (h ^ (d * 0x9e3779b97f4a7c15ull));
+  x *= 0xff51afd7ed558ccdull;
+  return static_cast<int>(
+    ((x >> 32) * static_cast<unsigned long long>(size)) >> 32);
+}
+
+/**
+ * Find a property of a class, or return nullptr
+ */
+inline const WrapXMLReflectionProperty *vtkWrapXMLReflection_FindProperty(
+  const WrapXMLReflectionClass *cls, const char *name)
+{
+  const WrapXMLReflectionProperty *property;
+  int i;
+
+  if (cls->PropertyHash.NumberOfBuckets == 0)
+  {
+    return nullptr;
+  }
+  i = cls->PropertyHash.Slots[vtkWrapXMLReflection_Slot(
+    &cls->PropertyHash, cls->NumberOfProperties,
+    vtkWrapXMLReflection_Hash(name))];
+  if (i < 0)
+  {
+    return nullptr;
+  }
+  property = &cls->Properties[i];
+  return (std::strcmp(property->Name, name) == 0 ? property : nullptr);
+}
+
+/**
+ * Find a class in a module, or return nullptr
+ */
+inline const WrapXMLReflectionClass *vtkWrapXMLReflection_FindClass(
+  const WrapXMLReflectionModule *module, const char *name)
+{
+  const WrapXMLReflectionClass *cls;
+  int i;
+
+  if (module->ClassHash.NumberOfBuckets == 0)
+  {
+    return nullptr;
+  }
+  i = module->ClassHash.Slots[vtkWrapXMLReflection_Slot(
+    &module->ClassHash, module->NumberOfClasses,
+    vtkWrapXMLReflection_Hash(name))];
+  if (i < 0)
+  {
+    return nullptr;
+  }
+  cls = module->Classes[i];
+  return (std::strcmp(cls->Name, name) == 0 ? cls : nullptr);
+}
+
+/**
+ * Find a class in any module of a registry, or return nullptr
+ */
+inline const WrapXMLReflectionClass *vtkWrapXMLReflection_FindClass(
+  const WrapXMLReflectionRegistry *registry, const char *name)
+{
+  const WrapXMLReflectionClass *cls;
+  int s, m;
+
+  if (registry->ClassHash.NumberOfBuckets == 0)
+  {
+    return nullptr;
+  }
+  s = vtkWrapXMLReflection_Slot(
+    &registry->ClassHash, registry->NumberOfClasses,
+    vtkWrapXMLReflection_Hash(name));
+  m = registry->ClassHash.Slots[s];
+  if (m < 0)
+  {
+    return nullptr;
+  }
+  cls = registry->Modules[m]->Classes[registry->ClassIndices[s]];
+  return (std::strcmp(cls->Name, name) == 0 ? cls : nullptr);
+}
+
+#endif /* __cplusplus */
+
+#endif
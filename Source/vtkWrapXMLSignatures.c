@@ -0,0 +1,150 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLSignatures.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLSignatures.h"
+#include "vtkParse.h"
+#include <stdint.h>
+#include <string.h>
+
+/*-------------------------------------------------------------------
+ * hash a pointer into a slot index */
+
+static unsigned int pointerSlot(const void *ptr, unsigned int size)
+{
+  uint64_t h = (uint64_t)(uintptr_t)ptr;
+
+  /* Fibonacci hashing, the low bits of a pointer are mostly zero */
+  h *= 0x9e3779b97f4a7c15ull;
+
+  return (unsigned int)(h >> 32) & (size - 1);
+}
+
+/*-------------------------------------------------------------------
+ * initialize the table */
+
+void vtkWrapXMLSignatures_Init(WrapXMLSignatures *sigs, WrapXMLArena *arena)
+{
+  memset(sigs, 0, sizeof(WrapXMLSignatures));
+  sigs->Arena = arena;
+}
+
+/*-------------------------------------------------------------------
+ * double the size of the table */
+
+static void growTable(WrapXMLSignatures *sigs)
+{
+  WrapXMLSignatures old = *sigs;
+  unsigned int i, j;
+
+  sigs->Size = (old.Size == 0 ? 256 : 2*old.Size);
+  sigs->Functions = (FunctionInfo **)vtkWrapXMLArena_Alloc(
+    sigs->Arena, sizeof(FunctionInfo *)*sigs->Size);
+  sigs->Text = (const char **)vtkWrapXMLArena_Alloc(
+    sigs->Arena, sizeof(char *)*sigs->Size);
+  sigs->Length = (size_t *)vtkWrapXMLArena_Alloc(
+    sigs->Arena, sizeof(size_t)*sigs->Size);
+
+  for (i = 0; i < old.Size; i++)
+  {
+    if (old.Functions[i])
+    {
+      j = pointerSlot(old.Functions[i], sigs->Size);
+      while (sigs->Functions[j])
+      {
+        j = (j + 1) & (sigs->Size - 1);
+      }
+      sigs->Functions[j] = old.Functions[i];
+      sigs->Text[j] = old.Text[i];
+      sigs->Length[j] = old.Length[i];
+    }
+  }
+}
+
+/*-------------------------------------------------------------------
+ * get the signature, render it if necessary */
+
+const char *vtkWrapXMLSignatures_Get(
+  WrapXMLSignatures *sigs, FunctionInfo *func, size_t *length)
+{
+  unsigned int i;
+  char *text;
+  size_t n;
+
+  if ((unsigned int)(2*sigs->Count) >= sigs->Size)
+  {
+    growTable(sigs);
+  }
+
+  i = pointerSlot(func, sigs->Size);
+  while (sigs->Functions[i])
+  {
+    if (sigs->Functions[i] == func)
+    {
+      *length = sigs->Length[i];
+      return sigs->Text[i];
+    }
+    i = (i + 1) & (sigs->Size - 1);
+  }
+
+  /* the parser can only render into a buffer that is large enough,
+   * so the first call measures the signature */
+  n = vtkParse_FunctionInfoToString(func, NULL, VTK_PARSE_EVERYTHING);
+  text = (char *)vtkWrapXMLArena_Alloc(sigs->Arena, n + 1);
+  vtkParse_FunctionInfoToString(func, text, VTK_PARSE_EVERYTHING);
+
+  sigs->Functions[i] = func;
+  sigs->Text[i] = text;
+  sigs->Length[i] = n;
+  sigs->Count++;
+
+  *length = n;
+  return text;
+}
+
+/*-------------------------------------------------------------------
+ * add the signatures from another table */
+
+void vtkWrapXMLSignatures_Merge(
+  WrapXMLSignatures *sigs, const WrapXMLSignatures *other)
+{
+  FunctionInfo *func;
+  unsigned int i, j;
+
+  for (i = 0; i < other->Size; i++)
+  {
+    func = other->Functions[i];
+    if (func == NULL)
+    {
+      continue;
+    }
+
+    if ((unsigned int)(2*sigs->Count) >= sigs->Size)
+    {
+      growTable(sigs);
+    }
+
+    j = pointerSlot(func, sigs->Size);
+    while (sigs->Functions[j] && sigs->Functions[j] != func)
+    {
+      j = (j + 1) & (sigs->Size - 1);
+    }
+    if (sigs->Functions[j] == NULL)
+    {
+      sigs->Functions[j] = func;
+      sigs->Text[j] = other->Text[i];
+      sigs->Length[j] = other->Length[i];
+      sigs->Count++;
+    }
+  }
+}
@@ -0,0 +1,69 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLSignatures.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file provides a cache of rendered function signatures, so that
+ * each signature is rendered at most once no matter how many times,
+ * or by how many output backends, it is written.  The signatures are
+ * stored in an arena and are released when the arena is reset.
+ */
+
+#ifndef VTK_WRAP_XML_SIGNATURES_H
+#define VTK_WRAP_XML_SIGNATURES_H
+
+#include "vtkParseData.h"
+#include "vtkWrapXMLArena.h"
+
+/**
+ * A hash table from FunctionInfo to its rendered signature
+ */
+typedef struct _WrapXMLSignatures
+{
+  unsigned int    Size;       /* number of slots, a power of two */
+  int             Count;      /* number of signatures in the table */
+  FunctionInfo  **Functions;  /* the key for each slot */
+  const char    **Text;       /* the rendered signature for each slot */
+  size_t         *Length;     /* the length of each signature */
+  WrapXMLArena   *Arena;      /* the memory for the table */
+} WrapXMLSignatures;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Initialize an empty table that uses the given arena
+ */
+void vtkWrapXMLSignatures_Init(WrapXMLSignatures *sigs, WrapXMLArena *arena);
+
+/**
+ * Get the signature of a function, rendering it if it is not yet in
+ * the table.  The length of the signature is returned in "length".
+ */
+const char *vtkWrapXMLSignatures_Get(
+  WrapXMLSignatures *sigs, FunctionInfo *func, size_t *length);
+
+/**
+ * Add the signatures from another table that are not yet in this one.
+ * The text is not copied, so the other table's arena must not be reset
+ * while this table is in use.
+ */
+void vtkWrapXMLSignatures_Merge(
+  WrapXMLSignatures *sigs, const WrapXMLSignatures *other);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
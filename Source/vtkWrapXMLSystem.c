@@ -0,0 +1,219 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLSystem.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLSystem.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+#include <sys/types.h>
+#include <sys/stat.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#define PSAPI_VERSION 2
+#include <psapi.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/resource.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+
+/* returned for empty files, since they cannot be mapped */
+static const char emptyFile[1] = { '\0' };
+
+/*-------------------------------------------------------------------
+ * map a file into memory */
+
+const char *vtkWrapXMLSystem_MapFile(const char *filename, size_t *size)
+{
+#if defined(_WIN32)
+  HANDLE fh;
+  HANDLE mh;
+  LARGE_INTEGER filesize;
+  const char *data;
+
+  *size = 0;
+
+  fh = CreateFileA(filename, GENERIC_READ, FILE_SHARE_READ, NULL,
+                   OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+  if (fh == INVALID_HANDLE_VALUE)
+  {
+    return NULL;
+  }
+
+  if (!GetFileSizeEx(fh, &filesize))
+  {
+    CloseHandle(fh);
+    return NULL;
+  }
+
+  if (filesize.QuadPart == 0)
+  {
+    CloseHandle(fh);
+    return emptyFile;
+  }
+
+  mh = CreateFileMappingA(fh, NULL, PAGE_READONLY, 0, 0, NULL);
+  CloseHandle(fh);
+  if (mh == NULL)
+  {
+    return NULL;
+  }
+
+  data = (const char *)MapViewOfFile(mh, FILE_MAP_READ, 0, 0, 0);
+  CloseHandle(mh);
+  if (data == NULL)
+  {
+    return NULL;
+  }
+
+  *size = (size_t)filesize.QuadPart;
+  return data;
+#else
+  int fd;
+  struct stat fs;
+  void *data;
+
+  *size = 0;
+
+  fd = open(filename, O_RDONLY);
+  if (fd < 0)
+  {
+    return NULL;
+  }
+
+  if (fstat(fd, &fs) != 0)
+  {
+    close(fd);
+    return NULL;
+  }
+
+  if (fs.st_size == 0)
+  {
+    close(fd);
+    return emptyFile;
+  }
+
+  data = mmap(NULL, (size_t)fs.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+  close(fd);
+  if (data == MAP_FAILED)
+  {
+    return NULL;
+  }
+
+  *size = (size_t)fs.st_size;
+  return (const char *)data;
+#endif
+}
+
+/*-------------------------------------------------------------------
+ * unmap a file that was mapped with vtkWrapXMLSystem_MapFile */
+
+void vtkWrapXMLSystem_UnmapFile(const char *data, size_t size)
+{
+  if (data == NULL || data == emptyFile)
+  {
+    return;
+  }
+
+#if defined(_WIN32)
+  (void)size;
+  UnmapViewOfFile(data);
+#else
+  munmap((void *)data, size);
+#endif
+}
+
+/*-------------------------------------------------------------------
+ * get the modification time and size of a file */
+
+int vtkWrapXMLSystem_FileStamp(
+  const char *filename, long long *mtime, long long *size)
+{
+#if defined(_WIN32)
+  struct _stat64 fs;
+
+  if (_stat64(filename, &fs) != 0)
+  {
+    return 0;
+  }
+#else
+  struct stat fs;
+
+  if (stat(filename, &fs) != 0)
+  {
+    return 0;
+  }
+#endif
+
+  *mtime = (long long)fs.st_mtime;
+  *size = (long long)fs.st_size;
+
+  return 1;
+}
+
+/*-------------------------------------------------------------------
+ * read a monotonic clock */
+
+double vtkWrapXMLSystem_Clock(void)
+{
+#if defined(_WIN32)
+  LARGE_INTEGER count, frequency;
+
+  QueryPerformanceCounter(&count);
+  QueryPerformanceFrequency(&frequency);
+
+  return (double)count.QuadPart/(double)frequency.QuadPart;
+#else
+  struct timespec ts;
+
+  clock_gettime(CLOCK_MONOTONIC, &ts);
+
+  return (double)ts.tv_sec + 1e-9*(double)ts.tv_nsec;
+#endif
+}
+
+/*-------------------------------------------------------------------
+ * get the peak resident memory of the process */
+
+size_t vtkWrapXMLSystem_PeakMemory(void)
+{
+#if defined(_WIN32)
+  PROCESS_MEMORY_COUNTERS pmc;
+
+  if (!GetProcessMemoryInfo(GetCurrentProcess(), &pmc, sizeof(pmc)))
+  {
+    return 0;
+  }
+
+  return (size_t)pmc.PeakWorkingSetSize;
+#else
+  struct rusage usage;
+
+  if (getrusage(RUSAGE_SELF, &usage) != 0)
+  {
+    return 0;
+  }
+
+#if defined(__APPLE__)
+  /* macOS gives the size in bytes */
+  return (size_t)usage.ru_maxrss;
+#else
+  /* linux and the BSDs give the size in kilobytes */
+  return (size_t)usage.ru_maxrss*1024;
+#endif
+#endif
+}
@@ -0,0 +1,65 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLSystem.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file contains the few platform-dependent helpers that are
+ * needed by vtkWrapXML, such as mapping a file into memory.
+ */
+
+#ifndef VTK_WRAP_XML_SYSTEM_H
+#define VTK_WRAP_XML_SYSTEM_H
+
+#include <stddef.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Map a file into memory for reading.  The size of the file is returned
+ * in "size".  The returned memory is read-only and is not nul-terminated.
+ * Returns NULL if the file could not be opened.
+ */
+const char *vtkWrapXMLSystem_MapFile(const char *filename, size_t *size);
+
+/**
+ * Release a file that was mapped with vtkWrapXMLSystem_MapFile()
+ */
+void vtkWrapXMLSystem_UnmapFile(const char *data, size_t size);
+
+/**
+ * Get the modification time (in seconds) and the size of a file,
+ * for checking whether the file has changed.  Returns zero if the
+ * file does not exist.
+ */
+int vtkWrapXMLSystem_FileStamp(
+  const char *filename, long long *mtime, long long *size);
+
+/**
+ * Get the time in seconds from a monotonic clock, for measuring how
+ * long things take.  The zero of the clock is arbitrary.
+ */
+double vtkWrapXMLSystem_Clock(void);
+
+/**
+ * Get the peak resident memory of the process, in bytes.  Returns zero
+ * if this is not available on the platform.
+ */
+size_t vtkWrapXMLSystem_PeakMemory(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,284 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLThreads.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLThreads.h"
+#include <stdlib.h>
+
+#if defined(_WIN32)
+#include <windows.h>
+#else
+#include <pthread.h>
+#include <unistd.h>
+#endif
+
+struct _WrapXMLThread
+{
+#if defined(_WIN32)
+  HANDLE Handle;
+#else
+  pthread_t Handle;
+#endif
+  WrapXMLThreadFunction Function;
+  void *Argument;
+};
+
+struct _WrapXMLMutex
+{
+#if defined(_WIN32)
+  CRITICAL_SECTION Section;
+#else
+  pthread_mutex_t Mutex;
+#endif
+};
+
+struct _WrapXMLQueue
+{
+#if defined(_WIN32)
+  CRITICAL_SECTION Section;
+  CONDITION_VARIABLE NotEmpty;
+  CONDITION_VARIABLE NotFull;
+#else
+  pthread_mutex_t Mutex;
+  pthread_cond_t NotEmpty;
+  pthread_cond_t NotFull;
+#endif
+  void **Items;
+  int Capacity;
+  int First;
+  int Count;
+  int Closed;
+};
+
+/*-------------------------------------------------------------------
+ * start and join threads */
+
+#if defined(_WIN32)
+static DWORD WINAPI threadMain(LPVOID arg)
+{
+  WrapXMLThread *thread = (WrapXMLThread *)arg;
+  thread->Function(thread->Argument);
+  return 0;
+}
+#else
+static void *threadMain(void *arg)
+{
+  WrapXMLThread *thread = (WrapXMLThread *)arg;
+  thread->Function(thread->Argument);
+  return NULL;
+}
+#endif
+
+WrapXMLThread *vtkWrapXMLThreads_Start(WrapXMLThreadFunction func, void *arg)
+{
+  WrapXMLThread *thread;
+
+  thread = (WrapXMLThread *)malloc(sizeof(WrapXMLThread));
+  thread->Function = func;
+  thread->Argument = arg;
+
+#if defined(_WIN32)
+  thread->Handle = CreateThread(NULL, 0, threadMain, thread, 0, NULL);
+  if (thread->Handle == NULL)
+  {
+    free(thread);
+    return NULL;
+  }
+#else
+  if (pthread_create(&thread->Handle, NULL, threadMain, thread) != 0)
+  {
+    free(thread);
+    return NULL;
+  }
+#endif
+
+  return thread;
+}
+
+void vtkWrapXMLThreads_Join(WrapXMLThread *thread)
+{
+#if defined(_WIN32)
+  WaitForSingleObject(thread->Handle, INFINITE);
+  CloseHandle(thread->Handle);
+#else
+  pthread_join(thread->Handle, NULL);
+#endif
+  free(thread);
+}
+
+/*-------------------------------------------------------------------
+ * mutexes */
+
+WrapXMLMutex *vtkWrapXMLThreads_NewMutex(void)
+{
+  WrapXMLMutex *mutex;
+
+  mutex = (WrapXMLMutex *)malloc(sizeof(WrapXMLMutex));
+#if defined(_WIN32)
+  InitializeCriticalSection(&mutex->Section);
+#else
+  pthread_mutex_init(&mutex->Mutex, NULL);
+#endif
+
+  return mutex;
+}
+
+void vtkWrapXMLThreads_Lock(WrapXMLMutex *mutex)
+{
+#if defined(_WIN32)
+  EnterCriticalSection(&mutex->Section);
+#else
+  pthread_mutex_lock(&mutex->Mutex);
+#endif
+}
+
+void vtkWrapXMLThreads_Unlock(WrapXMLMutex *mutex)
+{
+#if defined(_WIN32)
+  LeaveCriticalSection(&mutex->Section);
+#else
+  pthread_mutex_unlock(&mutex->Mutex);
+#endif
+}
+
+void vtkWrapXMLThreads_DeleteMutex(WrapXMLMutex *mutex)
+{
+#if defined(_WIN32)
+  DeleteCriticalSection(&mutex->Section);
+#else
+  pthread_mutex_destroy(&mutex->Mutex);
+#endif
+  free(mutex);
+}
+
+/*-------------------------------------------------------------------
+ * queues */
+
+WrapXMLQueue *vtkWrapXMLThreads_NewQueue(int capacity)
+{
+  WrapXMLQueue *queue;
+
+  queue = (WrapXMLQueue *)malloc(sizeof(WrapXMLQueue));
+  queue->Capacity = (capacity > 0 ? capacity : 1);
+  queue->Items = (void **)malloc(queue->Capacity*sizeof(void *));
+  queue->First = 0;
+  queue->Count = 0;
+  queue->Closed = 0;
+#if defined(_WIN32)
+  InitializeCriticalSection(&queue->Section);
+  InitializeConditionVariable(&queue->NotEmpty);
+  InitializeConditionVariable(&queue->NotFull);
+#else
+  pthread_mutex_init(&queue->Mutex, NULL);
+  pthread_cond_init(&queue->NotEmpty, NULL);
+  pthread_cond_init(&queue->NotFull, NULL);
+#endif
+
+  return queue;
+}
+
+#if defined(_WIN32)
+#define queueLock(q) EnterCriticalSection(&(q)->Section)
+#define queueUnlock(q) LeaveCriticalSection(&(q)->Section)
+#define queueWait(q, c) SleepConditionVariableCS(&(q)->c, &(q)->Section, \
+                                                 INFINITE)
+#define queueWake(q, c) WakeConditionVariable(&(q)->c)
+#define queueWakeAll(q, c) WakeAllConditionVariable(&(q)->c)
+#else
+#define queueLock(q) pthread_mutex_lock(&(q)->Mutex)
+#define queueUnlock(q) pthread_mutex_unlock(&(q)->Mutex)
+#define queueWait(q, c) pthread_cond_wait(&(q)->c, &(q)->Mutex)
+#define queueWake(q, c) pthread_cond_signal(&(q)->c)
+#define queueWakeAll(q, c) pthread_cond_broadcast(&(q)->c)
+#endif
+
+void vtkWrapXMLThreads_Push(WrapXMLQueue *queue, void *item)
+{
+  queueLock(queue);
+  while (queue->Count == queue->Capacity)
+  {
+    queueWait(queue, NotFull);
+  }
+  queue->Items[(queue->First + queue->Count) % queue->Capacity] = item;
+  queue->Count++;
+  queueWake(queue, NotEmpty);
+  queueUnlock(queue);
+}
+
+void *vtkWrapXMLThreads_Pop(WrapXMLQueue *queue)
+{
+  void *item = NULL;
+
+  queueLock(queue);
+  while (queue->Count == 0 && !queue->Closed)
+  {
+    queueWait(queue, NotEmpty);
+  }
+  if (queue->Count > 0)
+  {
+    item = queue->Items[queue->First];
+    queue->First = (queue->First + 1) % queue->Capacity;
+    queue->Count--;
+    queueWake(queue, NotFull);
+  }
+  queueUnlock(queue);
+
+  return item;
+}
+
+int vtkWrapXMLThreads_QueueLength(WrapXMLQueue *queue)
+{
+  int n;
+
+  queueLock(queue);
+  n = queue->Count;
+  queueUnlock(queue);
+
+  return n;
+}
+
+void vtkWrapXMLThreads_CloseQueue(WrapXMLQueue *queue)
+{
+  queueLock(queue);
+  queue->Closed = 1;
+  queueWakeAll(queue, NotEmpty);
+  queueUnlock(queue);
+}
+
+void vtkWrapXMLThreads_DeleteQueue(WrapXMLQueue *queue)
+{
+#if defined(_WIN32)
+  DeleteCriticalSection(&queue->Section);
+#else
+  pthread_cond_destroy(&queue->NotEmpty);
+  pthread_cond_destroy(&queue->NotFull);
+  pthread_mutex_destroy(&queue->Mutex);
+#endif
+  free(queue->Items);
+  free(queue);
+}
+
+/*-------------------------------------------------------------------
+ * the number of processors */
+
+int vtkWrapXMLThreads_NumberOfProcessors(void)
+{
+#if defined(_WIN32)
+  SYSTEM_INFO info;
+  GetSystemInfo(&info);
+  return (int)info.dwNumberOfProcessors;
+#else
+  long n = sysconf(_SC_NPROCESSORS_ONLN);
+  return (n > 0 ? (int)n : 1);
+#endif
+}
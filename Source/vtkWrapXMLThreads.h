@@ -0,0 +1,107 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLThreads.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file provides the threads, mutexes, and queues that vtkWrapXML
+ * uses to do work concurrently, with pthreads or with the Win32 API.
+ */
+
+#ifndef VTK_WRAP_XML_THREADS_H
+#define VTK_WRAP_XML_THREADS_H
+
+/**
+ * The function that a thread runs
+ */
+typedef void (*WrapXMLThreadFunction)(void *arg);
+
+/**
+ * A thread, a mutex, and a queue, these are opaque
+ */
+typedef struct _WrapXMLThread WrapXMLThread;
+typedef struct _WrapXMLMutex WrapXMLMutex;
+typedef struct _WrapXMLQueue WrapXMLQueue;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Start a thread that calls func(arg).  Returns NULL if the thread
+ * could not be started, in which case the caller should do the work.
+ */
+WrapXMLThread *vtkWrapXMLThreads_Start(WrapXMLThreadFunction func, void *arg);
+
+/**
+ * Wait for a thread to finish, and free it
+ */
+void vtkWrapXMLThreads_Join(WrapXMLThread *thread);
+
+/**
+ * Create a mutex
+ */
+WrapXMLMutex *vtkWrapXMLThreads_NewMutex(void);
+
+/**
+ * Lock and unlock a mutex
+ */
+void vtkWrapXMLThreads_Lock(WrapXMLMutex *mutex);
+void vtkWrapXMLThreads_Unlock(WrapXMLMutex *mutex);
+
+/**
+ * Free a mutex
+ */
+void vtkWrapXMLThreads_DeleteMutex(WrapXMLMutex *mutex);
+
+/**
+ * Create a queue that holds at most "capacity" items, for passing
+ * work from one thread to another
+ */
+WrapXMLQueue *vtkWrapXMLThreads_NewQueue(int capacity);
+
+/**
+ * Add an item to the end of the queue, waiting while the queue is full
+ */
+void vtkWrapXMLThreads_Push(WrapXMLQueue *queue, void *item);
+
+/**
+ * Remove the item at the front of the queue, waiting while the queue
+ * is empty.  Returns NULL when the queue is empty and has been closed.
+ */
+void *vtkWrapXMLThreads_Pop(WrapXMLQueue *queue);
+
+/**
+ * Get the number of items that are waiting in the queue
+ */
+int vtkWrapXMLThreads_QueueLength(WrapXMLQueue *queue);
+
+/**
+ * Close the queue, to say that no more items will be pushed
+ */
+void vtkWrapXMLThreads_CloseQueue(WrapXMLQueue *queue);
+
+/**
+ * Free a queue
+ */
+void vtkWrapXMLThreads_DeleteQueue(WrapXMLQueue *queue);
+
+/**
+ * Get the number of processors that are available
+ */
+int vtkWrapXMLThreads_NumberOfProcessors(void);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
@@ -0,0 +1,195 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLTrace.c
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+#include "vtkWrapXMLTrace.h"
+#include "vtkWrapXMLSystem.h"
+#include <stdlib.h>
+
+/* all events are given the same process id */
+#define TRACE_PID 1
+
+/*-------------------------------------------------------------------
+ * write a string as a JSON string */
+
+static void writeString(FILE *fp, const char *text)
+{
+  const unsigned char *cp;
+
+  putc('\"', fp);
+  for (cp = (const unsigned char *)text; *cp != '\0'; cp++)
+  {
+    if (*cp == '\"' || *cp == '\\')
+    {
+      putc('\\', fp);
+      putc(*cp, fp);
+    }
+    else if (*cp < 0x20)
+    {
+      fprintf(fp, "\\u%04x", *cp);
+    }
+    else
+    {
+      putc(*cp, fp);
+    }
+  }
+  putc('\"', fp);
+}
+
+/*-------------------------------------------------------------------
+ * start an event, the mutex must be held */
+
+static void beginEvent(WrapXMLTrace *trace)
+{
+  fputs((trace->Count == 0 ? "\n" : ",\n"), trace->File);
+  trace->Count++;
+}
+
+/*-------------------------------------------------------------------
+ * create the trace file */
+
+WrapXMLTrace *vtkWrapXMLTrace_Open(const char *fileName)
+{
+  WrapXMLTrace *trace;
+  FILE *fp;
+
+  fp = fopen(fileName, "w");
+  if (fp == NULL)
+  {
+    return NULL;
+  }
+
+  trace = (WrapXMLTrace *)malloc(sizeof(WrapXMLTrace));
+  trace->File = fp;
+  trace->Start = vtkWrapXMLSystem_Clock();
+  trace->Count = 0;
+  trace->Mutex = vtkWrapXMLThreads_NewMutex();
+
+  fputs("{\"traceEvents\":[", fp);
+
+  return trace;
+}
+
+/*-------------------------------------------------------------------
+ * the time in microseconds */
+
+double vtkWrapXMLTrace_Now(WrapXMLTrace *trace)
+{
+  if (trace == NULL)
+  {
+    return 0.0;
+  }
+
+  return 1e6*(vtkWrapXMLSystem_Clock() - trace->Start);
+}
+
+/*-------------------------------------------------------------------
+ * add a complete event */
+
+void vtkWrapXMLTrace_Span(
+  WrapXMLTrace *trace, int thread, const char *name, const char *file,
+  double start)
+{
+  double now;
+
+  if (trace == NULL)
+  {
+    return;
+  }
+
+  now = vtkWrapXMLTrace_Now(trace);
+
+  vtkWrapXMLThreads_Lock(trace->Mutex);
+  beginEvent(trace);
+  fputs("{\"name\":", trace->File);
+  writeString(trace->File, name);
+  fprintf(trace->File,
+          ",\"ph\":\"X\",\"pid\":%d,\"tid\":%d,\"ts\":%.3f,\"dur\":%.3f",
+          TRACE_PID, thread, start, now - start);
+  if (file)
+  {
+    fputs(",\"args\":{\"file\":", trace->File);
+    writeString(trace->File, file);
+    putc('}', trace->File);
+  }
+  putc('}', trace->File);
+  vtkWrapXMLThreads_Unlock(trace->Mutex);
+}
+
+/*-------------------------------------------------------------------
+ * add a counter event */
+
+void vtkWrapXMLTrace_Counter(
+  WrapXMLTrace *trace, const char *name, double value)
+{
+  double now;
+
+  if (trace == NULL)
+  {
+    return;
+  }
+
+  now = vtkWrapXMLTrace_Now(trace);
+
+  vtkWrapXMLThreads_Lock(trace->Mutex);
+  beginEvent(trace);
+  fputs("{\"name\":", trace->File);
+  writeString(trace->File, name);
+  fprintf(trace->File,
+          ",\"ph\":\"C\",\"pid\":%d,\"ts\":%.3f,\"args\":{\"value\":%.0f}}",
+          TRACE_PID, now, value);
+  vtkWrapXMLThreads_Unlock(trace->Mutex);
+}
+
+/*-------------------------------------------------------------------
+ * add a metadata event for the name of a thread */
+
+void vtkWrapXMLTrace_ThreadName(
+  WrapXMLTrace *trace, int thread, const char *name)
+{
+  if (trace == NULL)
+  {
+    return;
+  }
+
+  vtkWrapXMLThreads_Lock(trace->Mutex);
+  beginEvent(trace);
+  fprintf(trace->File,
+          "{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":%d,\"tid\":%d,"
+          "\"args\":{\"name\":", TRACE_PID, thread);
+  writeString(trace->File, name);
+  fputs("}}", trace->File);
+  vtkWrapXMLThreads_Unlock(trace->Mutex);
+}
+
+/*-------------------------------------------------------------------
+ * finish the file */
+
+int vtkWrapXMLTrace_Close(WrapXMLTrace *trace)
+{
+  int ok;
+
+  if (trace == NULL)
+  {
+    return 1;
+  }
+
+  fputs("\n],\"displayTimeUnit\":\"ms\"}\n", trace->File);
+  ok = !ferror(trace->File);
+  ok &= (fclose(trace->File) == 0);
+
+  vtkWrapXMLThreads_DeleteMutex(trace->Mutex);
+  free(trace);
+
+  return ok;
+}
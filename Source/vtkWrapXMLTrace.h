@@ -0,0 +1,89 @@
+/*=========================================================================
+
+  Program:   WrapVTK
+  Module:    vtkWrapXMLTrace.h
+
+  Copyright (c) 2010 David Gobbi
+  All rights reserved.
+
+     This software is distributed WITHOUT ANY WARRANTY; without even
+     the implied warranty of MERCHANTABILITY or FITNESS FOR A PARTICULAR
+     PURPOSE.
+
+=========================================================================*/
+
+/**
+ * This file writes a timeline of a run in the trace event format that
+ * is read by chrome://tracing and by Perfetto.  The timeline has a
+ * span for each phase of the work on each header, on the thread that
+ * did the work, and counters for things like the length of a queue.
+ *
+ * Events can be added from several threads at once.  Every function
+ * does nothing if the trace is NULL, so that callers do not have to
+ * check whether tracing was requested.
+ */
+
+#ifndef VTK_WRAP_XML_TRACE_H
+#define VTK_WRAP_XML_TRACE_H
+
+#include "vtkWrapXMLThreads.h"
+#include <stdio.h>
+
+/**
+ * A trace file that events are being written to
+ */
+typedef struct _WrapXMLTrace
+{
+  FILE          *File;    /* the trace file */
+  double         Start;   /* the clock when the file was opened */
+  int            Count;   /* the number of events that were written */
+  WrapXMLMutex  *Mutex;   /* protects the file */
+} WrapXMLTrace;
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Create a trace file.  Returns NULL if the file cannot be created.
+ */
+WrapXMLTrace *vtkWrapXMLTrace_Open(const char *fileName);
+
+/**
+ * Get the time since the trace was opened, in microseconds.  This is
+ * the start time to give to vtkWrapXMLTrace_Span().
+ */
+double vtkWrapXMLTrace_Now(WrapXMLTrace *trace);
+
+/**
+ * Add a span from the "start" time until now, on the given thread.
+ * The thread is a small number that the caller chooses.  If "file" is
+ * not NULL, it is shown as an argument of the span.
+ */
+void vtkWrapXMLTrace_Span(
+  WrapXMLTrace *trace, int thread, const char *name, const char *file,
+  double start);
+
+/**
+ * Set the value of a counter, as of now
+ */
+void vtkWrapXMLTrace_Counter(
+  WrapXMLTrace *trace, const char *name, double value);
+
+/**
+ * Give a name to a thread, for display
+ */
+void vtkWrapXMLTrace_ThreadName(
+  WrapXMLTrace *trace, int thread, const char *name);
+
+/**
+ * Finish the trace file and free the trace.  Returns zero if there was
+ * an error while writing the file.
+ */
+int vtkWrapXMLTrace_Close(WrapXMLTrace *trace);
+
+#ifdef __cplusplus
+} /* extern "C" */
+#endif
+
+#endif
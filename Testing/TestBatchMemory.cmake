@@ -0,0 +1,84 @@
+# Wrap N generated headers and then 4N generated headers with
+# "vtkWrapXML --batch --stats", and check that the arena and the peak
+# RSS stay flat, since the memory for each header must be released
+# once its file is written.
+#
+# Usage: cmake -DWRAPXML=<vtkWrapXML> -DWORK_DIR=<dir> [-DCOUNT=<N>]
+#              -P <this file>
+
+if (NOT COUNT)
+  set(COUNT 25)
+endif ()
+
+# the growth in KiB that is allowed for 4N headers, beyond a tenth
+set(_slack 1024)
+
+# write a header with a class that has a few properties and methods
+function (_write_header index)
+  set(_class "vtkMemoryTest${index}")
+  set(_text "class ${_class}\n{\npublic:\n")
+  foreach (_name IN ITEMS Value Origin Spacing Name Mode Size Opacity)
+    string(APPEND _text
+      "  /**\n   * Set the ${_name} of the object.\n   */\n"
+      "  void Set${_name}(double x);\n"
+      "  double Get${_name}();\n"
+      "  void Set${_name}(double x, double y, double z);\n"
+      "  void Set${_name}(const double x[3]);\n"
+      "  void Get${_name}(double x[3]);\n")
+  endforeach ()
+  string(APPEND _text
+    "  int IsA(const char *name);\n"
+    "  static ${_class} *New();\n"
+    "\nprotected:\n  ${_class}();\n  ~${_class}();\n};\n")
+  file(WRITE "${WORK_DIR}/headers/${_class}.h" "${_text}")
+endfunction ()
+
+# wrap the first n headers, and get the stats
+function (_wrap n rss reserved)
+  set(_headers)
+  math(EXPR _last "${n} - 1")
+  foreach (_i RANGE 0 ${_last})
+    list(APPEND _headers "${WORK_DIR}/headers/vtkMemoryTest${_i}.h")
+  endforeach ()
+  file(REMOVE_RECURSE "${WORK_DIR}/out${n}")
+  file(MAKE_DIRECTORY "${WORK_DIR}/out${n}")
+  execute_process(
+    COMMAND "${WRAPXML}" --batch --stats -o "${WORK_DIR}/out${n}"
+            ${_headers}
+    ERROR_VARIABLE _stats
+    RESULT_VARIABLE _result)
+  if (NOT _result EQUAL 0)
+    message(FATAL_ERROR "vtkWrapXML failed for ${n} headers:\n${_stats}")
+  endif ()
+  if (NOT _stats MATCHES
+      "peak RSS ([0-9]+) KiB, arena high-water [0-9]+ KiB, arena reserved ([0-9]+) KiB")
+    message(FATAL_ERROR "vtkWrapXML --stats gave no memory use:\n${_stats}")
+  endif ()
+  set("${rss}" "${CMAKE_MATCH_1}" PARENT_SCOPE)
+  set("${reserved}" "${CMAKE_MATCH_2}" PARENT_SCOPE)
+endfunction ()
+
+# check that a value for 4N headers is not much more than for N headers
+function (_check_flat what small large)
+  math(EXPR _limit "${small} + ${small}/10 + ${_slack}")
+  if (large GREATER _limit)
+    message(FATAL_ERROR
+      "${what} grew from ${small} KiB to ${large} KiB, "
+      "for ${COUNT} and then 4 times as many headers")
+  endif ()
+endfunction ()
+
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}/headers")
+
+math(EXPR _count4 "4*${COUNT}")
+math(EXPR _last "${_count4} - 1")
+foreach (_i RANGE 0 ${_last})
+  _write_header(${_i})
+endforeach ()
+
+_wrap(${COUNT} _rss1 _reserved1)
+_wrap(${_count4} _rss4 _reserved4)
+
+_check_flat("The peak RSS" ${_rss1} ${_rss4})
+_check_flat("The arena reserved size" ${_reserved1} ${_reserved4})
@@ -0,0 +1,105 @@
+# Wrap a header that declares several top-level classes, some of them
+# with nested classes, with and without --class-threads, and check that
+# the outputs, the manifests, and the reflection tables are the same
+# byte for byte.
+#
+# Usage: cmake -DWRAPXML=<vtkWrapXML> -DWORK_DIR=<dir> -P <this file>
+
+set(_header "${WORK_DIR}/vtkClassThreadsTest.h")
+
+# write the header, the classes share some signatures so that the
+# signatures and fingerprints from the threads have to be merged
+function (_write_header)
+  set(_text "/**\n * Classes for checking --class-threads.\n */\n\n")
+  string(APPEND _text "enum vtkThreadsTestMode { ModeA, ModeB, ModeC };\n\n")
+  foreach (_i RANGE 0 7)
+    set(_class "vtkThreadsTest${_i}")
+    string(APPEND _text
+      "/**\n * Class number ${_i}.\n */\nclass ${_class}\n{\npublic:\n"
+      "  static ${_class} *New();\n"
+      "  /**\n   * The value, which is shared by all the classes.\n   */\n"
+      "  void SetValue(double x);\n"
+      "  double GetValue();\n"
+      "  void SetOrigin(double x, double y, double z);\n"
+      "  void SetOrigin(const double x[3]);\n"
+      "  double *GetOrigin();\n"
+      "  void SetMode(int mode);\n"
+      "  int GetMode();\n"
+      "  void SetModeToA() { this->SetMode(ModeA); }\n"
+      "  void SetModeToB() { this->SetMode(ModeB); }\n"
+      "  void DebugOn();\n"
+      "  void DebugOff();\n"
+      "  void SetName(const char *name);\n"
+      "  const char *GetName();\n"
+      "  void Print${_i}(int indent, const char *text);\n")
+    if (_i EQUAL 2 OR _i EQUAL 5)
+      string(APPEND _text
+        "\n  /**\n   * A nested class.\n   */\n"
+        "  class Inner${_i}\n  {\n  public:\n"
+        "    void SetValue(double x);\n"
+        "    double GetValue();\n"
+        "    struct Point\n    {\n      double X, Y;\n    };\n"
+        "    void SetPoint(Point p);\n"
+        "  };\n"
+        "\n  enum Kind { KindA, KindB };\n"
+        "  void SetInner(Inner${_i} *inner);\n"
+        "  Inner${_i} *GetInner();\n")
+    endif ()
+    string(APPEND _text
+      "\nprotected:\n  ${_class}();\n  ~${_class}();\n"
+      "  double Value;\n};\n\n")
+  endforeach ()
+  string(APPEND _text
+    "struct vtkThreadsTestStruct\n{\n  int A;\n  double B[3];\n};\n")
+  file(WRITE "${_header}" "${_text}")
+endfunction ()
+
+# wrap the header into the named directory, with the given options
+function (_wrap name)
+  set(_dir "${WORK_DIR}/${name}")
+  file(MAKE_DIRECTORY "${_dir}")
+  execute_process(
+    COMMAND "${WRAPXML}" ${ARGN}
+            --manifest "${_dir}/test.manifest"
+            --reflection "${_dir}/test.reflection"
+            -o "${_dir}/test.out" "${_header}"
+    ERROR_VARIABLE _errors
+    RESULT_VARIABLE _result)
+  if (NOT _result EQUAL 0)
+    message(FATAL_ERROR "vtkWrapXML ${ARGN} failed:\n${_errors}")
+  endif ()
+endfunction ()
+
+# check that two runs wrote the same files
+function (_compare name1 name2)
+  foreach (_file IN ITEMS test.out test.manifest test.reflection)
+    execute_process(
+      COMMAND "${CMAKE_COMMAND}" -E compare_files
+              "${WORK_DIR}/${name1}/${_file}" "${WORK_DIR}/${name2}/${_file}"
+      RESULT_VARIABLE _result)
+    if (NOT _result EQUAL 0)
+      message(FATAL_ERROR
+        "${_file} differs between ${name1} and ${name2} in ${WORK_DIR}")
+    endif ()
+  endforeach ()
+endfunction ()
+
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+_write_header()
+
+# each set of options is checked with one thread per class and with
+# fewer threads than classes
+set(_runs xml table typecodes ndjson)
+set(_options_xml "")
+set(_options_table --comment-table)
+set(_options_typecodes --type-codes --overloads --split-comments)
+set(_options_ndjson --format ndjson)
+
+foreach (_run IN LISTS _runs)
+  _wrap(${_run} ${_options_${_run}})
+  foreach (_threads IN ITEMS 3 8)
+    _wrap(${_run}${_threads} ${_options_${_run}} --class-threads ${_threads})
+    _compare(${_run} ${_run}${_threads})
+  endforeach ()
+endforeach ()
@@ -0,0 +1,58 @@
+# Merge manifests with vtkWrapXMLIndex, where a manifest in the middle
+# has no classes, and check that the classes after it are kept both
+# when the index is written and when it is updated.
+#
+# Usage: cmake -DINDEX=<vtkWrapXMLIndex> -DWORK_DIR=<dir> -P <this file>
+
+set(_header "# WrapVTK manifest 1\n")
+set(_tab "\t")
+
+function (_write_manifest name class)
+  set(_text "${_header}")
+  if (class)
+    string(APPEND _text
+      "-${_tab}${class}${_tab}-${_tab}0${_tab}0${_tab}${class}.xml${_tab}0${_tab}10${_tab}-\n")
+  endif ()
+  file(WRITE "${WORK_DIR}/${name}.manifest" "${_text}")
+endfunction ()
+
+function (_check_classes)
+  execute_process(
+    COMMAND "${INDEX}" -o - "${WORK_DIR}/out.manifest"
+    OUTPUT_VARIABLE _output
+    RESULT_VARIABLE _result)
+  if (NOT _result EQUAL 0)
+    message(FATAL_ERROR "vtkWrapXMLIndex failed to read the index")
+  endif ()
+  foreach (_class IN LISTS ARGN)
+    if (NOT _output MATCHES "\t${_class}\t")
+      message(FATAL_ERROR "${_class} is missing from the index:\n${_output}")
+    endif ()
+  endforeach ()
+endfunction ()
+
+function (_merge)
+  execute_process(
+    COMMAND "${INDEX}" --update -o "${WORK_DIR}/out.manifest"
+            "${WORK_DIR}/a.manifest"
+            "${WORK_DIR}/empty.manifest"
+            "${WORK_DIR}/b.manifest"
+    RESULT_VARIABLE _result)
+  if (NOT _result EQUAL 0)
+    message(FATAL_ERROR "vtkWrapXMLIndex failed to merge the manifests")
+  endif ()
+endfunction ()
+
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+
+_write_manifest(a vtkA)
+_write_manifest(empty "")
+_write_manifest(b vtkB)
+_merge()
+_check_classes(vtkA vtkB)
+
+# change a manifest, so that the index is appended to and compacted
+_write_manifest(b vtkBB)
+_merge()
+_check_classes(vtkA vtkBB)
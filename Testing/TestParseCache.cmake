@@ -0,0 +1,195 @@
+# Wrap a header once to fill the --parse-cache file, and then again so
+# that the header is read from the cache, and check that both outputs
+# are the same byte for byte.  The second run must not parse the
+# header, which is checked with --trace.
+#
+# Usage: cmake -DWRAPXML=<vtkWrapXML> -DWORK_DIR=<dir> -P <this file>
+
+set(_header "${WORK_DIR}/vtkParseCacheTest.h")
+
+# the header has every kind of item that the cache stores
+file(REMOVE_RECURSE "${WORK_DIR}")
+file(MAKE_DIRECTORY "${WORK_DIR}")
+file(WRITE "${_header}" [=[
+/**
+ * @file vtkParseCacheTest.h
+ * @brief A header for checking the parse cache.
+ *
+ * The cache must keep everything that the XML is written from.
+ *
+ * @sa vtkParseCacheTest
+ */
+
+#define VTK_CACHE_TEST_VALUE 3
+#define VTK_CACHE_TEST_NAME "cache"
+
+typedef double vtkCacheTestReal;
+
+enum vtkCacheTestMode
+{
+  VTK_CACHE_A = 0, ///< the first mode
+  VTK_CACHE_B = VTK_CACHE_TEST_VALUE,
+  VTK_CACHE_C
+};
+
+const int vtkCacheTestConstant = 7;
+extern double vtkCacheTestVariable;
+
+/**
+ * A function with a default argument.
+ */
+int vtkCacheTestFunction(const char *text, int n = 2);
+
+namespace vtkCacheTestSpace
+{
+  class Helper;
+  using Real = double;
+  int Add(int a, int b);
+}
+
+template<class T, int N = 3>
+class vtkCacheTestTuple
+{
+public:
+  T Get(int i) const { return this->Data[i]; }
+  void Set(int i, T v);
+private:
+  T Data[N];
+};
+
+class vtkCacheTestBase
+{
+public:
+  virtual ~vtkCacheTestBase();
+  virtual void Modified();
+};
+
+/**
+ * @class vtkParseCacheTest
+ * @brief A class with properties.
+ *
+ * The details of the class.
+ *
+ * @warning A caveat.
+ */
+class vtkParseCacheTest : public vtkCacheTestBase
+{
+public:
+  static vtkParseCacheTest *New();
+  using vtkCacheTestBase::Modified;
+
+  /**
+   * Set the value, which is clamped.
+   * @param x the new value
+   * @return nothing
+   */
+  void SetValue(double x);
+  double GetValue();
+  static double GetValueMinValue();
+  static double GetValueMaxValue();
+
+  //@{
+  /**
+   * The origin, as an array.
+   */
+  void SetOrigin(double x, double y, double z);
+  void SetOrigin(const double x[3]);
+  double *GetOrigin();
+  void GetOrigin(double x[3]);
+  //@}
+
+  void SetMode(int mode);
+  int GetMode();
+  void SetModeToA() { this->SetMode(VTK_CACHE_A); }
+  void SetModeToB() { this->SetMode(VTK_CACHE_B); }
+  const char *GetModeAsString();
+
+  void DebugOn();
+  void DebugOff();
+  void SetDebug(bool b);
+  bool GetDebug();
+
+  void SetName(const char *name);
+  const char *GetName();
+
+  void SetInput(vtkCacheTestBase *input);
+  vtkCacheTestBase *GetInput();
+
+  vtkCacheTestTuple<float, 2> GetTuple();
+  template<class T> void Apply(T &t);
+
+  vtkParseCacheTest &operator=(const vtkParseCacheTest &) = delete;
+  bool operator==(const vtkParseCacheTest &other) const;
+
+  enum Kind { KindA, KindB };
+  typedef int IdType;
+
+  /**
+   * A nested class.
+   */
+  struct Entry
+  {
+    int Id;
+    double Weight[2];
+  };
+
+  static const int MaxEntries = 16;
+
+protected:
+  vtkParseCacheTest();
+  ~vtkParseCacheTest() override;
+
+  void SetPrivateValue(int v);
+  int GetPrivateValue();
+
+  double Value;
+  char *Name;
+  int Mode;
+};
+]=])
+
+# wrap the header into the named directory, with the given options
+function (_wrap name)
+  set(_dir "${WORK_DIR}/${name}")
+  file(MAKE_DIRECTORY "${_dir}")
+  execute_process(
+    COMMAND "${WRAPXML}" ${ARGN} -o "${_dir}/test.out" "${_header}"
+    ERROR_VARIABLE _errors
+    RESULT_VARIABLE _result)
+  if (NOT _result EQUAL 0)
+    message(FATAL_ERROR "vtkWrapXML ${ARGN} failed:\n${_errors}")
+  endif ()
+endfunction ()
+
+set(_runs xml full ndjson)
+set(_options_xml "")
+set(_options_full --type-codes --overloads --split-comments --inheritance)
+set(_options_ndjson --format ndjson)
+
+foreach (_run IN LISTS _runs)
+  set(_cache "${WORK_DIR}/${_run}.cache")
+  _wrap(${_run}-parsed ${_options_${_run}} --parse-cache "${_cache}")
+  if (NOT EXISTS "${_cache}")
+    message(FATAL_ERROR "vtkWrapXML did not write ${_cache}")
+  endif ()
+
+  set(_trace "${WORK_DIR}/${_run}-cached.json")
+  _wrap(${_run}-cached ${_options_${_run}} --parse-cache "${_cache}"
+        --trace "${_trace}")
+  file(READ "${_trace}" _events)
+  if (_events MATCHES "\"name\":\"parse\"")
+    message(FATAL_ERROR "The header was parsed again instead of loaded "
+                        "from ${_cache}")
+  endif ()
+
+  execute_process(
+    COMMAND "${CMAKE_COMMAND}" -E compare_files
+            "${WORK_DIR}/${_run}-parsed/test.out"
+            "${WORK_DIR}/${_run}-cached/test.out"
+    RESULT_VARIABLE _result)
+  if (NOT _result EQUAL 0)
+    message(FATAL_ERROR
+      "The ${_run} output from the cache differs from the parsed output "
+      "in ${WORK_DIR}")
+  endif ()
+endforeach ()